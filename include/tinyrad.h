@@ -180,6 +180,7 @@
 #define TRAD_EATTRIBUTE             0x000f ///< invalid or unknown attribute
 #define TRAD_EATTRVAL               0x0010 ///< invalid or unknown attribute value
 #define TRAD_EDICTRO                0x0011 ///< dictionary is read-only
+#define TRAD_ECACHE                 0x0012 ///< invalid or stale dictionary cache
 
 // library user options
 #define TRAD_OPTS_USER              0x000FFFFFU
@@ -194,6 +195,7 @@
 #define TRAD_URANDOM                0x00000080U
 #define TRAD_RANDOM                 (TRAD_RAND | TRAD_URANDOM)
 #define TRAD_RANDOM_MASK            (TRAD_RAND | TRAD_URANDOM)
+#define TRAD_DICT_STATS             0x00000100U  // count dictionary lookups for TRAD_DICT_OPT_STATS
 
 // library internal options
 #define TRAD_OPTS_INTERNAL          (~TRAD_OPTS_USER)
@@ -246,6 +248,11 @@
 #define TRAD_DICT_OPT_OID                12  // used by TinyRadDictAttr and TinyRadDictValue
 #define TRAD_DICT_OPT_PATHS              13  // used by TinyRadDict
 #define TRAD_DICT_OPT_READONLY           14  // used by TinyRadDict
+#define TRAD_DICT_OPT_STATS              15  // used by TinyRadDict
+
+// dictionary parse options
+#define TRAD_DICT_PARSE_PARALLEL          0x0001U  // tokenize included files on worker threads
+#define TRAD_DICT_PARSE_LAZY              0x0002U  // defer BEGIN-VENDOR blocks until vendor is used
 
 #define TRAD_OID_TYPE_NONE                0
 #define TRAD_OID_TYPE_ATTRIBUTE           1
@@ -491,6 +498,27 @@ typedef struct tinyrad_dict_vendor_def
 } TinyRadDictVendorDef;
 
 
+typedef struct tinyrad_dict_stats
+{
+   size_t                vendors;
+   size_t                attrs;
+   size_t                values;
+   size_t                sources;
+   size_t                objs_bytes;         // bytes used by vendor, attribute, and value objects
+   size_t                lists_bytes;        // bytes used by sorted object lists
+   size_t                hashes_bytes;       // bytes used by frozen hash tables
+   size_t                vendors_bytes;      // bytes used by per vendor attribute indexes
+   size_t                values_bytes;       // bytes used by per attribute value indexes
+   size_t                names_bytes;        // bytes used by attribute name trie
+   size_t                strpool_bytes;      // bytes allocated by string arena
+   size_t                strpool_used;       // bytes of string arena holding strings
+   size_t                strpool_strings;    // number of interned strings
+   uint64_t              lookups;            // number of vendor, attribute, and value lookups
+   uint64_t              lookup_misses;      // number of lookups which did not find an object
+   uint64_t              lookup_probes;      // number of hash table slots examined by lookups
+} TinyRadDictStats;
+
+
 typedef struct tinyrad_map
 {
    const char *          map_name;
@@ -584,6 +612,33 @@ tinyrad_dict_attr_info(
          void *                        outvalue );
 
 
+_TINYRAD_F int
+tinyrad_dict_attr_prefix(
+         TinyRadDict *                 dict,
+         const char *                  prefix,
+         char ***                      namesp );
+
+
+_TINYRAD_F int
+tinyrad_dict_cache_load(
+         TinyRadDict *                 dict,
+         const char *                  file,
+         uint32_t                      opts );
+
+
+_TINYRAD_F int
+tinyrad_dict_cache_save(
+         TinyRadDict *                 dict,
+         const char *                  file );
+
+
+_TINYRAD_F int
+tinyrad_dict_compile(
+         TinyRadDict *                 dict,
+         const char *                  file,
+         const char *                  prefix );
+
+
 _TINYRAD_F int
 tinyrad_dict_get_option(
          TinyRadDict *                 dict,
@@ -606,6 +661,12 @@ tinyrad_dict_initialize(
          unsigned                      opts );
 
 
+_TINYRAD_F int
+tinyrad_dict_initialize_overlay(
+         TinyRadDict *                 base,
+         TinyRadDict **                dictp );
+
+
 _TINYRAD_F int
 tinyrad_dict_parse(
          TinyRadDict *                 dict,
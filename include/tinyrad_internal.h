@@ -41,6 +41,7 @@
 
 #include <stddef.h>
 #include <inttypes.h>
+#include <stdatomic.h>
 #include <sys/types.h>
 
 #include <tinyrad.h>
@@ -62,6 +63,8 @@
 #pragma mark - Definitions
 
 #define TRAD_LINE_MAX_LEN           256
+#define TINYRAD_CACHE_LINE          64          ///< assumed size of a CPU cache line in bytes
+#define TRAD_ARGV_MAX               16          ///< maximum size of argv used with tinyrad_strtoargv()
 
 // array function options
 #define TINYRAD_ARRAY_INSERT        0x0001      ///< add type: insert unique object to sorted array
@@ -76,6 +79,51 @@
 #define TINYRAD_ARRAY_MASK          ( TINYRAD_ARRAY_MASK_ACTION | TINYRAD_ARRAY_MASK_DUPS )                    ///< mask of all sorted array options
 
 
+//////////////////
+//              //
+//  Data Types  //
+//              //
+//////////////////
+#pragma mark - Data Types
+
+/// circular FIFO queue of fixed width objects
+typedef struct tinyrad_queue
+{
+   void *                  base;    ///< ring buffer
+   size_t                  width;   ///< size of each object in bytes
+   size_t                  size;    ///< capacity in objects, zero or a power of two
+   size_t                  head;    ///< index of oldest object in ring buffer
+   size_t                  len;     ///< number of queued objects
+} TinyRadQueue;
+
+
+/// bounded lock-free FIFO queue of fixed width objects shared between threads
+typedef struct tinyrad_mpqueue
+{
+   char *                  base;    ///< ring buffer of slots, each a sequence number followed by an object
+   size_t                  width;   ///< size of each object in bytes
+   size_t                  stride;  ///< size of each slot in bytes
+   size_t                  mask;    ///< capacity in objects minus one
+   char                    pad0[TINYRAD_CACHE_LINE - (sizeof(void *) + (3 * sizeof(size_t)))];
+   atomic_size_t           head;    ///< position of next enqueue, updated by producers
+   char                    pad1[TINYRAD_CACHE_LINE - sizeof(atomic_size_t)];
+   atomic_size_t           tail;    ///< position of next dequeue, updated by consumers
+   char                    pad2[TINYRAD_CACHE_LINE - sizeof(atomic_size_t)];
+} TinyRadMPQueue;
+
+
+/// token of a string which is not NUL terminated
+typedef struct tinyrad_span
+{
+   const char *            str;     ///< first character of token
+   size_t                  len;     ///< length of token in bytes
+} TinyRadSpan;
+
+
+/// string template compiled by tinyrad_strexpand_compile()
+typedef struct tinyrad_str_tmpl TinyRadStrTmpl;
+
+
 /////////////////
 //             //
 //  Variables  //
@@ -112,6 +160,19 @@ tinyrad_array_add(
          void * (*reallocbase)(void *, size_t) );
 
 
+_TINYRAD_F ssize_t
+tinyrad_array_add_many(
+         void **                       basep,
+         size_t *                      nelp,
+         size_t                        width,
+         void *                        objs,
+         size_t                        count,
+         unsigned                      opts,
+         int (*compar)(const void *, const void *),
+         void (*freeobj)(void *),
+         void * (*reallocbase)(void *, size_t) );
+
+
 _TINYRAD_F void *
 tinyrad_array_dequeue(
          void *                        base,
@@ -138,6 +199,15 @@ tinyrad_array_get(
          int (*compar)(const void *, const void *) );
 
 
+_TINYRAD_F ssize_t
+tinyrad_array_grow(
+         void **                       basep,
+         size_t                        nel,
+         size_t *                      capp,
+         size_t                        width,
+         void * (*reallocbase)(void *, size_t) );
+
+
 _TINYRAD_F void *
 tinyrad_array_peek(
          void *                        base,
@@ -183,6 +253,69 @@ tinyrad_array_search(
          int (*compar)(const void *, const void *) );
 
 
+//------------------//
+// queue prototypes //
+//------------------//
+#pragma mark queue prototypes
+
+_TINYRAD_F void
+tinyrad_queue_clear(
+         TinyRadQueue *                queue,
+         void (*freeobj)(void *) );
+
+
+_TINYRAD_F void *
+tinyrad_queue_dequeue(
+         TinyRadQueue *                queue );
+
+
+_TINYRAD_F ssize_t
+tinyrad_queue_enqueue(
+         TinyRadQueue *                queue,
+         const void *                  obj );
+
+
+_TINYRAD_F void
+tinyrad_queue_initialize(
+         TinyRadQueue *                queue,
+         size_t                        width );
+
+
+_TINYRAD_F void *
+tinyrad_queue_peek(
+         TinyRadQueue *                queue );
+
+
+//--------------------//
+// mpqueue prototypes //
+//--------------------//
+#pragma mark mpqueue prototypes
+
+_TINYRAD_F void
+tinyrad_mpqueue_clear(
+         TinyRadMPQueue *              queue,
+         void (*freeobj)(void *) );
+
+
+_TINYRAD_F ssize_t
+tinyrad_mpqueue_dequeue(
+         TinyRadMPQueue *              queue,
+         void *                        obj );
+
+
+_TINYRAD_F ssize_t
+tinyrad_mpqueue_enqueue(
+         TinyRadMPQueue *              queue,
+         const void *                  obj );
+
+
+_TINYRAD_F ssize_t
+tinyrad_mpqueue_initialize(
+         TinyRadMPQueue *              queue,
+         size_t                        width,
+         size_t                        size );
+
+
 //------------------//
 // debug prototypes //
 //------------------//
@@ -223,6 +356,20 @@ tinyrad_strexpand(
          int                           force_expansion );
 
 
+_TINYRAD_F int
+tinyrad_strexpand_compile(
+         const char *                  src,
+         int                           force_expansion,
+         TinyRadStrTmpl **             tmplp );
+
+
+_TINYRAD_F char *
+tinyrad_strexpand_tmpl(
+         char *                        dst,
+         const TinyRadStrTmpl *        tmpl,
+         size_t                        len );
+
+
 _TINYRAD_F size_t
 tinyrad_strlcat(
          char * restrict               dst,
@@ -268,6 +415,16 @@ tinyrad_strsplit(
          int *                         argcp );
 
 
+_TINYRAD_F int
+tinyrad_strsplitspans(
+         const char *                  str,
+         size_t                        len,
+         int                           delim,
+         TinyRadSpan *                 spans,
+         size_t                        max,
+         size_t *                      countp );
+
+
 _TINYRAD_F int
 tinyrad_strtoargs(
          char *                        str,
@@ -275,11 +432,28 @@ tinyrad_strtoargs(
          int *                         argcp );
 
 
+_TINYRAD_F int
+tinyrad_strtoargv(
+         char *                        str,
+         char **                       argv,
+         size_t                        max,
+         int *                         argcp );
+
+
 _TINYRAD_F int
 tinyrad_strtobool(
          const char *                  str );
 
 
+_TINYRAD_F int
+tinyrad_strtospans(
+         const char *                  str,
+         size_t                        len,
+         TinyRadSpan *                 spans,
+         size_t                        max,
+         size_t *                      countp );
+
+
 _TINYRAD_F char *
 tinyrad_strtrim(
          char *                        str );
@@ -123,13 +123,16 @@ trutils_close(
 _TINYRAD_F TRUtilsFile *
 trutils_open(
          unsigned                      opts,
-         const char *                  filename );
+         const char *                  filename,
+         size_t                        size );
 
 
 _TINYRAD_F int
 trutils_readline(
          unsigned                      opts,
-         TRUtilsFile *                 fb );
+         TRUtilsFile *                 fb,
+         char **                       linep,
+         size_t *                      lenp );
 
 
 //--------------------//
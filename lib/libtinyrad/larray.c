@@ -41,9 +41,25 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
 #include <assert.h>
 
 
+///////////////////
+//               //
+//  Definitions  //
+//               //
+///////////////////
+#pragma mark - Definitions
+
+#define TINYRAD_ARRAY_MIN_SIZE      8  // initial capacity of array
+#define TINYRAD_QUEUE_MIN_SIZE      8  // initial capacity of ring buffer
+#define TINYRAD_MPQUEUE_MIN_SIZE    2  // minimum capacity of lock-free ring buffer
+
+#define TINYRAD_MPQUEUE_SEQ(queue, pos) ((atomic_size_t *)&(queue)->base[(queue)->stride * ((pos) & (queue)->mask)])
+#define TINYRAD_MPQUEUE_OBJ(queue, pos) (&(queue)->base[((queue)->stride * ((pos) & (queue)->mask)) + sizeof(atomic_size_t)])
+
+
 //////////////////
 //              //
 //  Prototypes  //
@@ -51,6 +67,23 @@
 //////////////////
 #pragma mark - Prototypes
 
+static ssize_t
+tinyrad_array_resize(
+         void **                       basep,
+         size_t                        nel,
+         size_t                        width,
+         void * (*reallocbase)(void *, size_t) );
+
+
+static void
+tinyrad_array_msort(
+         char *                        base,
+         size_t                        nel,
+         size_t                        width,
+         char *                        tmp,
+         int (*compar)(const void *, const void *) );
+
+
 void
 tinyrad_array_move(
          void *                        a,
@@ -65,6 +98,11 @@ tinyrad_array_swap(
          size_t                        size );
 
 
+static int
+tinyrad_queue_grow(
+         TinyRadQueue *                queue );
+
+
 /////////////////
 //             //
 //  Functions  //
@@ -85,11 +123,9 @@ tinyrad_array_add(
 {
    ssize_t     idx;
    size_t      wouldbe;
-   size_t      size;
    ssize_t     pos;
    char *      src;
    char *      dst;
-   void *      ptr;
 
    TinyRadDebugTrace();
 
@@ -104,13 +140,8 @@ tinyrad_array_add(
 
    if (!(*nelp))
    {
-      if ((reallocbase))
-      {
-         size = width * (*nelp + 1);
-         if ((ptr = (*reallocbase)(*basep, size)) == NULL)
-            return(-2);
-         *basep = ptr;
-      };
+      if (tinyrad_array_resize(basep, (*nelp + 1), width, reallocbase) != 0)
+         return(-2);
       (*nelp)++;
       tinyrad_array_move(obj, *basep, width);
       return(0);
@@ -134,13 +165,8 @@ tinyrad_array_add(
    };
 
    // increases size of base
-   if ((reallocbase))
-   {
-      size = width * (*nelp + 1);
-      if ((ptr = (*reallocbase)(*basep, size)) == NULL)
-         return(-2);
-      *basep = ptr;
-   };
+   if (tinyrad_array_resize(basep, (*nelp + 1), width, reallocbase) != 0)
+      return(-2);
 
    // shift list
    for(pos = (ssize_t)((*nelp)-1); (pos >= (ssize_t)wouldbe); pos--)
@@ -161,6 +187,181 @@ tinyrad_array_add(
 }
 
 
+/// Adds a batch of objects to a sorted array
+///
+/// The batch is sorted once with a stable merge sort and merged into the
+/// array in a single pass.  The result is the same as passing each object of
+/// the batch, in order, to tinyrad_array_add() with the same options.  Objects
+/// rejected by TINYRAD_ARRAY_INSERT, and objects of the batch replaced by a
+/// later object of the batch with TINYRAD_ARRAY_REPLACE (which are passed to
+/// freeobj), are moved to the end of objs.  objs may be the unsorted tail of
+/// the array itself when TINYRAD_ARRAY_MERGE is used.
+///
+/// @param[in]  basep         reference to sorted array
+/// @param[in]  nelp          reference to number of objects in array
+/// @param[in]  width         size of each object in bytes
+/// @param[in]  objs          batch of objects, reordered by this function
+/// @param[in]  count         number of objects in batch
+/// @param[in]  opts          add type and duplicate handling options
+/// @param[in]  compar        object comparison function
+/// @param[in]  freeobj       called with objects replaced by TINYRAD_ARRAY_REPLACE
+/// @param[in]  reallocbase   realloc() compatible function, NULL if the
+///                           caller manages the size of the array
+/// @return returns the number of objects of the batch stored in the array,
+///         or -2 if a memory error occurred and the array is unchanged.
+ssize_t
+tinyrad_array_add_many(
+         void **                       basep,
+         size_t *                      nelp,
+         size_t                        width,
+         void *                        objs,
+         size_t                        count,
+         unsigned                      opts,
+         int  (*compar)(const void *, const void *),
+         void (*freeobj)(void *),
+         void * (*reallocbase)(void *, size_t) )
+{
+   size_t      pos;
+   size_t      end;
+   size_t      kept;
+   size_t      fresh;
+   size_t      replaced;
+   size_t      dropped;
+   size_t      x;
+   size_t      y;
+   ssize_t     idx;
+   unsigned    add;
+   unsigned    dups;
+   int         rc;
+   char *      base;
+   char *      tmp;
+   char *      obj;
+
+   TinyRadDebugTrace();
+
+   assert(basep != NULL);
+   assert(nelp  != NULL);
+   assert( ((objs)) || (!(count)) );
+   assert(width  > 0);
+
+   if (!(count))
+      return(0);
+
+   add  = ((opts & TINYRAD_ARRAY_MASK_ADD))  ? (opts & TINYRAD_ARRAY_MASK_ADD)  : (TINYRAD_ARRAY_DEFAULT & TINYRAD_ARRAY_MASK_ADD);
+   dups = ((opts & TINYRAD_ARRAY_MASK_DUPS)) ? (opts & TINYRAD_ARRAY_MASK_DUPS) : (TINYRAD_ARRAY_DEFAULT & TINYRAD_ARRAY_MASK_DUPS);
+   obj  = objs;
+
+   // allocate before modifying anything so errors leave the array unchanged
+   if (tinyrad_array_resize(basep, (*nelp + count), width, reallocbase) != 0)
+      return(-2);
+   if ((tmp = malloc(width * count)) == NULL)
+      return(-2);
+
+   tinyrad_array_msort(obj, count, width, tmp, compar);
+
+   // resolve duplicates within batch, dropped objects are staged at end of tmp
+   kept    = 0;
+   dropped = 0;
+   for(pos = 0; (pos < count); pos = end)
+   {
+      for(end = pos + 1; ( (end < count) && (!(compar(&obj[width * pos], &obj[width * end]))) ); end++);
+      switch(add)
+      {
+         case TINYRAD_ARRAY_MERGE:
+         // each object is added before earlier duplicates
+         if (dups == TINYRAD_ARRAY_FIRSTDUP)
+            for(x = pos, y = end - 1; (x < y); x++, y--)
+               tinyrad_array_swap(&obj[width * x], &obj[width * y], width);
+         memmove(&obj[width * kept], &obj[width * pos], (width * (end - pos)));
+         kept += end - pos;
+         break;
+
+         case TINYRAD_ARRAY_REPLACE:
+         // each object replaces the previous duplicate
+         for(x = pos; (x < (end - 1)); x++)
+         {
+            if ((freeobj))
+               (*freeobj)(&obj[width * x]);
+            dropped++;
+            memcpy(&tmp[width * (count - dropped)], &obj[width * x], width);
+         };
+         memmove(&obj[width * kept], &obj[width * (end - 1)], width);
+         kept++;
+         break;
+
+         default:
+         // first object is inserted and later duplicates are rejected
+         for(x = pos + 1; (x < end); x++)
+         {
+            dropped++;
+            memcpy(&tmp[width * (count - dropped)], &obj[width * x], width);
+         };
+         memmove(&obj[width * kept], &obj[width * pos], width);
+         kept++;
+         break;
+      };
+   };
+
+   // resolve duplicates of objects already in array
+   base     = *basep;
+   fresh    = kept;
+   replaced = 0;
+   if ( (add != TINYRAD_ARRAY_MERGE) && ((*nelp)) )
+   {
+      for(pos = 0, fresh = 0; (pos < kept); pos++)
+      {
+         if ((idx = tinyrad_array_search(base, *nelp, width, &obj[width * pos], opts, NULL, compar)) == -1)
+         {
+            memmove(&obj[width * fresh], &obj[width * pos], width);
+            fresh++;
+         }
+         else if (add == TINYRAD_ARRAY_REPLACE)
+         {
+            if ((freeobj))
+               (*freeobj)(&base[width * (size_t)idx]);
+            memcpy(&base[width * (size_t)idx], &obj[width * pos], width);
+            memcpy(&tmp[width * replaced], &obj[width * pos], width);
+            replaced++;
+         }
+         else
+         {
+            dropped++;
+            memcpy(&tmp[width * (count - dropped)], &obj[width * pos], width);
+         };
+      };
+   };
+
+   // order batch as new objects, replacing objects, then dropped objects
+   memcpy(&obj[width * fresh],              tmp,                             (width * replaced));
+   memcpy(&obj[width * (fresh + replaced)], &tmp[width * (count - dropped)], (width * dropped));
+   memcpy(tmp, obj, (width * fresh));
+
+   // merge new objects from end of array, objs may overlap the array
+   x = *nelp;
+   y = fresh;
+   while (y > 0)
+   {
+      if (x > 0)
+      {
+         rc = compar(&tmp[width * (y - 1)], &base[width * (x - 1)]);
+         if ( (rc < 0) || ( (rc == 0) && (dups == TINYRAD_ARRAY_FIRSTDUP) ) )
+         {
+            memcpy(&base[width * (x + y - 1)], &base[width * (x - 1)], width);
+            x--;
+            continue;
+         };
+      };
+      memcpy(&base[width * (x + y - 1)], &tmp[width * (y - 1)], width);
+      y--;
+   };
+   *nelp += fresh;
+
+   free(tmp);
+
+   return((ssize_t)(fresh + replaced));
+}
+
+
 void *
 tinyrad_array_dequeue(
          void *                        base,
@@ -186,12 +387,6 @@ tinyrad_array_enqueue(
          void *                        obj,
          void * (*reallocbase)(void *, size_t) )
 {
-   size_t      size;
-   size_t      pos;
-   void *      ptr;
-   char *      src;
-   char *      dst;
-
    TinyRadDebugTrace();
 
    assert(basep != NULL);
@@ -200,21 +395,11 @@ tinyrad_array_enqueue(
    assert(obj   != NULL);
 
    // increases size of base
-   if ((reallocbase))
-   {
-      size = width * (*nelp + 1);
-      if ((ptr = (*reallocbase)(*basep, size)) == NULL)
-         return(-2);
-      *basep = ptr;
-   };
+   if (tinyrad_array_resize(basep, (*nelp + 1), width, reallocbase) != 0)
+      return(-2);
 
-   // shift list
-   for(pos = (*nelp); (pos > 0); pos--)
-   {
-      src = ((char *)*basep) + (width * (size_t)(pos-1));
-      dst = ((char *)*basep) + (width * (size_t)(pos-0));
-      tinyrad_array_move(src, dst, width);
-   };
+   // shift list, use TinyRadQueue when the queue may grow large
+   memmove(((char *)*basep) + width, *basep, (width * (*nelp)));
 
    // save object
    tinyrad_array_move(obj, ((char *)*basep), width);
@@ -246,6 +431,51 @@ tinyrad_array_get(
 }
 
 
+/// Ensures array has room for one more object
+///
+/// The capacity of the array is stored by the caller in capp.  The array is
+/// reallocated only when it is full, and its capacity is doubled, so
+/// appending n objects costs O(log n) reallocations.  Arrays grown by this
+/// function are passed to the other array functions with a NULL reallocbase.
+///
+/// @param[in]  basep         reference to array
+/// @param[in]  nel           number of objects in array
+/// @param[in]  capp          reference to number of objects array can hold
+/// @param[in]  width         size of each object in bytes
+/// @param[in]  reallocbase   realloc() compatible function
+/// @return returns 0 on success or -2 if a memory error occurred
+ssize_t
+tinyrad_array_grow(
+         void **                       basep,
+         size_t                        nel,
+         size_t *                      capp,
+         size_t                        width,
+         void * (*reallocbase)(void *, size_t) )
+{
+   size_t      size;
+   void *      ptr;
+
+   TinyRadDebugTrace();
+
+   assert(basep       != NULL);
+   assert(capp        != NULL);
+   assert(nel         <= *capp);
+   assert(reallocbase != NULL);
+   assert(width        > 0);
+
+   if (nel < *capp)
+      return(0);
+
+   size = ((*capp)) ? (*capp * 2) : TINYRAD_ARRAY_MIN_SIZE;
+   if ((ptr = (*reallocbase)(*basep, (width * size))) == NULL)
+      return(-2);
+   *basep = ptr;
+   *capp  = size;
+
+   return(0);
+}
+
+
 void
 tinyrad_array_move(
          void *                        a,
@@ -264,6 +494,54 @@ tinyrad_array_move(
 }
 
 
+/// Stable merge sort of an array
+///
+/// @param[in]  base          array to sort
+/// @param[in]  nel           number of objects in array
+/// @param[in]  width         size of each object in bytes
+/// @param[in]  tmp           scratch buffer of at least nel objects
+/// @param[in]  compar        object comparison function
+static void
+tinyrad_array_msort(
+         char *                        base,
+         size_t                        nel,
+         size_t                        width,
+         char *                        tmp,
+         int (*compar)(const void *, const void *) )
+{
+   size_t      half;
+   size_t      x;
+   size_t      y;
+   size_t      pos;
+
+   if (nel < 2)
+      return;
+
+   half = nel / 2;
+   tinyrad_array_msort(base,                  half,       width, tmp, compar);
+   tinyrad_array_msort(&base[width * half],   nel - half, width, tmp, compar);
+
+   // halves which are already in order do not need to be merged
+   if (compar(&base[width * (half - 1)], &base[width * half]) <= 0)
+      return;
+
+   // equal objects are taken from the first half to keep the sort stable
+   for(x = 0, y = half, pos = 0; ( (x < half) && (y < nel) ); pos++)
+   {
+      if (compar(&base[width * y], &base[width * x]) < 0)
+         memcpy(&tmp[width * pos], &base[width * y++], width);
+      else
+         memcpy(&tmp[width * pos], &base[width * x++], width);
+   };
+   memcpy(&tmp[width * pos], &base[width * x], (width * (half - x)));
+   pos += half - x;
+   memcpy(&tmp[width * pos], &base[width * y], (width * (nel - y)));
+   memcpy(base, tmp, (width * nel));
+
+   return;
+}
+
+
 void *
 tinyrad_array_peek(
          void *                        base,
@@ -304,7 +582,6 @@ tinyrad_array_push(
          void *                        obj,
          void * (*reallocbase)(void *, size_t) )
 {
-   size_t      size;
    void *      ptr;
 
    TinyRadDebugTrace();
@@ -315,13 +592,8 @@ tinyrad_array_push(
    assert(obj   != NULL);
 
    // increases size of base
-   if ((reallocbase))
-   {
-      size = width * (*nelp + 1);
-      if ((ptr = (*reallocbase)(*basep, size)) == NULL)
-         return(-2);
-      *basep = ptr;
-   };
+   if (tinyrad_array_resize(basep, (*nelp + 1), width, reallocbase) != 0)
+      return(-2);
 
    // save object
    ptr = ((char *)*basep) + (width * (*nelp));
@@ -382,6 +654,37 @@ tinyrad_array_remove(
 }
 
 
+/// Sizes array to hold exactly nel objects
+///
+/// @param[in]  basep         reference to array
+/// @param[in]  nel           number of objects array must hold
+/// @param[in]  width         size of each object in bytes
+/// @param[in]  reallocbase   realloc() compatible function, NULL if the
+///                           caller manages the size of the array
+/// @return returns 0 on success or -2 if a memory error occurred
+static ssize_t
+tinyrad_array_resize(
+         void **                       basep,
+         size_t                        nel,
+         size_t                        width,
+         void * (*reallocbase)(void *, size_t) )
+{
+   void *      ptr;
+
+   assert(basep != NULL);
+   assert(width  > 0);
+
+   if (!(reallocbase))
+      return(0);
+
+   if ((ptr = (*reallocbase)(*basep, (width * nel))) == NULL)
+      return(-2);
+   *basep = ptr;
+
+   return(0);
+}
+
+
 ssize_t
 tinyrad_array_search(
          const void *                  base,
@@ -502,4 +805,349 @@ tinyrad_array_swap(
 }
 
 
+//-----------------//
+// queue functions //
+//-----------------//
+#pragma mark queue functions
+
+/// Releases the ring buffer of a queue
+///
+/// @param[in]  queue         queue to empty
+/// @param[in]  freeobj       called with a pointer to each queued object, may be NULL
+void
+tinyrad_queue_clear(
+         TinyRadQueue *                queue,
+         void (*freeobj)(void *) )
+{
+   void *      obj;
+
+   TinyRadDebugTrace();
+
+   assert(queue != NULL);
+
+   if ((freeobj))
+      while((obj = tinyrad_queue_dequeue(queue)) != NULL)
+         (*freeobj)(obj);
+
+   free(queue->base);
+   tinyrad_queue_initialize(queue, queue->width);
+
+   return;
+}
+
+
+/// Removes the oldest object from a queue
+///
+/// @param[in]  queue         queue to modify
+/// @return returns a pointer to the object within the ring buffer which is
+///         valid until the next call to tinyrad_queue_enqueue(), or NULL if
+///         the queue is empty.
+void *
+tinyrad_queue_dequeue(
+         TinyRadQueue *                queue )
+{
+   void *      obj;
+
+   TinyRadDebugTrace();
+
+   assert(queue != NULL);
+
+   if (!(queue->len))
+      return(NULL);
+
+   obj         = ((char *)queue->base) + (queue->width * queue->head);
+   queue->head = (queue->head + 1) & (queue->size - 1);
+   queue->len--;
+
+   return(obj);
+}
+
+
+/// Appends a copy of an object to a queue
+///
+/// @param[in]  queue         queue to modify
+/// @param[in]  obj           object of queue->width bytes to copy
+/// @return returns 0 on success or -2 if a memory error occurred
+ssize_t
+tinyrad_queue_enqueue(
+         TinyRadQueue *                queue,
+         const void *                  obj )
+{
+   size_t      idx;
+
+   TinyRadDebugTrace();
+
+   assert(queue != NULL);
+   assert(obj   != NULL);
+
+   if (queue->len == queue->size)
+      if (tinyrad_queue_grow(queue) != 0)
+         return(-2);
+
+   idx = (queue->head + queue->len) & (queue->size - 1);
+   memcpy(((char *)queue->base) + (queue->width * idx), obj, queue->width);
+   queue->len++;
+
+   return(0);
+}
+
+
+/// Doubles the capacity of a full queue
+///
+/// @param[in]  queue         queue to modify
+/// @return returns 0 on success or -2 if a memory error occurred
+static int
+tinyrad_queue_grow(
+         TinyRadQueue *                queue )
+{
+   size_t      size;
+   size_t      wrapped;
+   char *      base;
+
+   TinyRadDebugTrace();
+
+   size = ((queue->size)) ? (queue->size * 2) : TINYRAD_QUEUE_MIN_SIZE;
+   if ((base = realloc(queue->base, (queue->width * size))) == NULL)
+      return(-2);
+
+   // objects before head wrapped around the old ring, move them past the old end
+   wrapped = ((queue->head + queue->len) > queue->size) ? ((queue->head + queue->len) - queue->size) : 0;
+   if ((wrapped))
+      memcpy(base + (queue->width * queue->size), base, (queue->width * wrapped));
+
+   queue->base = base;
+   queue->size = size;
+
+   return(0);
+}
+
+
+/// Prepares an empty queue, no memory is allocated until the first enqueue
+///
+/// @param[out] queue         queue to initialize
+/// @param[in]  width         size of each object in bytes
+void
+tinyrad_queue_initialize(
+         TinyRadQueue *                queue,
+         size_t                        width )
+{
+   TinyRadDebugTrace();
+
+   assert(queue != NULL);
+   assert(width  > 0);
+
+   memset(queue, 0, sizeof(TinyRadQueue));
+   queue->width = width;
+
+   return;
+}
+
+
+/// Returns the oldest object of a queue without removing it
+///
+/// @param[in]  queue         queue to inspect
+/// @return returns a pointer to the object within the ring buffer, or NULL if
+///         the queue is empty.
+void *
+tinyrad_queue_peek(
+         TinyRadQueue *                queue )
+{
+   TinyRadDebugTrace();
+
+   assert(queue != NULL);
+
+   if (!(queue->len))
+      return(NULL);
+
+   return(((char *)queue->base) + (queue->width * queue->head));
+}
+
+
+//-------------------//
+// mpqueue functions //
+//-------------------//
+#pragma mark mpqueue functions
+
+// Each slot of the ring buffer starts with a sequence number which tells the
+// threads racing for a position whose turn it is.  A slot is free for the
+// enqueue at position pos when its sequence is pos, and holds an object for
+// the dequeue at position pos when its sequence is pos + 1.  The dequeue
+// releases the slot for the next lap of the ring by storing pos + size.
+
+/// Releases the ring buffer of a lock-free queue
+///
+/// The queue must not be in use by other threads.
+///
+/// @param[in]  queue         queue to empty
+/// @param[in]  freeobj       called with a pointer to each queued object, may be NULL
+void
+tinyrad_mpqueue_clear(
+         TinyRadMPQueue *              queue,
+         void (*freeobj)(void *) )
+{
+   size_t      pos;
+   size_t      head;
+
+   TinyRadDebugTrace();
+
+   assert(queue != NULL);
+
+   if (!(queue->base))
+      return;
+
+   if ((freeobj))
+   {
+      head = atomic_load(&queue->head);
+      for(pos = atomic_load(&queue->tail); (pos != head); pos++)
+         (*freeobj)(TINYRAD_MPQUEUE_OBJ(queue, pos));
+   };
+
+   free(queue->base);
+   queue->base = NULL;
+   queue->mask = 0;
+
+   return;
+}
+
+
+/// Removes the oldest object from a lock-free queue
+///
+/// Safe to call from any number of threads concurrently with
+/// tinyrad_mpqueue_enqueue().
+///
+/// @param[in]  queue         queue to modify
+/// @param[out] obj           buffer of queue->width bytes receiving the object
+/// @return returns 0 on success or -1 if the queue is empty
+ssize_t
+tinyrad_mpqueue_dequeue(
+         TinyRadMPQueue *              queue,
+         void *                        obj )
+{
+   size_t            pos;
+   size_t            seq;
+   intptr_t          diff;
+   atomic_size_t *   seqp;
+
+   TinyRadDebugTrace();
+
+   assert(queue       != NULL);
+   assert(queue->base != NULL);
+   assert(obj         != NULL);
+
+   pos = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+   for(;;)
+   {
+      seqp = TINYRAD_MPQUEUE_SEQ(queue, pos);
+      seq  = atomic_load_explicit(seqp, memory_order_acquire);
+      diff = (intptr_t)seq - (intptr_t)(pos + 1);
+      if (diff == 0)
+      {
+         // claim position, pos is reloaded if another consumer won the race
+         if ((atomic_compare_exchange_weak_explicit(&queue->tail, &pos, (pos + 1), memory_order_relaxed, memory_order_relaxed)))
+            break;
+      }
+      else if (diff < 0)
+         return(-1);
+      else
+         pos = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+   };
+
+   memcpy(obj, TINYRAD_MPQUEUE_OBJ(queue, pos), queue->width);
+   atomic_store_explicit(seqp, (pos + queue->mask + 1), memory_order_release);
+
+   return(0);
+}
+
+
+/// Appends a copy of an object to a lock-free queue
+///
+/// Safe to call from any number of threads concurrently with
+/// tinyrad_mpqueue_dequeue().
+///
+/// @param[in]  queue         queue to modify
+/// @param[in]  obj           object of queue->width bytes to copy
+/// @return returns 0 on success or -1 if the queue is full
+ssize_t
+tinyrad_mpqueue_enqueue(
+         TinyRadMPQueue *              queue,
+         const void *                  obj )
+{
+   size_t            pos;
+   size_t            seq;
+   intptr_t          diff;
+   atomic_size_t *   seqp;
+
+   TinyRadDebugTrace();
+
+   assert(queue       != NULL);
+   assert(queue->base != NULL);
+   assert(obj         != NULL);
+
+   pos = atomic_load_explicit(&queue->head, memory_order_relaxed);
+   for(;;)
+   {
+      seqp = TINYRAD_MPQUEUE_SEQ(queue, pos);
+      seq  = atomic_load_explicit(seqp, memory_order_acquire);
+      diff = (intptr_t)seq - (intptr_t)pos;
+      if (diff == 0)
+      {
+         // claim position, pos is reloaded if another producer won the race
+         if ((atomic_compare_exchange_weak_explicit(&queue->head, &pos, (pos + 1), memory_order_relaxed, memory_order_relaxed)))
+            break;
+      }
+      else if (diff < 0)
+         return(-1);
+      else
+         pos = atomic_load_explicit(&queue->head, memory_order_relaxed);
+   };
+
+   memcpy(TINYRAD_MPQUEUE_OBJ(queue, pos), obj, queue->width);
+   atomic_store_explicit(seqp, (pos + 1), memory_order_release);
+
+   return(0);
+}
+
+
+/// Allocates the ring buffer of a lock-free queue
+///
+/// @param[out] queue         queue to initialize
+/// @param[in]  width         size of each object in bytes
+/// @param[in]  size          minimum capacity in objects, rounded up to a power of two
+/// @return returns 0 on success or -2 if a memory error occurred
+ssize_t
+tinyrad_mpqueue_initialize(
+         TinyRadMPQueue *              queue,
+         size_t                        width,
+         size_t                        size )
+{
+   size_t      pos;
+   size_t      cap;
+   size_t      align;
+
+   TinyRadDebugTrace();
+
+   assert(queue != NULL);
+   assert(width  > 0);
+
+   memset(queue, 0, sizeof(TinyRadMPQueue));
+
+   for(cap = TINYRAD_MPQUEUE_MIN_SIZE; (cap < size); cap <<= 1);
+
+   // keep the sequence number of each slot aligned
+   align         = sizeof(max_align_t);
+   queue->width  = width;
+   queue->stride = ((sizeof(atomic_size_t) + width + align - 1) / align) * align;
+   queue->mask   = cap - 1;
+   if ((queue->base = malloc(queue->stride * cap)) == NULL)
+      return(-2);
+
+   for(pos = 0; (pos < cap); pos++)
+      atomic_init(TINYRAD_MPQUEUE_SEQ(queue, pos), pos);
+   atomic_init(&queue->head, 0);
+   atomic_init(&queue->tail, 0);
+
+   return(0);
+}
+
+
 /* end of source */
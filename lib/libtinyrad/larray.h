@@ -44,4 +44,57 @@
 #include <stdlib.h>
 
 
+//////////////
+//          //
+//  Macros  //
+//          //
+//////////////
+#pragma mark - Macros
+
+/// Defines a binary search of a sorted array specialized for one key type
+///
+/// The generated function has the signature
+/// `ssize_t name(type const * base, size_t nel, key_type key, unsigned opts)`
+/// and honors the duplicate handling options of tinyrad_array_search().
+/// Unlike tinyrad_array_search(), `compar` is called directly so it may be
+/// inlined, and the probe loop only selects a new lower bound so the
+/// compiler may emit a conditional move instead of a branch.
+///
+/// @param[in]  scope         storage class of generated function
+/// @param[in]  name          name of generated function
+/// @param[in]  type          type of array elements
+/// @param[in]  key_type      type of search key
+/// @param[in]  compar        `int compar(const void * obj, key_type key)`
+#define TINYRAD_ARRAY_SEARCH_FUNC(scope, name, type, key_type, compar) \
+scope ssize_t \
+name( \
+         type const *                  base, \
+         size_t                        nel, \
+         key_type                      key, \
+         unsigned                      opts ) \
+{ \
+   type const *   ptr; \
+   size_t         half; \
+   size_t         len; \
+   size_t         idx; \
+   int            last; \
+   if (!(nel)) \
+      return(-1); \
+   last = ((opts & TINYRAD_ARRAY_MASK_DUPS) == TINYRAD_ARRAY_LASTDUP) ? 1 : 0; \
+   ptr  = base; \
+   len  = nel; \
+   /* find first element greater than (last) or not less than (first/any) key */ \
+   while (len > 1) \
+   { \
+      half  = len / 2; \
+      ptr   = ((compar(&ptr[half - 1], key) < last)) ? &ptr[half] : ptr; \
+      len  -= half; \
+   }; \
+   idx = (size_t)(ptr - base) + (((compar(ptr, key) < last)) ? 1 : 0); \
+   if ((last)) \
+      return( ((idx)) && (!(compar(&base[idx - 1], key))) ? (ssize_t)(idx - 1) : -1 ); \
+   return( (idx < nel) && (!(compar(&base[idx], key))) ? (ssize_t)idx : -1 ); \
+}
+
+
 #endif /* end of header */
@@ -0,0 +1,719 @@
+/*
+ *  Tiny RADIUS Client Library
+ *  Copyright (C) 2021 David M. Syzdek <david@syzdek.net>.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of David M. Syzdek nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL DAVID M. SYZDEK BE LIABLE FOR
+ *  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ *  OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ *  SUCH DAMAGE.
+ */
+#define _LIB_LIBTINYRAD_LCACHE_C 1
+#include "lcache.h"
+
+
+///////////////
+//           //
+//  Headers  //
+//           //
+///////////////
+#pragma mark - Headers
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <errno.h>
+#include <assert.h>
+
+#include "ldict.h"
+#include "lmemory.h"
+#include "lstrings.h"
+
+
+//////////////////
+//              //
+//  Data Types  //
+//              //
+//////////////////
+#pragma mark - Data Types
+
+typedef struct tinyrad_cache_strtab
+{
+   size_t               len;
+   size_t               size;
+   char *               buff;
+} TinyRadCacheStrTab;
+
+
+//////////////////
+//              //
+//  Prototypes  //
+//              //
+//////////////////
+#pragma mark - Prototypes
+
+static int
+tinyrad_cache_cmp_attr(
+         const void *                  a,
+         const void *                  b );
+
+
+static int
+tinyrad_cache_cmp_value(
+         const void *                  a,
+         const void *                  b );
+
+
+static int
+tinyrad_cache_cmp_vendor(
+         const void *                  a,
+         const void *                  b );
+
+
+static int
+tinyrad_cache_load(
+         TinyRadDict *                 dict,
+         const uint8_t *               base );
+
+
+static int
+tinyrad_cache_strtab_add(
+         TinyRadCacheStrTab *          strtab,
+         const char *                  str,
+         uint32_t *                    offp );
+
+
+static int
+tinyrad_cache_verify(
+         const uint8_t *               base,
+         size_t                        size,
+         const char *                  root,
+         uint32_t                      flags );
+
+
+/////////////////
+//             //
+//  Functions  //
+//             //
+/////////////////
+#pragma mark - Functions
+
+/// Compares attributes by creation order
+///
+/// @param[in]  a             pointer to first attribute reference
+/// @param[in]  b             pointer to second attribute reference
+/// @return return an integer greater than, equal to, or less than 0,
+/// according as the object 'a' is greater than, equal to, or less than object
+/// 'b'.
+static int
+tinyrad_cache_cmp_attr(
+         const void *                  a,
+         const void *                  b )
+{
+   const TinyRadDictAttr * const * x = a;
+   const TinyRadDictAttr * const * y = b;
+   if ((*x)->order == (*y)->order)
+      return(0);
+   return( ((*x)->order < (*y)->order) ? -1 : 1 );
+}
+
+
+/// Compares values by creation order
+///
+/// @param[in]  a             pointer to first value reference
+/// @param[in]  b             pointer to second value reference
+/// @return return an integer greater than, equal to, or less than 0,
+/// according as the object 'a' is greater than, equal to, or less than object
+/// 'b'.
+static int
+tinyrad_cache_cmp_value(
+         const void *                  a,
+         const void *                  b )
+{
+   const TinyRadDictValue * const * x = a;
+   const TinyRadDictValue * const * y = b;
+   if ((*x)->order == (*y)->order)
+      return(0);
+   return( ((*x)->order < (*y)->order) ? -1 : 1 );
+}
+
+
+/// Compares vendors by creation order
+///
+/// @param[in]  a             pointer to first vendor reference
+/// @param[in]  b             pointer to second vendor reference
+/// @return return an integer greater than, equal to, or less than 0,
+/// according as the object 'a' is greater than, equal to, or less than object
+/// 'b'.
+static int
+tinyrad_cache_cmp_vendor(
+         const void *                  a,
+         const void *                  b )
+{
+   const TinyRadDictVendor * const * x = a;
+   const TinyRadDictVendor * const * y = b;
+   if ((*x)->order == (*y)->order)
+      return(0);
+   return( ((*x)->order < (*y)->order) ? -1 : 1 );
+}
+
+
+/// Imports dictionary cache file into dictionary
+///
+/// The cache is fully verified before the dictionary is modified, so
+/// TRAD_EDICTRO, TRAD_ECACHE, TRAD_ENOENT, and TRAD_EACCES leave the
+/// dictionary unchanged.
+/// Any other error is returned after objects may have been added and the
+/// dictionary must be discarded.
+///
+/// @param[in]  dict          dictionary reference
+/// @param[in]  file          dictionary cache file
+/// @param[in]  root          top level dictionary file expected in cache
+/// @param[in]  flags         dictionary flags expected in cache
+/// @return returns error code
+int
+tinyrad_dict_cache_import(
+         TinyRadDict *                 dict,
+         const char *                  file,
+         const char *                  root,
+         uint32_t                      flags )
+{
+   int               fd;
+   int               rc;
+   void *            base;
+   struct stat       sb;
+
+   TinyRadDebugTrace();
+
+   assert(dict != NULL);
+   assert(file != NULL);
+
+   if (tinyrad_dict_is_readonly(dict) == TRAD_YES)
+      return(TRAD_EDICTRO);
+
+   if ((fd = open(file, O_RDONLY)) == -1)
+      return( (errno == ENOENT) ? TRAD_ENOENT : TRAD_EACCES );
+   if (fstat(fd, &sb) == -1)
+   {
+      close(fd);
+      return(TRAD_EACCES);
+   };
+   if (sb.st_size < (off_t)sizeof(TinyRadCacheHeader))
+   {
+      close(fd);
+      return(TRAD_ECACHE);
+   };
+
+   base = mmap(NULL, (size_t)sb.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+   close(fd);
+   if (base == MAP_FAILED)
+      return(TRAD_EACCES);
+
+   if ((rc = tinyrad_cache_verify(base, (size_t)sb.st_size, root, flags)) == TRAD_SUCCESS)
+   {
+      if ((rc = tinyrad_dict_bulk_begin(dict)) == TRAD_SUCCESS)
+      {
+         rc = tinyrad_cache_load(dict, base);
+         tinyrad_dict_bulk_end(dict);
+      };
+   };
+
+   munmap(base, (size_t)sb.st_size);
+
+   return(rc);
+}
+
+
+int
+tinyrad_dict_cache_load(
+         TinyRadDict *                 dict,
+         const char *                  file,
+         uint32_t                      opts )
+{
+   TinyRadDebugTrace();
+   assert(dict != NULL);
+   assert(file != NULL);
+   assert(opts == 0);
+   return(tinyrad_dict_cache_import(dict, file, NULL, TRAD_CACHE_NOCHECK));
+}
+
+
+int
+tinyrad_dict_cache_save(
+         TinyRadDict *                 dict,
+         const char *                  file )
+{
+   int                     fd;
+   int                     rc;
+   size_t                  pos;
+   size_t                  idx;
+   size_t                  size;
+   ssize_t                 wlen;
+   char                    tmpfile[256];
+   uint8_t *               buff;
+   void *                  ptr;
+   TinyRadCacheStrTab      strtab;
+   TinyRadCacheHeader *    hdr;
+   TinyRadCacheSource *    srcs;
+   TinyRadCacheVendor *    vends;
+   TinyRadCacheAttr *      attrs;
+   TinyRadCacheValue *     vals;
+   TinyRadDictVendor **    vendor_list;
+   TinyRadDictAttr **      attr_list;
+   TinyRadDictValue **     value_list;
+   TinyRadDictAttr *       attr;
+
+   TinyRadDebugTrace();
+
+   assert(dict != NULL);
+   assert(file != NULL);
+
+   if (snprintf(tmpfile, sizeof(tmpfile), "%s.XXXXXX", file) >= (int)sizeof(tmpfile))
+      return(TRAD_EINVAL);
+
+   // cache contains every definition
+   if ((rc = tinyrad_dict_blocks_load(dict, NULL)) != TRAD_SUCCESS)
+      return(rc);
+
+   memset(&strtab, 0, sizeof(strtab));
+   buff        = NULL;
+   vendor_list = NULL;
+   attr_list   = NULL;
+   value_list  = NULL;
+   rc          = TRAD_ENOMEM;
+
+   // sort objects by creation order
+   if ((vendor_list = malloc(sizeof(TinyRadDictVendor *) * (dict->vendors_id_len + 1))) == NULL)
+      goto cleanup;
+   if ((attr_list = malloc(sizeof(TinyRadDictAttr *) * (dict->attrs_type_len + 1))) == NULL)
+      goto cleanup;
+   if ((value_list = malloc(sizeof(TinyRadDictValue *) * (dict->values_data_len + 1))) == NULL)
+      goto cleanup;
+   if ((dict->vendors_id_len))
+      memcpy(vendor_list, dict->vendors_id, sizeof(TinyRadDictVendor *) * dict->vendors_id_len);
+   if ((dict->attrs_type_len))
+      memcpy(attr_list,   dict->attrs_type, sizeof(TinyRadDictAttr *)   * dict->attrs_type_len);
+   if ((dict->values_data_len))
+      memcpy(value_list,  dict->values_data, sizeof(TinyRadDictValue *) * dict->values_data_len);
+   qsort(vendor_list, dict->vendors_id_len,  sizeof(TinyRadDictVendor *), &tinyrad_cache_cmp_vendor);
+   qsort(attr_list,   dict->attrs_type_len,  sizeof(TinyRadDictAttr *),   &tinyrad_cache_cmp_attr);
+   qsort(value_list,  dict->values_data_len, sizeof(TinyRadDictValue *),  &tinyrad_cache_cmp_value);
+
+   // allocate records
+   size  = sizeof(TinyRadCacheHeader);
+   size += sizeof(TinyRadCacheSource) * dict->sources_len;
+   size += sizeof(TinyRadCacheVendor) * dict->vendors_id_len;
+   size += sizeof(TinyRadCacheAttr)   * dict->attrs_type_len;
+   size += sizeof(TinyRadCacheValue)  * dict->values_data_len;
+   if ((buff = calloc(1, size)) == NULL)
+      goto cleanup;
+   hdr   = (TinyRadCacheHeader *)buff;
+   srcs  = (TinyRadCacheSource *)&hdr[1];
+   vends = (TinyRadCacheVendor *)&srcs[dict->sources_len];
+   attrs = (TinyRadCacheAttr   *)&vends[dict->vendors_id_len];
+   vals  = (TinyRadCacheValue  *)&attrs[dict->attrs_type_len];
+
+   // store source files
+   for(pos = 0; (pos < dict->sources_len); pos++)
+   {
+      srcs[pos].mtime       = dict->sources[pos].mtime;
+      srcs[pos].mtime_nsec  = dict->sources[pos].mtime_nsec;
+      srcs[pos].size        = dict->sources[pos].size;
+      srcs[pos].depth       = dict->sources[pos].depth;
+      if ((rc = tinyrad_cache_strtab_add(&strtab, dict->sources[pos].path, &srcs[pos].path)) != TRAD_SUCCESS)
+         goto cleanup;
+      if ((rc = tinyrad_cache_strtab_add(&strtab, dict->sources[pos].fullpath, &srcs[pos].fullpath)) != TRAD_SUCCESS)
+         goto cleanup;
+   };
+
+   // store vendors
+   for(pos = 0; (pos < dict->vendors_id_len); pos++)
+   {
+      vends[pos].order     = (uint32_t)vendor_list[pos]->order;
+      vends[pos].id        = vendor_list[pos]->id;
+      vends[pos].type_octs = vendor_list[pos]->type_octs;
+      vends[pos].len_octs  = vendor_list[pos]->len_octs;
+      if ((rc = tinyrad_cache_strtab_add(&strtab, vendor_list[pos]->name, &vends[pos].name)) != TRAD_SUCCESS)
+         goto cleanup;
+   };
+
+   // store attributes
+   for(pos = 0; (pos < dict->attrs_type_len); pos++)
+   {
+      attrs[pos].order     = (uint32_t)attr_list[pos]->order;
+      attrs[pos].oid_len   = attr_list[pos]->oid->oid_len;
+      attrs[pos].data_type = attr_list[pos]->data_type;
+      attrs[pos].flags     = attr_list[pos]->flags;
+      memcpy(attrs[pos].oid_val, attr_list[pos]->oid->oid_val, sizeof(uint32_t) * attrs[pos].oid_len);
+      if ((rc = tinyrad_cache_strtab_add(&strtab, attr_list[pos]->name, &attrs[pos].name)) != TRAD_SUCCESS)
+         goto cleanup;
+   };
+
+   // store values
+   for(pos = 0; (pos < dict->values_data_len); pos++)
+   {
+      attr            = value_list[pos]->attr;
+      vals[pos].order = (uint32_t)value_list[pos]->order;
+      vals[pos].data  = value_list[pos]->data;
+      if ((ptr = bsearch(&attr, attr_list, dict->attrs_type_len, sizeof(TinyRadDictAttr *), &tinyrad_cache_cmp_attr)) == NULL)
+      {
+         rc = TRAD_EUNKNOWN;
+         goto cleanup;
+      };
+      idx = (size_t)((TinyRadDictAttr **)ptr - attr_list);
+      vals[pos].attr = (uint32_t)idx;
+      if ((rc = tinyrad_cache_strtab_add(&strtab, value_list[pos]->name, &vals[pos].name)) != TRAD_SUCCESS)
+         goto cleanup;
+   };
+
+   // populate header
+   memcpy(hdr->magic, TRAD_CACHE_MAGIC, sizeof(hdr->magic));
+   hdr->version         = TRAD_CACHE_VERSION;
+   hdr->byte_order      = TRAD_CACHE_BYTE_ORDER;
+   hdr->header_size     = (uint32_t)sizeof(TinyRadCacheHeader);
+   hdr->flags           = dict->opts & TRAD_BUILTIN_DICT_LOADED;
+   hdr->sources_count   = (uint32_t)dict->sources_len;
+   hdr->vendors_count   = (uint32_t)dict->vendors_id_len;
+   hdr->attrs_count     = (uint32_t)dict->attrs_type_len;
+   hdr->values_count    = (uint32_t)dict->values_data_len;
+   hdr->strings_len     = (uint64_t)strtab.len;
+   hdr->file_size       = (uint64_t)(size + strtab.len);
+
+   // write cache to temporary file and rename to replace existing cache
+   if ((fd = mkstemp(tmpfile)) == -1)
+   {
+      rc = TRAD_EACCES;
+      goto cleanup;
+   };
+   rc = TRAD_SUCCESS;
+   if ((wlen = write(fd, buff, size)) != (ssize_t)size)
+      rc = TRAD_EACCES;
+   if ( (rc == TRAD_SUCCESS) && ((strtab.len)) )
+      if ((wlen = write(fd, strtab.buff, strtab.len)) != (ssize_t)strtab.len)
+         rc = TRAD_EACCES;
+   if ( (fchmod(fd, 0644) == -1) && (rc == TRAD_SUCCESS) )
+      rc = TRAD_EACCES;
+   close(fd);
+   if ( (rc == TRAD_SUCCESS) && (rename(tmpfile, file) == -1) )
+      rc = TRAD_EACCES;
+   if (rc != TRAD_SUCCESS)
+      unlink(tmpfile);
+
+   cleanup:
+   free(vendor_list);
+   free(attr_list);
+   free(value_list);
+   free(strtab.buff);
+   free(buff);
+
+   return(rc);
+}
+
+
+/// Creates dictionary objects from cache records
+///
+/// Objects are created in their original creation order, interleaving
+/// vendors, attributes, and values, so that duplicate handling and vendor
+/// resolution of attributes match the original dictionary. The cache must
+/// have been checked by tinyrad_cache_verify(), so the only failures are
+/// errors from adding objects to the dictionary. Objects added before such
+/// a failure are not removed.
+///
+/// @param[in]  dict          dictionary reference
+/// @param[in]  base          address of verified cache
+/// @return returns error code
+static int
+tinyrad_cache_load(
+         TinyRadDict *                 dict,
+         const uint8_t *               base )
+{
+   int                        rc;
+   size_t                     pos;
+   size_t                     vend_idx;
+   size_t                     attr_idx;
+   size_t                     val_idx;
+   uint32_t                   order;
+   const char *               strs;
+   const TinyRadCacheHeader * hdr;
+   const TinyRadCacheSource * srcs;
+   const TinyRadCacheVendor * vends;
+   const TinyRadCacheAttr *   attrs;
+   const TinyRadCacheValue *  vals;
+   TinyRadDictAttr **         attr_list;
+   TinyRadDictVendor *        vendor;
+   TinyRadDictAttr *          attr;
+   TinyRadDictValue *         value;
+   TinyRadOID                 oid;
+
+   TinyRadDebugTrace();
+
+   hdr   = (const TinyRadCacheHeader *)base;
+   srcs  = (const TinyRadCacheSource *)&hdr[1];
+   vends = (const TinyRadCacheVendor *)&srcs[hdr->sources_count];
+   attrs = (const TinyRadCacheAttr   *)&vends[hdr->vendors_count];
+   vals  = (const TinyRadCacheValue  *)&attrs[hdr->attrs_count];
+   strs  = (const char *)&vals[hdr->values_count];
+
+   // attributes referenced by value records
+   if ((attr_list = calloc((size_t)hdr->attrs_count + 1, sizeof(TinyRadDictAttr *))) == NULL)
+      return(TRAD_ENOMEM);
+
+   vend_idx = 0;
+   attr_idx = 0;
+   val_idx  = 0;
+   rc       = TRAD_SUCCESS;
+
+   while ( (rc == TRAD_SUCCESS) && ( (vend_idx < hdr->vendors_count) || (attr_idx < hdr->attrs_count) || (val_idx < hdr->values_count) ) )
+   {
+      order  = UINT32_MAX;
+      order  = ( (vend_idx < hdr->vendors_count) && (vends[vend_idx].order < order) ) ? vends[vend_idx].order : order;
+      order  = ( (attr_idx < hdr->attrs_count)   && (attrs[attr_idx].order < order) ) ? attrs[attr_idx].order : order;
+      order  = ( (val_idx  < hdr->values_count)  && (vals[val_idx].order   < order) ) ? vals[val_idx].order   : order;
+
+      if ( (vend_idx < hdr->vendors_count) && (vends[vend_idx].order == order) )
+      {
+         if ((vendor = tinyrad_dict_vendor_alloc(dict, &strs[vends[vend_idx].name], vends[vend_idx].id, vends[vend_idx].type_octs, vends[vend_idx].len_octs)) == NULL)
+         {
+            rc = TRAD_ENOMEM;
+            break;
+         };
+         rc = tinyrad_dict_add_vendor(dict, vendor);
+         tinyrad_obj_release(&vendor->obj);
+         vend_idx++;
+      }
+      else if ( (attr_idx < hdr->attrs_count) && (attrs[attr_idx].order == order) )
+      {
+         memset(&oid, 0, sizeof(oid));
+         oid.oid_len = attrs[attr_idx].oid_len;
+         memcpy(oid.oid_val, attrs[attr_idx].oid_val, sizeof(uint32_t) * oid.oid_len);
+         if ((attr = tinyrad_dict_attr_alloc(dict, &strs[attrs[attr_idx].name], &oid, attrs[attr_idx].data_type, attrs[attr_idx].flags)) == NULL)
+         {
+            rc = TRAD_ENOMEM;
+            break;
+         };
+         rc = tinyrad_dict_add_attr(dict, attr);
+         attr_list[attr_idx] = attr;
+         attr_idx++;
+      }
+      else
+      {
+         // tinyrad_cache_verify() ensures the attribute was already created
+         attr = attr_list[vals[val_idx].attr];
+         assert(attr != NULL);
+         if ((value = tinyrad_dict_value_alloc(dict, attr, &strs[vals[val_idx].name], vals[val_idx].data)) == NULL)
+         {
+            rc = TRAD_ENOMEM;
+            break;
+         };
+         rc = tinyrad_dict_add_value(dict, attr, value);
+         tinyrad_obj_release(&value->obj);
+         val_idx++;
+      };
+   };
+
+   for(pos = 0; (pos < hdr->attrs_count); pos++)
+      if ((attr_list[pos]))
+         tinyrad_obj_release(&attr_list[pos]->obj);
+   free(attr_list);
+
+   if (rc != TRAD_SUCCESS)
+      return(rc);
+
+   // record source files so the dictionary can be cached again
+   for(pos = 0; (pos < hdr->sources_count); pos++)
+      if ((rc = tinyrad_dict_add_source(dict, &strs[srcs[pos].path], &strs[srcs[pos].fullpath], srcs[pos].mtime, srcs[pos].mtime_nsec, srcs[pos].size, srcs[pos].depth)) != TRAD_SUCCESS)
+         return(rc);
+
+   dict->opts |= hdr->flags & TRAD_BUILTIN_DICT_LOADED;
+
+   return(TRAD_SUCCESS);
+}
+
+
+/// Appends string to cache string table
+///
+/// @param[in]  strtab        string table reference
+/// @param[in]  str           string to append
+/// @param[out] offp          offset of string within table
+/// @return returns error code
+static int
+tinyrad_cache_strtab_add(
+         TinyRadCacheStrTab *          strtab,
+         const char *                  str,
+         uint32_t *                    offp )
+{
+   size_t      len;
+   size_t      size;
+   void *      ptr;
+
+   assert(strtab != NULL);
+   assert(str    != NULL);
+   assert(offp   != NULL);
+
+   len = strlen(str) + 1;
+
+   if ((strtab->len + len) > UINT32_MAX)
+      return(TRAD_ENOBUFS);
+
+   if ((strtab->len + len) > strtab->size)
+   {
+      for(size = ((strtab->size)) ? strtab->size : 4096; (size < (strtab->len + len)); size *= 2);
+      if ((ptr = realloc(strtab->buff, size)) == NULL)
+         return(TRAD_ENOMEM);
+      strtab->buff = ptr;
+      strtab->size = size;
+   };
+
+   memcpy(&strtab->buff[strtab->len], str, len);
+   *offp        = (uint32_t)strtab->len;
+   strtab->len += len;
+
+   return(TRAD_SUCCESS);
+}
+
+
+/// Verifies the structure and freshness of a mapped dictionary cache
+///
+/// @param[in]  base          address of mapped cache
+/// @param[in]  size          size of mapped cache
+/// @param[in]  root          top level dictionary file expected in cache
+/// @param[in]  flags         dictionary flags expected in cache
+/// @return returns error code
+static int
+tinyrad_cache_verify(
+         const uint8_t *               base,
+         size_t                        size,
+         const char *                  root,
+         uint32_t                      flags )
+{
+   size_t                     pos;
+   size_t                     len;
+   size_t                     roots;
+   const char *               strs;
+   const TinyRadCacheHeader * hdr;
+   const TinyRadCacheSource * srcs;
+   const TinyRadCacheVendor * vends;
+   const TinyRadCacheAttr *   attrs;
+   const TinyRadCacheValue *  vals;
+   struct stat                sb;
+
+   TinyRadDebugTrace();
+
+   hdr = (const TinyRadCacheHeader *)base;
+
+   // verify header
+   if ((memcmp(hdr->magic, TRAD_CACHE_MAGIC, sizeof(hdr->magic))))
+      return(TRAD_ECACHE);
+   if (hdr->version != TRAD_CACHE_VERSION)
+      return(TRAD_ECACHE);
+   if (hdr->byte_order != TRAD_CACHE_BYTE_ORDER)
+      return(TRAD_ECACHE);
+   if (hdr->header_size != sizeof(TinyRadCacheHeader))
+      return(TRAD_ECACHE);
+   if ( (flags != TRAD_CACHE_NOCHECK) && (hdr->flags != flags) )
+      return(TRAD_ECACHE);
+
+   // verify size
+   len  = sizeof(TinyRadCacheHeader);
+   len += sizeof(TinyRadCacheSource) * hdr->sources_count;
+   len += sizeof(TinyRadCacheVendor) * hdr->vendors_count;
+   len += sizeof(TinyRadCacheAttr)   * hdr->attrs_count;
+   len += sizeof(TinyRadCacheValue)  * hdr->values_count;
+   if ( (hdr->file_size != size) || ((len + hdr->strings_len) != size) )
+      return(TRAD_ECACHE);
+   if ( ((hdr->strings_len)) && (base[size-1] != '\0') )
+      return(TRAD_ECACHE);
+
+   srcs  = (const TinyRadCacheSource *)&hdr[1];
+   vends = (const TinyRadCacheVendor *)&srcs[hdr->sources_count];
+   attrs = (const TinyRadCacheAttr   *)&vends[hdr->vendors_count];
+   vals  = (const TinyRadCacheValue  *)&attrs[hdr->attrs_count];
+   strs  = (const char *)&vals[hdr->values_count];
+
+   // verify records, records within each table must be in creation order
+   for(pos = 0; (pos < hdr->vendors_count); pos++)
+   {
+      if (vends[pos].name >= hdr->strings_len)
+         return(TRAD_ECACHE);
+      if ( ((pos)) && (vends[pos].order <= vends[pos-1].order) )
+         return(TRAD_ECACHE);
+   };
+   for(pos = 0; (pos < hdr->attrs_count); pos++)
+   {
+      if (attrs[pos].name >= hdr->strings_len)
+         return(TRAD_ECACHE);
+      if ( (!(attrs[pos].oid_len)) || (attrs[pos].oid_len > TRAD_OID_MAX_LEN) )
+         return(TRAD_ECACHE);
+      if ( ((pos)) && (attrs[pos].order <= attrs[pos-1].order) )
+         return(TRAD_ECACHE);
+   };
+   for(pos = 0; (pos < hdr->values_count); pos++)
+   {
+      if (vals[pos].name >= hdr->strings_len)
+         return(TRAD_ECACHE);
+      if ( ((pos)) && (vals[pos].order <= vals[pos-1].order) )
+         return(TRAD_ECACHE);
+      // referenced attribute must be created before the value
+      if (vals[pos].attr >= hdr->attrs_count)
+         return(TRAD_ECACHE);
+      if (attrs[vals[pos].attr].order >= vals[pos].order)
+         return(TRAD_ECACHE);
+   };
+
+   // verify source files have not changed
+   for(pos = 0, roots = 0; (pos < hdr->sources_count); pos++)
+   {
+      if ( (srcs[pos].path >= hdr->strings_len) || (srcs[pos].fullpath >= hdr->strings_len) )
+         return(TRAD_ECACHE);
+      if (stat(&strs[srcs[pos].fullpath], &sb) == -1)
+         return(TRAD_ECACHE);
+      if ( ((int64_t)sb.st_mtime != srcs[pos].mtime) || ((uint32_t)sb.st_mtim.tv_nsec != srcs[pos].mtime_nsec) || ((int64_t)sb.st_size != srcs[pos].size) )
+         return(TRAD_ECACHE);
+      if (srcs[pos].depth != 0)
+         continue;
+      if ( (!(root)) || ((strcmp(root, &strs[srcs[pos].path]))) )
+         roots++;
+   };
+
+   // verify cache was built from the expected top level file
+   if (flags == TRAD_CACHE_NOCHECK)
+      return(TRAD_SUCCESS);
+   if ((roots))
+      return(TRAD_ECACHE);
+   if ((root))
+   {
+      for(pos = 0; (pos < hdr->sources_count); pos++)
+         if ( (srcs[pos].depth == 0) && (!(strcmp(root, &strs[srcs[pos].path]))) )
+            return(TRAD_SUCCESS);
+      return(TRAD_ECACHE);
+   };
+
+   return(TRAD_SUCCESS);
+}
+
+/* end of source */
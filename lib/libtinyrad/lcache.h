@@ -0,0 +1,148 @@
+/*
+ *  Tiny RADIUS Client Library
+ *  Copyright (C) 2021 David M. Syzdek <david@syzdek.net>.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of David M. Syzdek nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL DAVID M. SYZDEK BE LIABLE FOR
+ *  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ *  OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ *  SUCH DAMAGE.
+ */
+#ifndef _LIB_LIBTINYRAD_LCACHE_H
+#define _LIB_LIBTINYRAD_LCACHE_H 1
+
+
+///////////////
+//           //
+//  Headers  //
+//           //
+///////////////
+#pragma mark - Headers
+
+#include "libtinyrad.h"
+#include "loid.h"
+
+
+///////////////////
+//               //
+//  Definitions  //
+//               //
+///////////////////
+#pragma mark - Definitions
+
+#define TRAD_CACHE_MAGIC            "TRADDICT"
+#define TRAD_CACHE_VERSION          2
+#define TRAD_CACHE_BYTE_ORDER       0x01020304U
+
+// skips flags and top level file checks when importing cache
+#define TRAD_CACHE_NOCHECK          0xffffffffU
+
+
+//////////////////
+//              //
+//  Data Types  //
+//              //
+//////////////////
+#pragma mark - Data Types
+
+// All records are fixed size and 8 byte aligned. Names are stored as
+// offsets into the string table which follows the value records. The
+// records of each type are stored in the order the objects were created.
+
+typedef struct tinyrad_cache_header
+{
+   char                 magic[8];
+   uint32_t             version;
+   uint32_t             byte_order;
+   uint32_t             header_size;
+   uint32_t             flags;
+   uint32_t             sources_count;
+   uint32_t             vendors_count;
+   uint32_t             attrs_count;
+   uint32_t             values_count;
+   uint64_t             strings_len;
+   uint64_t             file_size;
+} TinyRadCacheHeader;
+
+
+typedef struct tinyrad_cache_source
+{
+   int64_t              mtime;
+   int64_t              size;
+   uint32_t             path;
+   uint32_t             fullpath;
+   uint32_t             depth;
+   uint32_t             mtime_nsec;
+} TinyRadCacheSource;
+
+
+typedef struct tinyrad_cache_vendor
+{
+   uint32_t             order;
+   uint32_t             name;
+   uint32_t             id;
+   uint8_t              type_octs;
+   uint8_t              len_octs;
+   uint16_t             pad16;
+} TinyRadCacheVendor;
+
+
+typedef struct tinyrad_cache_attr
+{
+   uint32_t             order;
+   uint32_t             name;
+   uint32_t             oid_len;
+   uint32_t             oid_val[TRAD_OID_MAX_LEN];
+   uint8_t              data_type;
+   uint8_t              pad8;
+   uint16_t             flags;
+   uint32_t             pad32;
+} TinyRadCacheAttr;
+
+
+typedef struct tinyrad_cache_value
+{
+   uint64_t             data;
+   uint32_t             order;
+   uint32_t             name;
+   uint32_t             attr;         // index of attribute record
+   uint32_t             pad32;
+} TinyRadCacheValue;
+
+
+//////////////////
+//              //
+//  Prototypes  //
+//              //
+//////////////////
+#pragma mark - Prototypes
+
+int
+tinyrad_dict_cache_import(
+         TinyRadDict *                 dict,
+         const char *                  file,
+         const char *                  root,
+         uint32_t                      flags );
+
+
+#endif /* end of header */
@@ -50,6 +50,7 @@
 #include <assert.h>
 
 #include "ldict.h"
+#include "lfile.h"
 #include "lmap.h"
 #include "lstrings.h"
 
@@ -78,6 +79,7 @@
 #define TRAD_CONF_RANDOM                     11
 #define TRAD_CONF_IPV4                       12
 #define TRAD_CONF_IPV6                       13
+#define TRAD_CONF_DICTIONARY_CACHE           14
 
 
 /////////////////
@@ -93,6 +95,7 @@ static const TinyRadMap tinyrad_conf_options[] =
    { "BIND_ADDRESS",          TRAD_CONF_BIND_ADDRESS },
    { "BUILTIN_DICTIONARY",    TRAD_CONF_BUILTIN_DICTIONARY },
    { "DICTIONARY",            TRAD_CONF_DICTIONARY },
+   { "DICTIONARY_CACHE",      TRAD_CONF_DICTIONARY_CACHE },
    { "IPV4",                  TRAD_CONF_IPV4 },
    { "IPV6",                  TRAD_CONF_IPV6 },
    { "NETWORK_TIMEOUT",       TRAD_CONF_NETWORK_TIMEOUT },
@@ -312,11 +315,12 @@ tinyrad_conf_file(
    int            fd;
    int            rc;
    int            argc;
+   TinyRadFile *  fbuff;
    char           buff[TRAD_LINE_MAX_LEN];
    char           value[TRAD_LINE_MAX_LEN];
    const char *   val;
    size_t         len;
-   char **        argv;
+   char *         argv[TRAD_ARGV_MAX];
    uint64_t       optid;
 
    TinyRadDebugTrace();
@@ -329,31 +333,32 @@ tinyrad_conf_file(
 
    if ((fd = open(file, O_RDONLY)) == -1)
       return(TRAD_SUCCESS);
+   if ((rc = tinyrad_file_fdopen(&fbuff, file, fd)) != TRAD_SUCCESS)
+   {
+      tinyrad_file_destroy(fbuff, TRAD_FILE_NORECURSE);
+      return(rc);
+   };
 
    while( ((len)) && (rc == TRAD_SUCCESS) )
    {
-      if ((rc = tinyrad_readline(fd, buff, sizeof(buff), &len)) != TRAD_SUCCESS)
+      if ((rc = tinyrad_file_readline(fbuff, buff, sizeof(buff), &len)) != TRAD_SUCCESS)
          continue;
       if (!(len))
          continue;
-      if ((rc = tinyrad_strtoargs(buff, &argv, &argc)) != TRAD_SUCCESS)
+      if ((rc = tinyrad_strtoargv(buff, argv, TRAD_ARGV_MAX, &argc)) != TRAD_SUCCESS)
       {
          if (rc == TRAD_ESYNTAX)
             rc = TRAD_SUCCESS;
          continue;
       };
       if ( (argc < 1) || (argc > 2) )
-      {
-         tinyrad_strsfree(argv);
          continue;
-      };
       val = tinyrad_strexpand(value, argv[1], sizeof(value), TRAD_NO);
       if ((optid = tinyrad_map_lookup_name(tinyrad_conf_options, argv[0], NULL)) > 0)
          rc = tinyrad_conf_opt(tr, dict, optid, val);
-      tinyrad_strsfree(argv);
    };
 
-   close(fd);
+   tinyrad_file_destroy(fbuff, TRAD_FILE_NORECURSE);
 
    if (rc != TRAD_SUCCESS)
       return(rc);
@@ -405,6 +410,14 @@ tinyrad_conf_opt(
          return(TRAD_ENOMEM);
       return(TRAD_SUCCESS);
 
+      case TRAD_CONF_DICTIONARY_CACHE:
+      TinyRadDebug(TRAD_DEBUG_ARGS, "   == %s( tr, TRAD_CONF_DICTIONARY_CACHE, \"%s\" )", __func__, (((value)) ? value : "(null)"));
+      if ( (!(dict)) || ((dict->cache_file)) || (!(value)) )
+         return(TRAD_SUCCESS);
+      if ((dict->cache_file = tinyrad_strdup(value)) == NULL)
+         return(TRAD_ENOMEM);
+      return(TRAD_SUCCESS);
+
       case TRAD_CONF_IPV4:
       TinyRadDebug(TRAD_DEBUG_ARGS, "   == %s( tr, TRAD_CONF_IPV4, \"%s\" )", __func__, (((value)) ? value : "(null)"));
       if ( (!(tr)) || ((tr->opts & TRAD_IPV4)) || ((tr->opts_neg & TRAD_IPV4)) )
@@ -595,6 +608,7 @@ tinyrad_conf_print(
       printf("# TinyRad Dictionary Configuration:\n");
       tinyrad_conf_print_bool( 0,                        "BUILTIN_DICTIONARY",   ((dict->opts & TRAD_BUILTIN_DICT)) );
       tinyrad_conf_print_str(  (dict->default_dictfile == NULL),  "DICTIONARY",   dict->default_dictfile );
+      tinyrad_conf_print_str(  (dict->cache_file == NULL),        "DICTIONARY_CACHE", dict->cache_file );
       tinyrad_conf_print_bool( 1,                        "IPV4",           TRAD_YES );
       if ( ((dict->paths)) && ((dict->paths[0])) )
       {
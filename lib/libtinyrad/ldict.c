@@ -39,6 +39,7 @@
 ///////////////
 #pragma mark - Headers
 
+#include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -50,7 +51,10 @@
 #include <sys/stat.h>
 #include <errno.h>
 #include <assert.h>
+#include <pthread.h>
 
+#include "larray.h"
+#include "lcache.h"
 #include "lconf.h"
 #include "lerror.h"
 #include "lfile.h"
@@ -106,11 +110,62 @@ tinyrad_dict_add_vendor(
          TinyRadDictVendor *          vendor );
 
 
+static int
+__dict_is_hashed(
+         TinyRadDict *                dict );
+
+
+static void
+__dict_list_shrink(
+         void ***                     listp,
+         size_t                       len,
+         size_t *                     sizep );
+
+
+static void
+__dict_list_sort(
+         void **                      list,
+         size_t                       sorted,
+         size_t                       len,
+         int (*compar)(const void *, const void *) );
+
+
+void
+tinyrad_dict_bulk_add(
+         void ***                     listp,
+         size_t *                     lenp,
+         void *                       obj,
+         TinyRadDictHash *            hash,
+         uint64_t                     hval,
+         const void *                 key,
+         int (*compar)(const void *, const void *) );
+
+
+int
+tinyrad_dict_bulk_grow(
+         void ***                     listp,
+         size_t                       len,
+         size_t *                     sizep,
+         TinyRadDictHash *            hash );
+
+
+int
+tinyrad_dict_bulk_reserve(
+         void ***                     listp,
+         size_t                       len,
+         size_t *                     sizep );
+
+
 void
 tinyrad_dict_free(
          TinyRadDict *                dict );
 
 
+int
+tinyrad_dict_freeze(
+         TinyRadDict *                dict );
+
+
 int
 tinyrad_dict_is_readonly(
          TinyRadDict *                dict );
@@ -126,6 +181,18 @@ __attr_len_octs(
          const TinyRadDictAttr *       attr );
 
 
+static int
+__attr_prefix_add(
+         void *                        obj,
+         void *                        ctx );
+
+
+static int
+__attr_prefix_cmp(
+         const void *                  a,
+         const void *                  b );
+
+
 static uint32_t
 __attr_type(
          const TinyRadDictAttr *       attr );
@@ -173,6 +240,12 @@ tinyrad_dict_attr_cmp_key_vendor(
          const void *                 key );
 
 
+int
+tinyrad_dict_attr_cmp_key_vendor_type(
+         const void *                 ptr,
+         const void *                 key );
+
+
 int
 tinyrad_dict_attr_cmp_obj_name(
          const void *                 a,
@@ -198,6 +271,151 @@ tinyrad_dict_attr_index(
          int                          by_vendor );
 
 
+int
+tinyrad_dict_attr_index_values(
+         TinyRadDict *                dict,
+         TinyRadDictAttr *            attr );
+
+
+static TinyRadDictAttr *
+tinyrad_dict_attr_lookup_local(
+         TinyRadDict *                 dict,
+         const char *                  name,
+         const TinyRadOID *            oid );
+
+
+static ssize_t
+tinyrad_dict_attr_search_name(
+         TinyRadDictAttr * const *     base,
+         size_t                        nel,
+         const char *                  key,
+         unsigned                      opts );
+
+
+static ssize_t
+tinyrad_dict_attr_search_type(
+         TinyRadDictAttr * const *     base,
+         size_t                        nel,
+         const TinyRadOID *            key,
+         unsigned                      opts );
+
+
+static ssize_t
+tinyrad_dict_attr_search_vendor(
+         TinyRadDictAttr * const *     base,
+         size_t                        nel,
+         const uint32_t *              key,
+         unsigned                      opts );
+
+
+//-----------------------------//
+// dictionary block prototypes //
+//-----------------------------//
+#pragma mark dictionary block prototypes
+
+static int
+__dict_blocks_pending(
+         TinyRadDict *                 dict );
+
+
+static int
+tinyrad_dict_blocks_add(
+         TinyRadDict *                 dict,
+         TinyRadDictVendor *           vendor,
+         TinyRadFile *                 file,
+         off_t                         offset,
+         int                           line );
+
+
+static void
+tinyrad_dict_blocks_free(
+         TinyRadDictBlock *            block );
+
+
+static int
+tinyrad_dict_blocks_parse(
+         TinyRadDict *                 dict,
+         TinyRadDictVendor *           vendor,
+         TinyRadDictBlock *            block );
+
+
+static TinyRadDictVendor *
+tinyrad_dict_blocks_vendor(
+         TinyRadDict *                 dict,
+         const char *                  name,
+         uint32_t                      id );
+
+
+//----------------------------//
+// dictionary hash prototypes //
+//----------------------------//
+#pragma mark dictionary hash prototypes
+
+static uint64_t
+__hash_oid(
+         uint64_t                      hash,
+         const TinyRadOID *            oid );
+
+
+static uint64_t
+__hash_str(
+         uint64_t                      hash,
+         const char *                  str );
+
+
+static uint64_t
+__hash_u64(
+         uint64_t                      hash,
+         uint64_t                      val );
+
+
+int
+tinyrad_dict_hash_add(
+         TinyRadDictHash *             hash,
+         uint64_t                      hval,
+         void *                        obj,
+         const void *                  key,
+         int (*compar)(const void *, const void *) );
+
+
+int
+tinyrad_dict_hash_build(
+         TinyRadDict *                 dict );
+
+
+void
+tinyrad_dict_hash_free(
+         TinyRadDictHash *             hash );
+
+
+int
+tinyrad_dict_hash_grow(
+         TinyRadDictHash *             hash );
+
+
+int
+tinyrad_dict_hash_init(
+         TinyRadDictHash *             hash,
+         size_t                        len );
+
+
+void
+tinyrad_dict_hash_insert(
+         TinyRadDictHash *             hash,
+         uint64_t                      hval,
+         void *                        obj,
+         const void *                  key,
+         int (*compar)(const void *, const void *) );
+
+
+void *
+tinyrad_dict_hash_lookup(
+         const TinyRadDictHash *       hash,
+         uint64_t                      hval,
+         const void *                  key,
+         int (*compar)(const void *, const void *) );
+
+
 //------------------------------//
 // dictionary import prototypes //
 //------------------------------//
@@ -209,6 +427,15 @@ tinyrad_dict_builtin(
          char ***                      msgsp );
 
 
+int
+tinyrad_dict_import_defs(
+         TinyRadDict *                 dict,
+         const TinyRadDictVendorDef *  vendor_defs,
+         const TinyRadDictAttrDef *    attr_defs,
+         const TinyRadDictValueDef *   value_defs,
+         char ***                      msgsp );
+
+
 //-----------------------------//
 // dictionary parse prototypes //
 //-----------------------------//
@@ -231,6 +458,11 @@ tinyrad_dict_parse_begin_vendor(
          TinyRadDictVendor **         vendorp );
 
 
+static int
+tinyrad_dict_parse_cycle(
+         const TinyRadFile *          file );
+
+
 int
 tinyrad_dict_parse_end_vendor(
          TinyRadDict *                dict,
@@ -239,6 +471,14 @@ tinyrad_dict_parse_end_vendor(
          TinyRadDictVendor **         vendorp );
 
 
+int
+tinyrad_dict_parse_file(
+         TinyRadDict *                dict,
+         const char *                 path,
+         char ***                     msgsp,
+         uint32_t                     opts );
+
+
 int
 tinyrad_dict_parse_include(
          TinyRadDict *                dict,
@@ -247,6 +487,69 @@ tinyrad_dict_parse_include(
          TinyRadFile **               filep );
 
 
+static TinyRadDictJob *
+tinyrad_dict_parse_job(
+         TinyRadDictPool *            pool,
+         TinyRadDictJob *             parent,
+         const char *                 path );
+
+
+static int
+tinyrad_dict_parse_job_open(
+         TinyRadDictPool *            pool,
+         TinyRadDictJob *             job );
+
+
+static int
+tinyrad_dict_parse_job_tokenize(
+         TinyRadDictPool *            pool,
+         TinyRadDictJob *             job );
+
+
+static int
+tinyrad_dict_parse_keyword(
+         TinyRadDict *                dict,
+         int                          keyword,
+         int                          argc,
+         char **                      argv,
+         TinyRadDictVendor **         vendorp,
+         uint32_t                     opts );
+
+
+static int
+tinyrad_dict_parse_merge(
+         TinyRadDict *                dict,
+         TinyRadDictPool *            pool,
+         TinyRadDictJob *             job,
+         TinyRadDictVendor **         vendorp,
+         char ***                     msgsp,
+         uint32_t                     opts );
+
+
+static int
+tinyrad_dict_parse_parallel(
+         TinyRadDict *                dict,
+         const char *                 path,
+         char ***                     msgsp,
+         uint32_t                     opts );
+
+
+static void
+tinyrad_dict_parse_pool_free(
+         TinyRadDictPool *            pool );
+
+
+static void *
+tinyrad_dict_parse_pool_worker(
+         void *                       arg );
+
+
+int
+tinyrad_dict_parse_source(
+         TinyRadDict *                dict,
+         TinyRadFile *                file );
+
+
 int
 tinyrad_dict_parse_value(
          TinyRadDict *                dict,
@@ -268,6 +571,13 @@ tinyrad_dict_parse_vendor(
 //-----------------------------//
 #pragma mark dictionary print prototypes
 
+static void
+tinyrad_dict_compile_str(
+         FILE *                        fs,
+         const char *                  str,
+         int                           width );
+
+
 void
 tinyrad_dict_print_attribute(
          TinyRadDict *                 dict,
@@ -286,6 +596,119 @@ tinyrad_dict_print_vendor(
          size_t                        vendor_idx );
 
 
+//-----------------------------//
+// dictionary stats prototypes //
+//-----------------------------//
+#pragma mark dictionary stats prototypes
+
+static size_t
+__dict_stats_hash(
+         const TinyRadDictHash *       hash );
+
+
+static void
+__dict_stats_lookup(
+         TinyRadDict *                 dict,
+         const void *                  obj,
+         uint64_t                      probes );
+
+
+static void
+tinyrad_dict_stats(
+         TinyRadDict *                 dict,
+         TinyRadDictStats *            stats );
+
+
+//------------------------------//
+// dictionary string prototypes //
+//------------------------------//
+#pragma mark dictionary string prototypes
+
+static const TinyRadDictStr *
+__dict_str(
+         const char *                  str );
+
+
+TinyRadDictStrPool *
+tinyrad_dict_strpool_alloc(
+         void );
+
+
+int
+tinyrad_dict_strpool_cmp_key(
+         const void *                  ptr,
+         const void *                  key );
+
+
+void
+tinyrad_dict_strpool_free(
+         TinyRadDictStrPool *          pool );
+
+
+char *
+tinyrad_dict_strpool_intern(
+         TinyRadDictStrPool *          pool,
+         const char *                  str );
+
+
+//----------------------------//
+// dictionary trie prototypes //
+//----------------------------//
+#pragma mark dictionary trie prototypes
+
+static size_t
+__trie_child(
+         const TinyRadDictTrie *       node,
+         unsigned char                 c );
+
+
+static unsigned char
+__trie_fold(
+         unsigned char                 c );
+
+
+static TinyRadDictTrie *
+tinyrad_dict_trie_alloc(
+         const char *                  label,
+         size_t                        len );
+
+
+static int
+tinyrad_dict_trie_build(
+         TinyRadDict *                 dict );
+
+
+static const TinyRadDictTrie *
+tinyrad_dict_trie_find(
+         const TinyRadDictTrie *       trie,
+         const char *                  key,
+         int                           prefix );
+
+
+static void
+tinyrad_dict_trie_free(
+         TinyRadDictTrie *             trie );
+
+
+static int
+tinyrad_dict_trie_insert(
+         TinyRadDictTrie **            triep,
+         const char *                  key,
+         void *                        obj );
+
+
+static size_t
+tinyrad_dict_trie_size(
+         const TinyRadDictTrie *       trie );
+
+
+static int
+tinyrad_dict_trie_walk(
+         const TinyRadDictTrie *       trie,
+         int (*func)(void *, void *),
+         void *                        ctx );
+
+
 //-----------------------------//
 // dictionary value prototypes //
 //-----------------------------//
@@ -364,6 +787,38 @@ tinyrad_dict_value_index(
          int                           by_attr );
 
 
+static TinyRadDictValue *
+tinyrad_dict_value_lookup_local(
+         TinyRadDict *                dict,
+         TinyRadDictAttr *            attr,
+         const char *                 name,
+         uint64_t                     data );
+
+
+static ssize_t
+tinyrad_dict_value_search_attr(
+         TinyRadDictValue * const *    base,
+         size_t                        nel,
+         const TinyRadDictKey *        key,
+         unsigned                      opts );
+
+
+static ssize_t
+tinyrad_dict_value_search_data(
+         TinyRadDictValue * const *    base,
+         size_t                        nel,
+         const TinyRadDictKey *        key,
+         unsigned                      opts );
+
+
+static ssize_t
+tinyrad_dict_value_search_name(
+         TinyRadDictValue * const *    base,
+         size_t                        nel,
+         const TinyRadDictKey *        key,
+         unsigned                      opts );
+
+
 //------------------------------//
 // dictionary vendor prototypes //
 //------------------------------//
@@ -407,6 +862,35 @@ tinyrad_dict_vendor_free(
          TinyRadDictVendor *          vendor );
 
 
+int
+tinyrad_dict_vendor_index(
+         TinyRadDict *                dict,
+         TinyRadDictVendor *          vendor );
+
+
+static TinyRadDictVendor *
+tinyrad_dict_vendor_lookup_local(
+         TinyRadDict *                dict,
+         const char *                 name,
+         uint32_t                     id );
+
+
+static ssize_t
+tinyrad_dict_vendor_search_id(
+         TinyRadDictVendor * const *   base,
+         size_t                        nel,
+         const uint32_t *              key,
+         unsigned                      opts );
+
+
+static ssize_t
+tinyrad_dict_vendor_search_name(
+         TinyRadDictVendor * const *   base,
+         size_t                        nel,
+         const char *                  key,
+         unsigned                      opts );
+
+
 /////////////////
 //             //
 //  Variables  //
@@ -454,6 +938,16 @@ static const TinyRadMap tinyrad_dict_attr_flags[] =
 };
 
 
+#pragma mark tinyrad_dict_blocks_owner
+// dictionary parsed by the current thread, which skips the blocks lock
+static _Thread_local TinyRadDict * tinyrad_dict_blocks_owner = NULL;
+
+
+#pragma mark tinyrad_dict_probes
+// hash slots examined by the current thread, attributed to lookups by delta
+static _Thread_local uint64_t tinyrad_dict_probes = 0;
+
+
 #pragma mark tinyrad_dict_options[]
 static const TinyRadMap tinyrad_dict_options[] =
 {
@@ -484,9 +978,7 @@ tinyrad_dict_add_attr(
          TinyRadDict *                 dict,
          TinyRadDictAttr *             attr )
 {
-   size_t               size;
    size_t               width;
-   void *               ptr;
    TinyRadDictAttr *    old;
    ssize_t              rc;
    unsigned             opts;
@@ -517,19 +1009,30 @@ tinyrad_dict_add_attr(
          return(TRAD_EEXISTS);
    };
 
-   // resize attribute name list in dictionary
-   size = sizeof(TinyRadDictAttr *) * (dict->attrs_name_len+1);
-   if ((ptr = realloc(dict->attrs_name, size)) == NULL)
-      return(TRAD_ENOMEM);
-   dict->attrs_name = ptr;
-
-   // resize attribute type list in dictionary
-   size = sizeof(TinyRadDictAttr *) * (dict->attrs_type_len+1);
-   if ((ptr = realloc(dict->attrs_type, size)) == NULL)
-      return(TRAD_ENOMEM);
-   dict->attrs_type = ptr;
+   // append attribute to lists while bulk loading, lists are sorted once loaded
+   if ((dict->bulk))
+   {
+      // grow both lists before either list is modified
+      if (tinyrad_dict_bulk_grow((void ***)&dict->attrs_name, dict->attrs_name_len, &dict->lists_size.attrs_name, &dict->attrs_name_hash) != TRAD_SUCCESS)
+         return(TRAD_ENOMEM);
+      if (tinyrad_dict_bulk_grow((void ***)&dict->attrs_type, dict->attrs_type_len, &dict->lists_size.attrs_type, &dict->attrs_type_hash) != TRAD_SUCCESS)
+         return(TRAD_ENOMEM);
+      tinyrad_dict_bulk_add((void ***)&dict->attrs_name, &dict->attrs_name_len, attr, &dict->attrs_name_hash, __dict_str(attr->name)->hash, attr->name, &tinyrad_dict_attr_cmp_key_name);
+      tinyrad_obj_retain(&attr->obj);
+      tinyrad_dict_bulk_add((void ***)&dict->attrs_type, &dict->attrs_type_len, attr, &dict->attrs_type_hash, __hash_oid(TRAD_DICT_HASH_SEED, attr->oid), attr->oid, &tinyrad_dict_attr_cmp_key_type);
+      tinyrad_obj_retain(&attr->obj);
+      if ( (attr->oid->oid_len == 1) && (attr->oid->oid_val[0] < TRAD_DICT_STD_ATTRS) )
+         dict->attrs_std[attr->oid->oid_val[0]] = attr;
+      return(TRAD_SUCCESS);
+   };
 
    width = sizeof(TinyRadDictAttr *);
+
+   // grow attribute lists in dictionary before either list is modified
+   if (tinyrad_array_grow((void **)&dict->attrs_name, dict->attrs_name_len, &dict->lists_size.attrs_name, width, &realloc) != 0)
+      return(TRAD_ENOMEM);
+   if (tinyrad_array_grow((void **)&dict->attrs_type, dict->attrs_type_len, &dict->lists_size.attrs_type, width, &realloc) != 0)
+      return(TRAD_ENOMEM);
    opts  = TINYRAD_ARRAY_INSERT | TINYRAD_ARRAY_LASTDUP;
 
    // save attribute by name to dictionary
@@ -542,45 +1045,120 @@ tinyrad_dict_add_attr(
       return( (rc == -2) ? TRAD_ENOMEM : TRAD_EEXISTS);
    tinyrad_obj_retain(&attr->obj);
 
+   // save standard attribute to direct-indexed table (last definition wins)
+   if ( (attr->oid->oid_len == 1) && (attr->oid->oid_val[0] < TRAD_DICT_STD_ATTRS) )
+      dict->attrs_std[attr->oid->oid_val[0]] = attr;
+
    return(TRAD_SUCCESS);
 }
 
 
+/// Records a file used to build the dictionary
+///
+/// @param[in]  dict          dictionary reference
+/// @param[in]  path          file name as included
+/// @param[in]  fullpath      file name after searching paths
+/// @param[in]  mtime         modification time of file
+/// @param[in]  mtime_nsec    nanoseconds of modification time of file
+/// @param[in]  size          size of file
+/// @param[in]  depth         include depth of file
+/// @return returns error code
 int
-tinyrad_dict_add_value(
+tinyrad_dict_add_source(
          TinyRadDict *                 dict,
-         TinyRadDictAttr *             attr,
-         TinyRadDictValue *            value )
+         const char *                  path,
+         const char *                  fullpath,
+         int64_t                       mtime,
+         uint32_t                      mtime_nsec,
+         int64_t                       size,
+         uint32_t                      depth )
 {
-   size_t               size;
-   size_t               width;
-   ssize_t              rc;
+   size_t               size_bytes;
    void *               ptr;
-   unsigned             opts;
-   int (*compar)(const void *, const void *);
+   TinyRadDictSource *  source;
 
    TinyRadDebugTrace();
 
-   assert(dict  != NULL);
-   assert(attr  != NULL);
-   assert(value != NULL);
+   assert(dict     != NULL);
+   assert(path     != NULL);
+   assert(fullpath != NULL);
 
-   // increase size of value by name list in dictionary
-   size = sizeof(TinyRadDictValue *) * (dict->values_name_len+1);
-   if ((ptr = realloc(dict->values_name, size)) == NULL)
+   size_bytes = sizeof(TinyRadDictSource) * (dict->sources_len+1);
+   if ((ptr = realloc(dict->sources, size_bytes)) == NULL)
       return(TRAD_ENOMEM);
-   dict->values_name = ptr;
+   dict->sources = ptr;
 
-    // increase size of value by data list in dictionary
-   size = sizeof(TinyRadDictValue *) * (dict->values_data_len+1);
-   if ((ptr = realloc(dict->values_data, size)) == NULL)
+   source = &dict->sources[dict->sources_len];
+   memset(source, 0, sizeof(TinyRadDictSource));
+   source->mtime       = mtime;
+   source->mtime_nsec  = mtime_nsec;
+   source->size        = size;
+   source->depth  = depth;
+
+   if ((source->path = tinyrad_strdup(path)) == NULL)
+      return(TRAD_ENOMEM);
+   if ((source->fullpath = tinyrad_strdup(fullpath)) == NULL)
+   {
+      free(source->path);
       return(TRAD_ENOMEM);
-   dict->values_data = ptr;
+   };
 
-   // save value by name in dictionary
-   opts     = TINYRAD_ARRAY_INSERT;
-   width    = sizeof(TinyRadDictValue *);
-   compar   = &tinyrad_dict_value_cmp_obj_name;
+   dict->sources_len++;
+
+   return(TRAD_SUCCESS);
+}
+
+
+int
+tinyrad_dict_add_value(
+         TinyRadDict *                 dict,
+         TinyRadDictAttr *             attr,
+         TinyRadDictValue *            value )
+{
+   size_t               width;
+   ssize_t              rc;
+   unsigned             opts;
+   uint64_t             hval;
+   TinyRadDictKey       key;
+   int (*compar)(const void *, const void *);
+
+   TinyRadDebugTrace();
+
+   assert(dict  != NULL);
+   assert(attr  != NULL);
+   assert(value != NULL);
+
+   // append value to lists while bulk loading, lists are sorted once loaded
+   if ((dict->bulk))
+   {
+      if (tinyrad_dict_value_lookup(dict, attr, value->name, 0) != NULL)
+         return(TRAD_EEXISTS);
+      memset(&key, 0, sizeof(key));
+      key.oid  = attr->oid;
+      key.str  = value->name;
+      key.data = value->data;
+      hval     = __hash_oid(TRAD_DICT_HASH_SEED, key.oid);
+      if (tinyrad_dict_bulk_grow((void ***)&dict->values_name, dict->values_name_len, &dict->lists_size.values_name, &dict->values_name_hash) != TRAD_SUCCESS)
+         return(TRAD_ENOMEM);
+      if (tinyrad_dict_bulk_grow((void ***)&dict->values_data, dict->values_data_len, &dict->lists_size.values_data, &dict->values_data_hash) != TRAD_SUCCESS)
+         return(TRAD_ENOMEM);
+      tinyrad_dict_bulk_add((void ***)&dict->values_name, &dict->values_name_len, value, &dict->values_name_hash, __hash_u64(hval, __dict_str(key.str)->hash), &key, &tinyrad_dict_value_cmp_key_name);
+      tinyrad_obj_retain(&value->obj);
+      tinyrad_dict_bulk_add((void ***)&dict->values_data, &dict->values_data_len, value, &dict->values_data_hash, __hash_u64(hval, key.data), &key, &tinyrad_dict_value_cmp_key_data);
+      tinyrad_obj_retain(&value->obj);
+      return(TRAD_SUCCESS);
+   };
+
+   // grow value lists in dictionary before either list is modified
+   width    = sizeof(TinyRadDictValue *);
+   if (tinyrad_array_grow((void **)&dict->values_name, dict->values_name_len, &dict->lists_size.values_name, width, &realloc) != 0)
+      return(TRAD_ENOMEM);
+   if (tinyrad_array_grow((void **)&dict->values_data, dict->values_data_len, &dict->lists_size.values_data, width, &realloc) != 0)
+      return(TRAD_ENOMEM);
+
+   // save value by name in dictionary
+   opts     = TINYRAD_ARRAY_INSERT;
+   compar   = &tinyrad_dict_value_cmp_obj_name;
    if ((rc = tinyrad_array_add((void **)&dict->values_name, &dict->values_name_len, width, &value, opts, compar, NULL, NULL)) < 0)
       return( (rc == -2) ? TRAD_ENOMEM : TRAD_EEXISTS);
    tinyrad_obj_retain(&value->obj);
@@ -602,11 +1180,9 @@ tinyrad_dict_add_vendor(
          TinyRadDict *                dict,
          TinyRadDictVendor *          vendor )
 {
-   size_t               size;
    size_t               width;
    ssize_t              rc;
    unsigned             opts;
-   void *               ptr;
    TinyRadDictVendor *  old;
    int (*compar)(const void *, const void *);
 
@@ -636,21 +1212,30 @@ tinyrad_dict_add_vendor(
          return(TRAD_EEXISTS);
    };
 
-   // resize vendor by name list
-   size = sizeof(TinyRadDictVendor *) * (dict->vendors_name_len + 2);
-   if ((ptr = realloc(dict->vendors_name, size)) == NULL)
-      return(TRAD_ENOMEM);
-   dict->vendors_name = ptr;
+   // append vendor to lists while bulk loading, lists are sorted once loaded
+   if ((dict->bulk))
+   {
+      // grow both lists before either list is modified
+      if (tinyrad_dict_bulk_grow((void ***)&dict->vendors_name, dict->vendors_name_len, &dict->lists_size.vendors_name, &dict->vendors_name_hash) != TRAD_SUCCESS)
+         return(TRAD_ENOMEM);
+      if (tinyrad_dict_bulk_grow((void ***)&dict->vendors_id, dict->vendors_id_len, &dict->lists_size.vendors_id, &dict->vendors_id_hash) != TRAD_SUCCESS)
+         return(TRAD_ENOMEM);
+      tinyrad_dict_bulk_add((void ***)&dict->vendors_name, &dict->vendors_name_len, vendor, &dict->vendors_name_hash, __dict_str(vendor->name)->hash, vendor->name, &tinyrad_dict_vendor_cmp_key_name);
+      tinyrad_obj_retain(&vendor->obj);
+      tinyrad_dict_bulk_add((void ***)&dict->vendors_id, &dict->vendors_id_len, vendor, &dict->vendors_id_hash, __hash_u64(TRAD_DICT_HASH_SEED, vendor->id), &vendor->id, &tinyrad_dict_vendor_cmp_key_id);
+      tinyrad_obj_retain(&vendor->obj);
+      return(TRAD_SUCCESS);
+   };
 
-   // resize vendor by id list
-   size = sizeof(TinyRadDictVendor *) * (dict->vendors_id_len + 2);
-   if ((ptr = realloc(dict->vendors_id, size)) == NULL)
+   // grow vendor lists before either list is modified
+   width    = sizeof(TinyRadDictVendor *);
+   if (tinyrad_array_grow((void **)&dict->vendors_name, dict->vendors_name_len, &dict->lists_size.vendors_name, width, &realloc) != 0)
+      return(TRAD_ENOMEM);
+   if (tinyrad_array_grow((void **)&dict->vendors_id, dict->vendors_id_len, &dict->lists_size.vendors_id, width, &realloc) != 0)
       return(TRAD_ENOMEM);
-   dict->vendors_id = ptr;
 
    // save vendor by name
    opts     = TINYRAD_ARRAY_INSERT;
-   width    = sizeof(TinyRadDictVendor *);
    compar   = &tinyrad_dict_vendor_cmp_obj_name;
    if ((rc = tinyrad_array_add((void **)&dict->vendors_name, &dict->vendors_name_len, width, &vendor, opts, compar, NULL, NULL)) < 0)
       return( (rc == -2) ? TRAD_ENOMEM : TRAD_EEXISTS);
@@ -668,13 +1253,285 @@ tinyrad_dict_add_vendor(
 }
 
 
+/// Reports whether lookups are served by the dictionary hash tables
+///
+/// @param[in]  dict          dictionary reference
+/// @return returns TRAD_YES or TRAD_NO
+static int
+__dict_is_hashed(
+         TinyRadDict *                dict )
+{
+   if ((dict->bulk))
+      return(TRAD_YES);
+   return(tinyrad_dict_is_readonly(dict));
+}
+
+
+/// Releases unused capacity of a dictionary list
+///
+/// Lists of read-only dictionaries are only appended to by bulk loads, which
+/// restore the capacity with tinyrad_dict_bulk_reserve() first.
+///
+/// @param[in]  listp         reference to list
+/// @param[in]  len           length of list
+/// @param[in]  sizep         reference to capacity of list
+static void
+__dict_list_shrink(
+         void ***                     listp,
+         size_t                       len,
+         size_t *                     sizep )
+{
+   void **     ptr;
+
+   if (!(len))
+   {
+      free(*listp);
+      *listp = NULL;
+      *sizep = 0;
+      return;
+   };
+
+   // a failed shrink leaves the larger list in place
+   if ((ptr = realloc(*listp, (sizeof(void *) * len))) != NULL)
+   {
+      *listp = ptr;
+      *sizep = len;
+   };
+
+   return;
+}
+
+
+/// Sorts objects appended to a dictionary list during a bulk load
+///
+/// Only the appended objects are sorted, and are then merged with the part of
+/// the list which was already sorted when the bulk load began.
+///
+/// @param[in]  list          list to sort
+/// @param[in]  sorted        number of objects already sorted
+/// @param[in]  len           length of list
+/// @param[in]  compar        object comparison function
+static void
+__dict_list_sort(
+         void **                      list,
+         size_t                       sorted,
+         size_t                       len,
+         int (*compar)(const void *, const void *) )
+{
+   unsigned    opts;
+
+   if (sorted >= len)
+      return;
+
+   // the list capacity was reserved when the objects were appended
+   opts = TINYRAD_ARRAY_MERGE | TINYRAD_ARRAY_LASTDUP;
+   if (tinyrad_array_add_many((void **)&list, &sorted, sizeof(void *), &list[sorted], (len - sorted), opts, compar, NULL, NULL) < 0)
+      qsort(list, len, sizeof(void *), compar);
+
+   return;
+}
+
+
+/// Appends object to a dictionary list during a bulk load
+///
+/// The object is indexed in the list's hash table so that lookups made while
+/// loading do not require the list to be sorted.  Room for the object must
+/// have been made by tinyrad_dict_bulk_grow(), so appending cannot fail.
+///
+/// @param[in]  listp         reference to list
+/// @param[in]  lenp          reference to length of list
+/// @param[in]  obj           object to append
+/// @param[in]  hash          hash table of list
+/// @param[in]  hval          hash value of object's key
+/// @param[in]  key           object's key
+/// @param[in]  compar        key comparison function
+void
+tinyrad_dict_bulk_add(
+         void ***                     listp,
+         size_t *                     lenp,
+         void *                       obj,
+         TinyRadDictHash *            hash,
+         uint64_t                     hval,
+         const void *                 key,
+         int (*compar)(const void *, const void *) )
+{
+   assert(listp != NULL);
+   assert(lenp  != NULL);
+   assert(obj   != NULL);
+   assert(hash  != NULL);
+
+   tinyrad_dict_hash_insert(hash, hval, obj, key, compar);
+
+   (*listp)[*lenp] = obj;
+   (*lenp)++;
+
+   return;
+}
+
+
+/// Makes room for one more object in a dictionary list during a bulk load
+///
+/// Lists are grown geometrically.  Both the list and its hash table are grown
+/// so that a following tinyrad_dict_bulk_add() cannot fail part way through.
+///
+/// @param[in]  listp         reference to list
+/// @param[in]  len           length of list
+/// @param[in]  sizep         reference to capacity of list
+/// @param[in]  hash          hash table of list
+/// @return returns error code
+int
+tinyrad_dict_bulk_grow(
+         void ***                     listp,
+         size_t                       len,
+         size_t *                     sizep,
+         TinyRadDictHash *            hash )
+{
+   size_t      size;
+   void **     ptr;
+
+   assert(listp != NULL);
+   assert(sizep != NULL);
+   assert(hash  != NULL);
+
+   if (len >= *sizep)
+   {
+      size = ((*sizep)) ? (*sizep * 2) : TRAD_DICT_BULK_MIN_SIZE;
+      if ((ptr = realloc(*listp, (sizeof(void *) * size))) == NULL)
+         return(TRAD_ENOMEM);
+      *listp = ptr;
+      *sizep = size;
+   };
+
+   return(tinyrad_dict_hash_grow(hash));
+}
+
+
+/// Starts bulk loading objects into dictionary
+///
+/// While bulk loading, objects are appended to the dictionary lists instead
+/// of being inserted in sorted order and lookups are answered by hash tables.
+/// The lists are sorted once by tinyrad_dict_bulk_end().  Calls may be nested.
+///
+/// @param[in]  dict          dictionary reference
+/// @return returns error code
+int
+tinyrad_dict_bulk_begin(
+         TinyRadDict *                dict )
+{
+   int         rc;
+
+   TinyRadDebugTrace();
+
+   assert(dict != NULL);
+
+   if ((dict->bulk))
+   {
+      dict->bulk++;
+      return(TRAD_SUCCESS);
+   };
+
+   if ( ((tinyrad_dict_bulk_reserve((void ***)&dict->attrs_name,   dict->attrs_name_len,   &dict->lists_size.attrs_name))   != TRAD_SUCCESS) ||
+        ((tinyrad_dict_bulk_reserve((void ***)&dict->attrs_type,   dict->attrs_type_len,   &dict->lists_size.attrs_type))   != TRAD_SUCCESS) ||
+        ((tinyrad_dict_bulk_reserve((void ***)&dict->values_data,  dict->values_data_len,  &dict->lists_size.values_data))  != TRAD_SUCCESS) ||
+        ((tinyrad_dict_bulk_reserve((void ***)&dict->values_name,  dict->values_name_len,  &dict->lists_size.values_name))  != TRAD_SUCCESS) ||
+        ((tinyrad_dict_bulk_reserve((void ***)&dict->vendors_id,   dict->vendors_id_len,   &dict->lists_size.vendors_id))   != TRAD_SUCCESS) ||
+        ((tinyrad_dict_bulk_reserve((void ***)&dict->vendors_name, dict->vendors_name_len, &dict->lists_size.vendors_name)) != TRAD_SUCCESS) )
+      return(TRAD_ENOMEM);
+
+   if ((rc = tinyrad_dict_hash_build(dict)) != TRAD_SUCCESS)
+      return(rc);
+
+   dict->bulk                      = 1;
+   dict->bulk_sorted.attrs_name    = dict->attrs_name_len;
+   dict->bulk_sorted.attrs_type    = dict->attrs_type_len;
+   dict->bulk_sorted.values_data   = dict->values_data_len;
+   dict->bulk_sorted.values_name   = dict->values_name_len;
+   dict->bulk_sorted.vendors_id    = dict->vendors_id_len;
+   dict->bulk_sorted.vendors_name  = dict->vendors_name_len;
+
+   return(TRAD_SUCCESS);
+}
+
+
+/// Finishes bulk loading objects into dictionary
+///
+/// Sorts the objects appended to each dictionary list once, merges them into
+/// the part of the list which was sorted when the bulk load began, and
+/// releases the hash tables used while loading.  Every list comparison
+/// function either breaks ties by definition order or is used by a list which
+/// rejects duplicates, so the sorted lists are identical to the lists built by
+/// inserting one object at a time.
+///
+/// @param[in]  dict          dictionary reference
+void
+tinyrad_dict_bulk_end(
+         TinyRadDict *                dict )
+{
+   TinyRadDebugTrace();
+
+   assert(dict       != NULL);
+   assert(dict->bulk  > 0);
+
+   if ((--dict->bulk))
+      return;
+
+   __dict_list_sort((void **)dict->attrs_name,   dict->bulk_sorted.attrs_name,   dict->attrs_name_len,   &tinyrad_dict_attr_cmp_obj_name);
+   __dict_list_sort((void **)dict->attrs_type,   dict->bulk_sorted.attrs_type,   dict->attrs_type_len,   &tinyrad_dict_attr_cmp_obj_type);
+   __dict_list_sort((void **)dict->values_data,  dict->bulk_sorted.values_data,  dict->values_data_len,  &tinyrad_dict_value_cmp_obj_data);
+   __dict_list_sort((void **)dict->values_name,  dict->bulk_sorted.values_name,  dict->values_name_len,  &tinyrad_dict_value_cmp_obj_name);
+   __dict_list_sort((void **)dict->vendors_id,   dict->bulk_sorted.vendors_id,   dict->vendors_id_len,   &tinyrad_dict_vendor_cmp_obj_id);
+   __dict_list_sort((void **)dict->vendors_name, dict->bulk_sorted.vendors_name, dict->vendors_name_len, &tinyrad_dict_vendor_cmp_obj_name);
+
+   tinyrad_dict_hash_free(&dict->attrs_name_hash);
+   tinyrad_dict_hash_free(&dict->attrs_type_hash);
+   tinyrad_dict_hash_free(&dict->values_data_hash);
+   tinyrad_dict_hash_free(&dict->values_name_hash);
+   tinyrad_dict_hash_free(&dict->vendors_id_hash);
+   tinyrad_dict_hash_free(&dict->vendors_name_hash);
+
+   tinyrad_dict_trie_free(dict->attrs_name_trie);
+   dict->attrs_name_trie = NULL;
+
+   return;
+}
+
+
+/// Sizes dictionary list to the capacity expected during a bulk load
+///
+/// @param[in]  listp         reference to list
+/// @param[in]  len           length of list
+/// @param[in]  sizep         reference to capacity of list
+/// @return returns error code
+int
+tinyrad_dict_bulk_reserve(
+         void ***                     listp,
+         size_t                       len,
+         size_t *                     sizep )
+{
+   size_t      size;
+   void **     ptr;
+
+   assert(listp != NULL);
+   assert(sizep != NULL);
+
+   for(size = TRAD_DICT_BULK_MIN_SIZE; (size < len); size <<= 1);
+   if ((ptr = realloc(*listp, (sizeof(void *) * size))) == NULL)
+      return(TRAD_ENOMEM);
+   *listp = ptr;
+   *sizep = size;
+
+   return(TRAD_SUCCESS);
+}
+
+
 int
 tinyrad_dict_defaults(
          TinyRadDict *                 dict,
          char ***                      msgsp,
          int                           opts )
 {
-   int      rc;
+   int         rc;
+   uint32_t    flags;
 
    if (!(dict))
       return(TRAD_SUCCESS);
@@ -683,12 +1540,34 @@ tinyrad_dict_defaults(
    opts &= ~(dict->opts_neg);
    opts |= dict->opts;
 
+   // load dictionary cache if it is current
+   if ( ((dict->cache_file)) && (!(dict->order_count)) )
+   {
+      flags = ((opts & TRAD_BUILTIN_DICT)) ? TRAD_BUILTIN_DICT_LOADED : 0;
+      switch(rc = tinyrad_dict_cache_import(dict, dict->cache_file, dict->default_dictfile, flags))
+      {
+         case TRAD_SUCCESS:
+         return(TRAD_SUCCESS);
+
+         // dictionary was not modified, fall back to source files
+         case TRAD_ECACHE:
+         case TRAD_EDICTRO:
+         case TRAD_ENOENT:
+         case TRAD_EACCES:
+         break;
+
+         default:
+         return(rc);
+      };
+   };
+
    // load built-in dictionary
    if ((opts & TRAD_BUILTIN_DICT))
       if ((rc = tinyrad_dict_builtin(dict, msgsp)) != TRAD_SUCCESS)
          return(rc);
 
    // load default dictionary file
+   rc = TRAD_SUCCESS;
    if ((dict->default_dictfile))
    {
       switch(rc = tinyrad_dict_parse(dict, dict->default_dictfile, NULL, 0))
@@ -705,6 +1584,10 @@ tinyrad_dict_defaults(
       };
    };
 
+   // update dictionary cache only from a complete parse (failures only cost startup time)
+   if ( ((dict->cache_file)) && (rc == TRAD_SUCCESS) )
+      tinyrad_dict_cache_save(dict, dict->cache_file);
+
    return(TRAD_SUCCESS);
 }
 
@@ -723,6 +1606,10 @@ tinyrad_dict_free(
    if (!(dict))
       return;
 
+   // release base dictionary of overlay
+   if ((dict->base))
+      tinyrad_obj_release(&dict->base->obj);
+
    // free attributes
    if ((dict->attrs_name))
    {
@@ -744,6 +1631,33 @@ tinyrad_dict_free(
    if ((dict->default_dictfile))
       free(dict->default_dictfile);
 
+   if ((dict->cache_file))
+      free(dict->cache_file);
+
+   // free source files
+   if ((dict->sources))
+   {
+      for(pos = 0; (pos < dict->sources_len); pos++)
+      {
+         free(dict->sources[pos].path);
+         free(dict->sources[pos].fullpath);
+      };
+      free(dict->sources);
+   };
+
+   // release string pool, objects retained by callers keep it alive
+   if ((dict->strpool))
+      tinyrad_obj_release(&dict->strpool->obj);
+
+   // free frozen hash tables
+   tinyrad_dict_hash_free(&dict->attrs_name_hash);
+   tinyrad_dict_hash_free(&dict->attrs_type_hash);
+   tinyrad_dict_hash_free(&dict->values_data_hash);
+   tinyrad_dict_hash_free(&dict->values_name_hash);
+   tinyrad_dict_hash_free(&dict->vendors_id_hash);
+   tinyrad_dict_hash_free(&dict->vendors_name_hash);
+   tinyrad_dict_trie_free(dict->attrs_name_trie);
+
    // free values
    if ((dict->values_data))
    {
@@ -772,6 +1686,9 @@ tinyrad_dict_free(
       free(dict->vendors_id);
    };
 
+   if ((dict->blocks_lock_init))
+      pthread_rwlock_destroy(&dict->blocks_lock);
+
    memset(dict, 0, sizeof(TinyRadDict));
    free(dict);
 
@@ -779,6 +1696,48 @@ tinyrad_dict_free(
 }
 
 
+/// Compiles hash tables and vendor indexes used by a read-only dictionary
+///
+/// @param[in]  dict          dictionary reference
+/// @return returns error code
+int
+tinyrad_dict_freeze(
+         TinyRadDict *                dict )
+{
+   int                  rc;
+   size_t               pos;
+
+   TinyRadDebugTrace();
+
+   assert(dict       != NULL);
+   assert(dict->bulk == 0);
+
+   if ((rc = tinyrad_dict_hash_build(dict)) != TRAD_SUCCESS)
+      return(rc);
+
+   if ((rc = tinyrad_dict_trie_build(dict)) != TRAD_SUCCESS)
+      return(rc);
+
+   for(pos = 0; (pos < dict->vendors_id_len); pos++)
+      if (tinyrad_dict_vendor_index(dict, dict->vendors_id[pos]) != TRAD_SUCCESS)
+         return(TRAD_ENOMEM);
+
+   for(pos = 0; (pos < dict->attrs_type_len); pos++)
+      if (tinyrad_dict_attr_index_values(dict, dict->attrs_type[pos]) != TRAD_SUCCESS)
+         return(TRAD_ENOMEM);
+
+   // lists no longer grow one object at a time
+   __dict_list_shrink((void ***)&dict->attrs_name,   dict->attrs_name_len,   &dict->lists_size.attrs_name);
+   __dict_list_shrink((void ***)&dict->attrs_type,   dict->attrs_type_len,   &dict->lists_size.attrs_type);
+   __dict_list_shrink((void ***)&dict->values_data,  dict->values_data_len,  &dict->lists_size.values_data);
+   __dict_list_shrink((void ***)&dict->values_name,  dict->values_name_len,  &dict->lists_size.values_name);
+   __dict_list_shrink((void ***)&dict->vendors_id,   dict->vendors_id_len,   &dict->lists_size.vendors_id);
+   __dict_list_shrink((void ***)&dict->vendors_name, dict->vendors_name_len, &dict->lists_size.vendors_name);
+
+   return(TRAD_SUCCESS);
+}
+
+
 int
 tinyrad_dict_get_option(
          TinyRadDict *                 dict,
@@ -823,6 +1782,11 @@ tinyrad_dict_get_option(
       *((unsigned *)outvalue) = uval;
       break;
 
+      case TRAD_DICT_OPT_STATS:
+      TinyRadDebug(TRAD_DEBUG_ARGS, "   == %s( dict, TRAD_DICT_OPT_STATS, outvalue )", __func__);
+      tinyrad_dict_stats(dict, outvalue);
+      break;
+
       default:
       return(TRAD_EOPTERR);
    };
@@ -852,6 +1816,12 @@ tinyrad_dict_initialize(
       return(TRAD_ENOMEM);
    dict->opts = opts;
 
+   if ((dict->strpool = tinyrad_dict_strpool_alloc()) == NULL)
+   {
+      tinyrad_dict_free(dict);
+      return(TRAD_ENOMEM);
+   };
+
    // initializes read-only flag
    atomic_init(&dict->readonly, TRAD_NO);
 
@@ -875,47 +1845,107 @@ tinyrad_dict_initialize(
 }
 
 
+/// Initializes an overlay dictionary which extends a read-only dictionary
+///
+/// Lookups search the overlay before falling through to the base
+/// dictionary, definitions added to the overlay are not visible to the
+/// base dictionary or to other overlays sharing the base.
+///
+/// @param[in]  base          read-only dictionary reference
+/// @param[out] dictp         pointer to dictionary reference
+/// @return returns error code
 int
-tinyrad_dict_is_readonly(
-         TinyRadDict *                dict )
-{
-   assert(dict != NULL);
-   return((atomic_fetch_add(&dict->readonly, 0) == TRAD_NO) ? TRAD_NO : TRAD_YES);
-}
-
-
-int
-tinyrad_dict_set_option(
-         TinyRadDict *                 dict,
-         int                           option,
-         const void *                  invalue )
+tinyrad_dict_initialize_overlay(
+         TinyRadDict *                base,
+         TinyRadDict **               dictp )
 {
-   int                  rc;
-   char **              strs;
+   int               rc;
+   TinyRadDict *     dict;
 
    TinyRadDebugTrace();
 
-   assert(dict    != NULL);
-   assert(invalue != NULL);
+   assert(base  != NULL);
+   assert(dictp != NULL);
 
-   if (tinyrad_dict_is_readonly(dict) == TRAD_YES)
-      return(TRAD_EDICTRO);
+   if (tinyrad_dict_is_readonly(base) != TRAD_YES)
+      return(TRAD_EINVAL);
 
-   // set instance options
-   switch(option)
+   if ((dict = tinyrad_obj_alloc(sizeof(TinyRadDict), (void(*)(void*))&tinyrad_dict_free)) == NULL)
+      return(TRAD_ENOMEM);
+   dict->opts        = base->opts;
+   dict->opts_neg    = base->opts_neg;
+   dict->order_count = base->order_count;
+   dict->base        = tinyrad_obj_retain(&base->obj);
+
+   if ((dict->strpool = tinyrad_dict_strpool_alloc()) == NULL)
    {
-      case TRAD_DICT_OPT_PATHS:
-      TinyRadDebug(TRAD_DEBUG_ARGS, "   == %s( dict, TRAD_DICT_OPT_PATHS, invalue )", __func__);
-      if ((rc = tinyrad_strsdup(&strs, (char * const *)invalue)) != TRAD_SUCCESS)
-         return(rc);
-      tinyrad_strsfree(dict->paths);
+      tinyrad_dict_free(dict);
+      return(TRAD_ENOMEM);
+   };
+
+   // initializes read-only flag
+   atomic_init(&dict->readonly, TRAD_NO);
+
+   // inherit search paths of base dictionary
+   if ((base->paths))
+   {
+      if ((rc = tinyrad_strsdup(&dict->paths, base->paths)) != TRAD_SUCCESS)
+      {
+         tinyrad_dict_free(dict);
+         return(rc);
+      };
+   };
+
+   *dictp = tinyrad_obj_retain(&dict->obj);
+
+   return(TRAD_SUCCESS);
+}
+
+
+int
+tinyrad_dict_is_readonly(
+         TinyRadDict *                dict )
+{
+   assert(dict != NULL);
+   return((atomic_load(&dict->readonly) == TRAD_NO) ? TRAD_NO : TRAD_YES);
+}
+
+
+int
+tinyrad_dict_set_option(
+         TinyRadDict *                 dict,
+         int                           option,
+         const void *                  invalue )
+{
+   int                  rc;
+   char **              strs;
+
+   TinyRadDebugTrace();
+
+   assert(dict    != NULL);
+   assert(invalue != NULL);
+
+   if (tinyrad_dict_is_readonly(dict) == TRAD_YES)
+      return(TRAD_EDICTRO);
+
+   // set instance options
+   switch(option)
+   {
+      case TRAD_DICT_OPT_PATHS:
+      TinyRadDebug(TRAD_DEBUG_ARGS, "   == %s( dict, TRAD_DICT_OPT_PATHS, invalue )", __func__);
+      if ((rc = tinyrad_strsdup(&strs, (char * const *)invalue)) != TRAD_SUCCESS)
+         return(rc);
+      tinyrad_strsfree(dict->paths);
       dict->paths = strs;
       break;
 
       case TRAD_DICT_OPT_READONLY:
       TinyRadDebug(TRAD_DEBUG_ARGS, "   == %s( dict, TRAD_DICT_OPT_READONLY, %s )", __func__, ( (*((const int*)invalue) != TRAD_NO) ? "TRAD_YES" : "TRAD_NO" ) );
-      if (*((const int*)invalue) != TRAD_NO)
-         atomic_fetch_add(&dict->readonly, TRAD_YES);
+      if (*((const int*)invalue) == TRAD_NO)
+         break;
+      if ((rc = tinyrad_dict_freeze(dict)) != TRAD_SUCCESS)
+         return(rc);
+      atomic_fetch_add(&dict->readonly, TRAD_YES);
       break;
 
       default:
@@ -942,6 +1972,24 @@ __attr_len_octs(
 }
 
 
+static int
+__attr_prefix_add(
+         void *                        obj,
+         void *                        ctx )
+{
+   return(tinyrad_strsadd(ctx, ((TinyRadDictAttr *)obj)->name));
+}
+
+
+static int
+__attr_prefix_cmp(
+         const void *                  a,
+         const void *                  b )
+{
+   return(strcasecmp(*((char * const *)a), *((char * const *)b)));
+}
+
+
 static uint32_t
 __attr_type(
          const TinyRadDictAttr *       attr )
@@ -1003,11 +2051,12 @@ tinyrad_dict_attr_alloc(
       return(NULL);
    };
 
-   if ((attr->name = tinyrad_strdup(name)) == NULL)
+   if ((attr->name = tinyrad_dict_strpool_intern(dict->strpool, name)) == NULL)
    {
       tinyrad_dict_attr_free(attr);
       return(NULL);
    };
+   attr->strpool = tinyrad_obj_retain(&dict->strpool->obj);
 
    dict->order_count++;
    attr->order       = dict->order_count;
@@ -1076,6 +2125,23 @@ tinyrad_dict_attr_cmp_key_vendor(
 }
 
 
+int
+tinyrad_dict_attr_cmp_key_vendor_type(
+         const void *                 ptr,
+         const void *                 key )
+{
+   const TinyRadDictAttr * const *     obj = ptr;
+   const uint32_t *                    dat = key;
+   uint32_t                            vendor_type;
+
+   vendor_type = tinyrad_oid_vendor_type((*obj)->oid);
+   if (vendor_type != *dat)
+      return( (vendor_type < *dat) ? -1 : 1 );
+
+   return(0);
+}
+
+
 int
 tinyrad_dict_attr_cmp_obj_name(
          const void *                 a,
@@ -1084,7 +2150,8 @@ tinyrad_dict_attr_cmp_obj_name(
    const TinyRadDictAttr * const * x = a;
    const TinyRadDictAttr * const * y = b;
 
-   if ( (!((*x)->name)) && (!((*y)->name)) )
+   // interned names are shared, so identical pointers are identical names
+   if ((*x)->name == (*y)->name)
       return(0);
 
    if (!((*x)->name))
@@ -1136,12 +2203,15 @@ tinyrad_dict_attr_free(
    if ((attr->vendor))
       tinyrad_obj_release(&attr->vendor->obj);
 
-   if ((attr->name))
-      free(attr->name);
+   if ((attr->strpool))
+      tinyrad_obj_release(&attr->strpool->obj);
 
    if ((attr->oid))
       tinyrad_free(attr->oid);
 
+   if ((attr->values))
+      free(attr->values);
+
    memset(attr, 0, sizeof(TinyRadDictAttr));
    free(attr);
 
@@ -1158,10 +2228,26 @@ tinyrad_dict_attr_get(
          uint32_t                      vendor_id,
          uint32_t                      vendor_type )
 {
+   uint64_t          probes;
+   TinyRadDict *     next;
    TinyRadDictAttr * attr;
    TinyRadOID        oid;
    TinyRadDebugTrace();
    assert(dict   != NULL);
+   probes = tinyrad_dict_probes;
+   if ( (!(name)) && (!(vendor)) && (!(vendor_id)) )
+   {
+      for(attr = NULL, next = dict; ( ((next)) && (!(attr)) ); next = next->base)
+         attr = next->attrs_std[type];
+      __dict_stats_lookup(dict, attr, probes);
+      return(tinyrad_obj_retain(&attr->obj));
+   };
+   if ( (!(name)) && ((vendor)) && (type == TRAD_ATTR_VENDOR_SPECIFIC) && (!(dict->base)) && (tinyrad_dict_is_readonly(dict) == TRAD_YES) )
+   {
+      attr = tinyrad_dict_vendor_attr_lookup(vendor, vendor_type);
+      __dict_stats_lookup(dict, attr, probes);
+      return(tinyrad_obj_retain(&attr->obj));
+   };
    memset(&oid, 0, sizeof(oid));
    oid.oid_val[0] = type;
    oid.oid_val[1] = ((vendor))         ? vendor->id  : vendor_id;
@@ -1179,44 +2265,85 @@ tinyrad_dict_attr_index(
          TinyRadOID *                 oid,
          int                          by_vendor )
 {
-   size_t               width;
-   size_t               len;
-   unsigned             opts;
-   const void *         key;
    uint32_t             vendor_id;
-   TinyRadDictAttr **   list;
-   int (*compar)(const void *, const void *);
 
    TinyRadDebugTrace();
 
    assert(dict != NULL);
    assert((by_vendor == TRAD_NO) || (by_vendor == TRAD_YES));
 
-   width = sizeof(TinyRadDictAttr *);
-
    if ((name))
+      return(tinyrad_dict_attr_search_name(dict->attrs_name, dict->attrs_name_len, name, TINYRAD_ARRAY_LASTDUP));
+
+   if (by_vendor == TRAD_NO)
+      return(tinyrad_dict_attr_search_type(dict->attrs_type, dict->attrs_type_len, oid, TINYRAD_ARRAY_LASTDUP));
+
+   vendor_id = tinyrad_oid_vendor_id(oid);
+   return(tinyrad_dict_attr_search_vendor(dict->attrs_type, dict->attrs_type_len, &vendor_id, TINYRAD_ARRAY_FIRSTDUP));
+}
+
+
+/// Builds index of attribute's values keyed by value data
+///
+/// Attributes whose value data is small, or densely packed, are indexed
+/// with an array addressed by data.  Values are read from the sorted list
+/// of values by data, so the last duplicate of a value's data wins.  Values
+/// added by an overlay to attributes of its base dictionary are not indexed.
+///
+/// @param[in]  dict          dictionary reference
+/// @param[in]  attr          dictionary attribute reference
+/// @return returns error code
+int
+tinyrad_dict_attr_index_values(
+         TinyRadDict *                dict,
+         TinyRadDictAttr *            attr )
+{
+   ssize_t              idx;
+   size_t               pos;
+   size_t               len;
+   uint64_t             max;
+   TinyRadDictValue *   value;
+
+   TinyRadDebugTrace();
+
+   assert(dict != NULL);
+   assert(attr != NULL);
+
+   // discard index built by previous freeze
+   if ((attr->values))
+      free(attr->values);
+   attr->values      = NULL;
+   attr->values_len  = 0;
+
+   if (attr->strpool != dict->strpool)
+      return(TRAD_SUCCESS);
+   if ((idx = tinyrad_dict_value_index(dict, NULL, attr->oid, 0, TRAD_YES)) < 0)
+      return(TRAD_SUCCESS);
+
+   // determine range of attribute's values
+   max = 0;
+   for(pos = (size_t)idx; (pos < dict->values_data_len); pos++)
    {
-      key      = name;
-      len      = dict->attrs_name_len;
-      list     = dict->attrs_name;
-      compar   = &tinyrad_dict_attr_cmp_key_name;
-      opts     = TINYRAD_ARRAY_LASTDUP;
-   } else if (by_vendor == TRAD_NO) {
-      key      = &oid;
-      len      = dict->attrs_type_len;
-      list     = dict->attrs_type;
-      opts     = TINYRAD_ARRAY_LASTDUP;
-      compar   = &tinyrad_dict_attr_cmp_key_type;
-   } else {
-      vendor_id = tinyrad_oid_vendor_id(oid);
-      key      = &vendor_id;
-      len      = dict->attrs_type_len;
-      list     = dict->attrs_type;
-      opts     = TINYRAD_ARRAY_FIRSTDUP;
-      compar   = &tinyrad_dict_attr_cmp_key_vendor;
+      value = dict->values_data[pos];
+      if ((tinyrad_oid_cmp(&value->attr->oid, &attr->oid)))
+         break;
+      max = (value->data > max) ? value->data : max;
+   };
+   len = pos;
+   if ( (max >= TRAD_DICT_VALUE_DENSE_MAX) && (max >= ((len - (size_t)idx) * 4)) )
+      return(TRAD_SUCCESS);
+
+   // populate dense index
+   if ((attr->values = calloc((size_t)max + 1, sizeof(TinyRadDictValue *))) == NULL)
+      return(TRAD_ENOMEM);
+   attr->values_len = (size_t)max + 1;
+   for(pos = (size_t)idx; (pos < len); pos++)
+   {
+      value = dict->values_data[pos];
+      attr->values[value->data] = value;
    };
 
-   return(tinyrad_array_search(list, len, width, key, opts, NULL, compar));
+   return(TRAD_SUCCESS);
 }
 
 
@@ -1313,37 +2440,88 @@ tinyrad_dict_attr_lookup(
          const char *                  name,
          const TinyRadOID *            oid )
 {
-   size_t               width;
-   size_t               len;
-   unsigned             opts;
-   const void *         key;
-   TinyRadDictAttr **   list;
-   TinyRadDictAttr **   res;
-   int (*compar)(const void *, const void *);
+   uint64_t             probes;
+   TinyRadDict *        next;
+   TinyRadDictAttr *    attr;
 
    TinyRadDebugTrace();
 
    assert(dict   != NULL);
    assert( ((name)) || ((oid)) );
 
-   width = sizeof(TinyRadDictAttr *);
-   opts     = TINYRAD_ARRAY_LASTDUP;
+   probes = tinyrad_dict_probes;
+   attr   = NULL;
+
+   // search overlays before base dictionaries
+   for(next = dict; ( ((next)) && (!(attr)) ); next = next->base)
+   {
+      if (__dict_blocks_pending(next) == TRAD_NO)
+      {
+         attr = tinyrad_dict_attr_lookup_local(next, name, oid);
+         continue;
+      };
+
+      // vendor specific attributes are defined by blocks of their vendor
+      if ( (!(name)) && (oid->oid_len == 3) && (oid->oid_val[0] == TRAD_ATTR_VENDOR_SPECIFIC) )
+         tinyrad_dict_blocks_vendor(next, NULL, oid->oid_val[1]);
+
+      pthread_rwlock_rdlock(&next->blocks_lock);
+      attr = tinyrad_dict_attr_lookup_local(next, name, oid);
+      pthread_rwlock_unlock(&next->blocks_lock);
+
+      // attribute names may be defined by any deferred block
+      if ( (!(attr)) && ((name)) && (tinyrad_dict_blocks_load(next, NULL) == TRAD_SUCCESS) )
+         attr = tinyrad_dict_attr_lookup_local(next, name, oid);
+   };
+
+   __dict_stats_lookup(dict, attr, probes);
+
+   return(attr);
+}
+
+
+static TinyRadDictAttr *
+tinyrad_dict_attr_lookup_local(
+         TinyRadDict *                 dict,
+         const char *                  name,
+         const TinyRadOID *            oid )
+{
+   ssize_t              idx;
+   TinyRadDictVendor *  vendor;
+
+   TinyRadDebugTrace();
+
+   assert(dict   != NULL);
+   assert( ((name)) || ((oid)) );
+
+   // standard attributes are direct-indexed by type
+   if ( (!(name)) && (oid->oid_len == 1) && (oid->oid_val[0] < TRAD_DICT_STD_ATTRS) )
+      return(dict->attrs_std[oid->oid_val[0]]);
+
+   // probe hash tables of frozen or bulk loading dictionary
+   if (__dict_is_hashed(dict) == TRAD_YES)
+   {
+      if ((name))
+         return(tinyrad_dict_hash_lookup(&dict->attrs_name_hash, __hash_str(TRAD_DICT_HASH_SEED, name), name, &tinyrad_dict_attr_cmp_key_name));
+      if ( (!(dict->bulk)) && (oid->oid_len == 3) && (oid->oid_val[0] == TRAD_ATTR_VENDOR_SPECIFIC) )
+      {
+         // attributes of vendors defined by a base dictionary are not indexed by vendor
+         if ((vendor = tinyrad_dict_vendor_lookup_local(dict, NULL, oid->oid_val[1])) != NULL)
+            return(tinyrad_dict_vendor_attr_lookup(vendor, oid->oid_val[2]));
+         if (!(dict->base))
+            return(NULL);
+      };
+      return(tinyrad_dict_hash_lookup(&dict->attrs_type_hash, __hash_oid(TRAD_DICT_HASH_SEED, oid), oid, &tinyrad_dict_attr_cmp_key_type));
+   };
 
    if ((name))
    {
-      key      = name;
-      len      = dict->attrs_name_len;
-      list     = dict->attrs_name;
-      compar   = &tinyrad_dict_attr_cmp_key_name;
-   } else {
-      key      = oid;
-      len      = dict->attrs_type_len;
-      list     = dict->attrs_type;
-      compar   = &tinyrad_dict_attr_cmp_key_type;
+      idx = tinyrad_dict_attr_search_name(dict->attrs_name, dict->attrs_name_len, name, TINYRAD_ARRAY_LASTDUP);
+      return( (idx >= 0) ? dict->attrs_name[idx] : NULL);
    };
 
-   res = tinyrad_array_get(list, len, width, key, opts, compar);
-   return( ((res)) ? *res : NULL);
+   idx = tinyrad_dict_attr_search_type(dict->attrs_type, dict->attrs_type_len, oid, TINYRAD_ARRAY_LASTDUP);
+   return( (idx >= 0) ? dict->attrs_type[idx] : NULL);
 }
 
 
@@ -1372,332 +2550,1117 @@ tinyrad_dict_attr_oidname(
 }
 
 
-//-----------------------------//
-// dictionary import functions //
-//-----------------------------//
-#pragma mark dictionary import functions
-
-int
-tinyrad_dict_builtin(
-         TinyRadDict *                 dict,
-         char ***                      msgsp )
-{
-   int rc;
-   TinyRadDebugTrace();
-   assert(dict != NULL);
-   if (tinyrad_dict_is_readonly(dict) == TRAD_YES)
-      return(TRAD_EDICTRO);
-   if ((dict->opts & TRAD_BUILTIN_DICT_LOADED))
-      return(TRAD_SUCCESS);
-   if ((rc = tinyrad_dict_import(dict, tinyrad_dict_default_vendors, tinyrad_dict_default_attrs, tinyrad_dict_default_values, msgsp)) != TRAD_SUCCESS)
-      return(rc);
-   dict->opts |= TRAD_BUILTIN_DICT_LOADED;
-   return(TRAD_SUCCESS);
-}
-
-
+/// Retrieves names of attributes beginning with prefix
+///
+/// Names are compared without regard to case and are returned in sorted
+/// order, which allows callers to complete partial names or to detect
+/// ambiguous abbreviations.
+///
+/// @param[in]  dict          dictionary reference
+/// @param[in]  prefix        leading characters of attribute names
+/// @param[out] namesp        NULL terminated list of names, or NULL if none
+/// @return returns error code
 int
-tinyrad_dict_import(
+tinyrad_dict_attr_prefix(
          TinyRadDict *                 dict,
-         const TinyRadDictVendorDef *  vendor_defs,
-         const TinyRadDictAttrDef *    attr_defs,
-         const TinyRadDictValueDef *   value_defs,
-         char ***                      msgsp )
+         const char *                  prefix,
+         char ***                      namesp )
 {
    int                     rc;
    size_t                  pos;
-   uint8_t                 type;
-   uint8_t                 data_type;
-   uint32_t                flags;
-   uint64_t                data;
-   uint32_t                vendor_id;
-   uint8_t                 type_octs;
-   uint8_t                 len_octs;
-   const char *            attr_name;
-   const char *            value_name;
-   const char *            vendor_name;
-   TinyRadDictValue *      value;
-   TinyRadDictVendor *     vendor;
+   size_t                  len;
+   size_t                  count;
+   char **                 names;
+   TinyRadDict *           next;
    TinyRadDictAttr *       attr;
-   TinyRadOID              oid;
+   const TinyRadDictTrie * node;
 
    TinyRadDebugTrace();
 
-   assert(dict != NULL);
-
-   if ((msgsp))
-      *msgsp = NULL;
+   assert(dict   != NULL);
+   assert(prefix != NULL);
+   assert(namesp != NULL);
 
-   if (tinyrad_dict_is_readonly(dict) == TRAD_YES)
-      return(TRAD_EDICTRO);
+   names = NULL;
+   len   = strlen(prefix);
 
-   if ((vendor_defs))
+   for(next = dict; ((next)); next = next->base)
    {
-      for(pos = 0; ((vendor_defs[pos].name)); pos++)
+      // attribute names may be defined by any deferred block
+      if (__dict_blocks_pending(next) == TRAD_YES)
       {
-         vendor_name = vendor_defs[pos].name;
-         vendor_id   = (uint32_t)vendor_defs[pos].vendor_id;
-         type_octs   = (uint8_t)vendor_defs[pos].vendor_type_octs;
-         len_octs    = (uint8_t)vendor_defs[pos].vendor_len_octs;
-         if ((vendor = tinyrad_dict_vendor_alloc(dict, vendor_name, vendor_id, type_octs, len_octs)) == NULL)
-            return(tinyrad_error_msgs(TRAD_ENOMEM, msgsp, "out of virtual memory"));
-         rc = tinyrad_dict_add_vendor(dict, vendor);
-         tinyrad_obj_release(&vendor->obj);
-         if (rc != TRAD_SUCCESS)
-            return(tinyrad_error_msgs(rc, msgsp, "default attribute %s(%" PRIu32 "): ", vendor_name, vendor_id));
+         if ((rc = tinyrad_dict_blocks_load(next, NULL)) != TRAD_SUCCESS)
+         {
+            tinyrad_strsfree(names);
+            return(rc);
+         };
       };
-   };
 
-   if ((attr_defs))
-   {
-      for(pos = 0; ((attr_defs[pos].name)); pos++)
+      rc = TRAD_SUCCESS;
+      if ((next->attrs_name_trie))
       {
-         attr_name       = attr_defs[pos].name;
-         type            = (uint8_t)attr_defs[pos].type;
-         data_type       = (uint8_t)attr_defs[pos].data_type;
-         flags           = (uint32_t)attr_defs[pos].flags;
-         oid.oid_len     = ((attr_defs[pos].vendor_id)) ? 3 : 1;
-         oid.oid_val[0]  = (uint32_t)attr_defs[pos].type;
-         oid.oid_val[1]  = (uint32_t)attr_defs[pos].vendor_id;
-         oid.oid_val[2]  = (uint32_t)attr_defs[pos].vendor_type;
-         if ((attr = tinyrad_dict_attr_alloc(dict, attr_name, &oid, data_type, flags)) == NULL)
-            return(tinyrad_error_msgs(TRAD_ENOMEM, msgsp, "out of virtual memory"));
-         rc = tinyrad_dict_add_attr(dict, attr);
-         tinyrad_obj_release(&attr->obj);
-         if (rc != TRAD_SUCCESS)
-            return(tinyrad_error_msgs(rc, msgsp, "default attribute %s(%" PRIu32 "): ", attr_name, type));
+         if ((node = tinyrad_dict_trie_find(next->attrs_name_trie, prefix, TRAD_YES)) != NULL)
+            rc = tinyrad_dict_trie_walk(node, &__attr_prefix_add, &names);
+      } else {
+         for(pos = 0; ( (pos < next->attrs_name_len) && (rc == TRAD_SUCCESS) ); pos++)
+         {
+            attr = next->attrs_name[pos];
+            if ( ((attr->name)) && (!(strncasecmp(attr->name, prefix, len))) )
+               rc = tinyrad_strsadd(&names, attr->name);
+         };
+      };
+      if (rc != TRAD_SUCCESS)
+      {
+         tinyrad_strsfree(names);
+         return(rc);
       };
    };
 
-   if ((value_defs))
+   // overlays may redefine names found in base dictionaries
+   if ( ((dict->base)) && ((names)) )
    {
-      attr = NULL;
-      for(pos = 0; ((value_defs[pos].attr_name)); pos++)
+      count = tinyrad_strscount(names);
+      qsort(names, count, sizeof(char *), &__attr_prefix_cmp);
+      for(pos = 1, len = 1; (pos < count); pos++)
       {
-         attr_name  = value_defs[pos].attr_name;
-         value_name = value_defs[pos].value_name;
-         data       = value_defs[pos].data;
-         if ((attr))
-            if ((strcasecmp(attr_name, attr->name)))
-               attr = NULL;
-         if (!(attr))
-            attr = tinyrad_dict_attr_lookup(dict, attr_name, NULL);
-         if (!(attr))
-            return(tinyrad_error_msgs(TRAD_ENOENT, msgsp, "default value: %s %s(%" PRIu64 "): ", attr_name, value_name, data));
-         if ((value = tinyrad_dict_value_alloc(dict, attr, value_name, data)) == NULL)
-            return(tinyrad_error_msgs(TRAD_ENOMEM, msgsp, "out of virtual memory"));
-         rc = tinyrad_dict_add_value(dict,attr, value);
-         tinyrad_obj_release(&value->obj);
-         if (rc != TRAD_SUCCESS)
-            return(tinyrad_error_msgs(rc, msgsp, "default value: %s %s(%" PRIu64 "): ", attr_name, value_name, data));
+         if (!(strcasecmp(names[len-1], names[pos])))
+            free(names[pos]);
+         else
+            names[len++] = names[pos];
       };
+      names[len] = NULL;
    };
 
+   *namesp = names;
+
    return(TRAD_SUCCESS);
 }
 
 
+/// Searches sorted attribute lists without indirect comparator calls
+TINYRAD_ARRAY_SEARCH_FUNC(static, tinyrad_dict_attr_search_name,   TinyRadDictAttr *, const char *,       tinyrad_dict_attr_cmp_key_name)
+TINYRAD_ARRAY_SEARCH_FUNC(static, tinyrad_dict_attr_search_type,   TinyRadDictAttr *, const TinyRadOID *, tinyrad_dict_attr_cmp_key_type)
+TINYRAD_ARRAY_SEARCH_FUNC(static, tinyrad_dict_attr_search_vendor, TinyRadDictAttr *, const uint32_t *,   tinyrad_dict_attr_cmp_key_vendor)
+
+
 //----------------------------//
-// dictionary parse functions //
+// dictionary block functions //
 //----------------------------//
-#pragma mark dictionary parse functions
+#pragma mark dictionary block functions
 
-/// Imports file into dictionary
+/// Reports whether lookups must wait on deferred vendor blocks
+///
+/// The thread parsing the dictionary, or parsing its deferred blocks,
+/// already has exclusive access to the dictionary.
 ///
 /// @param[in]  dict          dictionary reference
-/// @param[in]  path          path to import file
-/// @param[out] msgsp         pointer to generated error details
-/// @param[in]  opts          import options
+/// @return returns TRAD_YES or TRAD_NO
+static int
+__dict_blocks_pending(
+         TinyRadDict *                dict )
+{
+   if (!(atomic_load(&dict->blocks_pending)))
+      return(TRAD_NO);
+   return( (tinyrad_dict_blocks_owner == dict) ? TRAD_NO : TRAD_YES );
+}
+
+
+/// Records vendor block to be parsed the first time the vendor is used
+///
+/// @param[in]  dict          dictionary reference
+/// @param[in]  vendor        vendor named by BEGIN-VENDOR
+/// @param[in]  file          file containing vendor block
+/// @param[in]  offset        offset of line following BEGIN-VENDOR
+/// @param[in]  line          line number of BEGIN-VENDOR
 /// @return returns error code
-int
-tinyrad_dict_parse(
+static int
+tinyrad_dict_blocks_add(
          TinyRadDict *                dict,
-         const char *                 path,
-         char ***                     msgsp,
-         uint32_t                     opts )
+         TinyRadDictVendor *          vendor,
+         TinyRadFile *                file,
+         off_t                        offset,
+         int                          line )
 {
-   int                   rc;
-   int                   argc;
-   char **               argv;
-   char                  buff[TRAD_LINE_MAX_LEN];
-   size_t                len;
-   TinyRadFile *         file;
-   TinyRadFile *         parent;
-   TinyRadDictVendor *   vendor;
+   struct stat          sb;
+   TinyRadDictBlock *   block;
+   TinyRadDictBlock **  blockp;
 
    TinyRadDebugTrace();
 
-   assert(dict != NULL);
-   assert(path != NULL);
-
-   if ((msgsp))
-      *msgsp = NULL;
+   assert(dict   != NULL);
+   assert(vendor != NULL);
+   assert(file   != NULL);
 
-   vendor = NULL;
+   if (fstat(file->fd, &sb) == -1)
+      return(TRAD_EACCES);
 
-   if (tinyrad_dict_is_readonly(dict) == TRAD_YES)
-      return(TRAD_EDICTRO);
+   if (!(dict->blocks_lock_init))
+   {
+      if (pthread_rwlock_init(&dict->blocks_lock, NULL) != 0)
+         return(TRAD_ENOMEM);
+      dict->blocks_lock_init = 1;
+   };
 
-   // initialize file buffer
-   if ((rc = tinyrad_file_init(&file, path, dict->paths, NULL)) != TRAD_SUCCESS)
+   if ((block = calloc(1, sizeof(TinyRadDictBlock))) == NULL)
+      return(TRAD_ENOMEM);
+   if ((block->fullpath = tinyrad_strdup(file->fullpath)) == NULL)
    {
-      tinyrad_file_error(file, rc, msgsp);
-      tinyrad_file_destroy(file, TRAD_FILE_RECURSE);
-      return(rc);
+      free(block);
+      return(TRAD_ENOMEM);
    };
+   block->mtime       = (int64_t)sb.st_mtime;
+   block->mtime_nsec  = (uint32_t)sb.st_mtim.tv_nsec;
+   block->size        = (int64_t)sb.st_size;
+   block->offset      = offset;
+   block->line        = line;
 
-   // loops through dictionary file
-   while((file))
+   // blocks of a vendor are parsed in the order they were defined
+   for(blockp = &vendor->blocks; ((*blockp)); blockp = &(*blockp)->next);
+   *blockp = block;
+
+   atomic_fetch_add(&dict->blocks_pending, 1);
+
+   return(TRAD_SUCCESS);
+}
+
+
+/// Frees list of deferred vendor blocks
+///
+/// @param[in]  block         first block in list
+static void
+tinyrad_dict_blocks_free(
+         TinyRadDictBlock *           block )
+{
+   TinyRadDictBlock *   next;
+
+   for(; ((block)); block = next)
    {
-      // reads next line
-      if ((rc = tinyrad_readline(file->fd, buff, sizeof(buff), &len)) < 0)
-      {
-         tinyrad_file_error(file, rc, msgsp);
-         tinyrad_file_destroy(file, TRAD_FILE_RECURSE);
-         return(rc);
-      };
-      file->line++;
-      if (len == 0)
-      {
-         parent = file->parent;
-         tinyrad_file_destroy(file, TRAD_FILE_NORECURSE);
-         file = parent;
-         continue;
-      };
-      if ((rc = tinyrad_strtoargs(buff, &argv, &argc)) != TRAD_SUCCESS)
-      {
-         tinyrad_file_error(file, rc, msgsp);
-         tinyrad_file_destroy(file, TRAD_FILE_RECURSE);
-         return(rc);
-      };
-      if (argc < 1)
-      {
-         tinyrad_strsfree(argv);
-         continue;
-      };
+      next = block->next;
+      if ((block->fullpath))
+         free(block->fullpath);
+      free(block);
+   };
 
-      // perform requested action
-      switch(tinyrad_map_lookup_name(tinyrad_dict_options, argv[0], NULL))
-      {
-         case TRAD_DICT_KEYWORD_ATTRIBUTE:
-         if ((rc = tinyrad_dict_parse_attribute(dict, argc, argv, vendor, opts)) != TRAD_SUCCESS)
-         {
-            tinyrad_strsfree(argv);
-            tinyrad_file_error(file, rc, msgsp);
-            tinyrad_file_destroy(file, TRAD_FILE_RECURSE);
-            return(rc);
-         };
-         break;
+   return;
+}
 
-         case TRAD_DICT_KEYWORD_BEGIN_VENDOR:
-         if ((rc = tinyrad_dict_parse_begin_vendor(dict, argc, argv, &vendor)) != TRAD_SUCCESS)
-         {
-            tinyrad_strsfree(argv);
-            tinyrad_file_error(file, rc, msgsp);
-            tinyrad_file_destroy(file, TRAD_FILE_RECURSE);
-            return(rc);
-         };
-         break;
 
-         case TRAD_DICT_KEYWORD_END_VENDOR:
-         if ((rc = tinyrad_dict_parse_end_vendor(dict, argc, argv, &vendor)) != TRAD_SUCCESS)
-         {
-            tinyrad_strsfree(argv);
-            tinyrad_file_error(file, rc, msgsp);
-            tinyrad_file_destroy(file, TRAD_FILE_RECURSE);
-            return(rc);
-         };
-         break;
+/// Parses deferred vendor blocks
+///
+/// Parses the blocks of the vendor, or the blocks of every vendor if vendor
+/// is NULL.  A frozen dictionary is frozen again so that the definitions are
+/// indexed.  Blocks which fail to parse are discarded and reported as
+/// TRAD_DEBUG_PARSE messages.
+///
+/// @param[in]  dict          dictionary reference
+/// @param[in]  vendor        vendor reference, or NULL for all vendors
+/// @return returns error code
+int
+tinyrad_dict_blocks_load(
+         TinyRadDict *                dict,
+         TinyRadDictVendor *          vendor )
+{
+   int                  rc;
+   size_t               pos;
+   size_t               len;
+   size_t               parsed;
+   TinyRadDict *        owner;
+   TinyRadDictBlock *   block;
+   TinyRadDictVendor *  next;
 
-         case TRAD_DICT_KEYWORD_INCLUDE:
-         if ((rc = tinyrad_dict_parse_include(dict, argc, argv, &file)) != TRAD_SUCCESS)
-         {
-            tinyrad_strsfree(argv);
-            tinyrad_file_error(file, rc, msgsp);
-            tinyrad_file_destroy(file, TRAD_FILE_RECURSE);
-            return(rc);
-         };
-         break;
+   TinyRadDebugTrace();
 
-         case TRAD_DICT_KEYWORD_VALUE:
-         if ((rc = tinyrad_dict_parse_value(dict, argc, argv, opts)) != TRAD_SUCCESS)
-         {
-            tinyrad_strsfree(argv);
-            tinyrad_file_error(file, rc, msgsp);
-            tinyrad_file_destroy(file, TRAD_FILE_RECURSE);
-            return(rc);
-         };
-         break;
+   assert(dict != NULL);
 
-         case TRAD_DICT_KEYWORD_VENDOR:
-         if ((rc = tinyrad_dict_parse_vendor(dict, argc, argv, opts)) != TRAD_SUCCESS)
+   if (!(atomic_load(&dict->blocks_pending)))
+      return(TRAD_SUCCESS);
+
+   // the thread parsing the dictionary already has exclusive access
+   if ((owner = tinyrad_dict_blocks_owner) != dict)
+   {
+      pthread_rwlock_wrlock(&dict->blocks_lock);
+      tinyrad_dict_blocks_owner = dict;
+   };
+
+   // blocks may have been parsed by another thread while waiting for the
+   // lock, in which case the lists and indexes are not rebuilt
+   parsed = 0;
+   if ( (!(atomic_load(&dict->blocks_pending))) || ( ((vendor)) && (!(vendor->blocks)) ) )
+      rc = TRAD_SUCCESS;
+   else if ((rc = tinyrad_dict_bulk_begin(dict)) == TRAD_SUCCESS)
+   {
+      len = ((vendor)) ? 1 : dict->vendors_id_len;
+      for(pos = 0; (pos < len); pos++)
+      {
+         next = ((vendor)) ? vendor : dict->vendors_id[pos];
+         if (!(next->blocks))
+            continue;
+         while((block = next->blocks) != NULL)
          {
-            tinyrad_strsfree(argv);
-            tinyrad_file_error(file, rc, msgsp);
-            tinyrad_file_destroy(file, TRAD_FILE_RECURSE);
-            return(rc);
+            next->blocks = block->next;
+            block->next  = NULL;
+            tinyrad_dict_blocks_parse(dict, next, block);
+            tinyrad_dict_blocks_free(block);
+            parsed++;
          };
-         break;
 
-         default:
-         tinyrad_strsfree(argv);
-         tinyrad_file_error(file, TRAD_ESYNTAX, msgsp);
-         tinyrad_file_destroy(file, TRAD_FILE_RECURSE);
-         return(TRAD_ESYNTAX);
+         // discard vendor index so it is rebuilt when dictionary is frozen
+         if ((next->attrs))
+            free(next->attrs);
+         next->attrs     = NULL;
+         next->attrs_len = 0;
+         tinyrad_dict_hash_free(&next->attrs_hash);
       };
-
-      tinyrad_strsfree(argv);
+      tinyrad_dict_bulk_end(dict);
+      if ( (!(dict->bulk)) && (tinyrad_dict_is_readonly(dict) == TRAD_YES) )
+         rc = tinyrad_dict_freeze(dict);
    };
 
-   tinyrad_file_error(NULL, TRAD_SUCCESS, msgsp);
+   // readers skip the lock once nothing is pending, so the count is lowered
+   // only after the lists and indexes have been rebuilt
+   if ((parsed))
+      atomic_fetch_sub(&dict->blocks_pending, parsed);
 
-   return(TRAD_SUCCESS);
+   if (owner != dict)
+   {
+      tinyrad_dict_blocks_owner = owner;
+      pthread_rwlock_unlock(&dict->blocks_lock);
+   };
+
+   return(rc);
 }
 
 
-int
-tinyrad_dict_parse_attribute(
+/// Parses deferred vendor block
+///
+/// @param[in]  dict          dictionary reference
+/// @param[in]  vendor        vendor named by BEGIN-VENDOR
+/// @param[in]  block         deferred vendor block
+/// @return returns error code
+static int
+tinyrad_dict_blocks_parse(
          TinyRadDict *                dict,
-         int                          argc,
-         char **                      argv,
          TinyRadDictVendor *          vendor,
-         uint32_t                     opts )
+         TinyRadDictBlock *           block )
 {
-   TinyRadDictAttr *    attr;
-   uint8_t              data_type;
-   uint32_t             flags;
-   uint32_t             flag;
-   uint32_t             attr_type;
    int                  rc;
-   char *               ptr;
-   char *               str;
-   TinyRadOID           oid;
+   int                  argc;
+   int                  keyword;
+   char *               argv[TRAD_ARGV_MAX];
+   char                 buff[TRAD_LINE_MAX_LEN];
+   size_t               len;
+   struct stat          sb;
+   TinyRadFile *        file;
+
+   TinyRadDebugTrace();
+
+   assert(dict   != NULL);
+   assert(vendor != NULL);
+   assert(block  != NULL);
+
+   if ((rc = tinyrad_file_init(&file, block->fullpath, NULL, NULL)) == TRAD_SUCCESS)
+   {
+      // file must be unchanged since the block was indexed
+      if (fstat(file->fd, &sb) == -1)
+         rc = TRAD_EACCES;
+      else if ( ((int64_t)sb.st_mtime != block->mtime) || ((uint32_t)sb.st_mtim.tv_nsec != block->mtime_nsec) || ((int64_t)sb.st_size != block->size) )
+         rc = TRAD_EUNKNOWN;
+      else
+         rc = tinyrad_file_seek(file, block->offset);
+      file->line = block->line;
+   };
+
+   // parse lines until END-VENDOR clears vendor
+   while ( (rc == TRAD_SUCCESS) && ((vendor)) )
+   {
+      if ((rc = tinyrad_file_readline(file, buff, sizeof(buff), &len)) != TRAD_SUCCESS)
+         break;
+      file->line++;
+      if (len == 0)
+      {
+         rc = TRAD_ESYNTAX;
+         break;
+      };
+      if ((rc = tinyrad_strtoargv(buff, argv, TRAD_ARGV_MAX, &argc)) != TRAD_SUCCESS)
+         break;
+      if (argc > 0)
+      {
+         keyword = tinyrad_map_lookup_name(tinyrad_dict_options, argv[0], NULL);
+         rc      = tinyrad_dict_parse_keyword(dict, keyword, argc, argv, &vendor, 0);
+      };
+   };
+
+   if (rc != TRAD_SUCCESS)
+      TinyRadDebug(TRAD_DEBUG_PARSE, "%s:%i: %s", block->fullpath, (((file)) ? file->line : block->line), tinyrad_strerror(rc));
+
+   tinyrad_file_destroy(file, TRAD_FILE_NORECURSE);
+
+   return(rc);
+}
+
+
+/// Looks up vendor and parses its deferred blocks
+///
+/// @param[in]  dict          dictionary reference
+/// @param[in]  name          vendor name
+/// @param[in]  id            vendor ID
+/// @return returns vendor reference
+static TinyRadDictVendor *
+tinyrad_dict_blocks_vendor(
+         TinyRadDict *                dict,
+         const char *                 name,
+         uint32_t                     id )
+{
+   int                  pending;
+   TinyRadDictVendor *  vendor;
 
    TinyRadDebugTrace();
 
    assert(dict != NULL);
-   assert(opts == 0);
 
-   if ( (argc < 4) || (argc > 5) )
-      return(TRAD_ESYNTAX);
+   pthread_rwlock_rdlock(&dict->blocks_lock);
+   vendor  = tinyrad_dict_vendor_lookup_local(dict, name, id);
+   pending = ( ((vendor)) && ((vendor->blocks)) ) ? TRAD_YES : TRAD_NO;
+   pthread_rwlock_unlock(&dict->blocks_lock);
 
-   if ((data_type = (uint8_t)tinyrad_map_lookup_name(tinyrad_dict_data_type, argv[3], NULL)) == 0)
-      return(TRAD_ESYNTAX);
+   if (pending == TRAD_YES)
+      tinyrad_dict_blocks_load(dict, vendor);
 
-   if ((attr_type = (uint32_t)strtoul(argv[2], &ptr, 10)) == 0)
-      return(TRAD_ESYNTAX);
+   return(vendor);
+}
 
-   if ((ptr[0] != '\0') || (argv[2] == ptr))
-      return(TRAD_ESYNTAX);
 
-   flags = 0;
-   if (argc == 5)
+//---------------------------//
+// dictionary hash functions //
+//---------------------------//
+#pragma mark dictionary hash functions
+
+/// Folds OID into FNV-1a hash
+///
+/// @param[in]  hash          current hash value
+/// @param[in]  oid           OID to fold into hash
+/// @return returns updated hash value
+static uint64_t
+__hash_oid(
+         uint64_t                      hash,
+         const TinyRadOID *            oid )
+{
+   size_t      pos;
+   assert(oid != NULL);
+   for(pos = 0; (pos < oid->oid_len); pos++)
+      hash = __hash_u64(hash, oid->oid_val[pos]);
+   return(__hash_u64(hash, oid->oid_len));
+}
+
+
+/// Folds lower case form of string into FNV-1a hash
+///
+/// @param[in]  hash          current hash value
+/// @param[in]  str           string to fold into hash
+/// @return returns updated hash value
+static uint64_t
+__hash_str(
+         uint64_t                      hash,
+         const char *                  str )
+{
+   const unsigned char *   ptr;
+   unsigned                c;
+   assert(str != NULL);
+   for(ptr = (const unsigned char *)str; ((*ptr)); ptr++)
    {
-      ptr = argv[4];
-      while ((str = ptr) != NULL)
-      {
-         if ((ptr = strchr(str, ',')) != NULL)
-            ptr[0] = '\0';
+      c     = ( (*ptr >= 'A') && (*ptr <= 'Z') ) ? (*ptr | 0x20) : *ptr;
+      hash ^= c;
+      hash *= 0x100000001b3ULL;
+   };
+   return(hash);
+}
+
+
+/// Folds integer into FNV-1a hash
+///
+/// @param[in]  hash          current hash value
+/// @param[in]  val           integer to fold into hash
+/// @return returns updated hash value
+static uint64_t
+__hash_u64(
+         uint64_t                      hash,
+         uint64_t                      val )
+{
+   size_t      pos;
+   for(pos = 0; (pos < 8); pos++)
+   {
+      hash ^= (val >> (pos * 8)) & 0xff;
+      hash *= 0x100000001b3ULL;
+   };
+   return(hash);
+}
+
+
+/// Stores object in dictionary hash table, growing table as needed
+///
+/// @param[in]  hash          hash table reference
+/// @param[in]  hval          hash value of object's key
+/// @param[in]  obj           object to store
+/// @param[in]  key           object's key
+/// @param[in]  compar        key comparison function
+/// @return returns error code
+int
+tinyrad_dict_hash_add(
+         TinyRadDictHash *             hash,
+         uint64_t                      hval,
+         void *                        obj,
+         const void *                  key,
+         int (*compar)(const void *, const void *) )
+{
+   assert(hash != NULL);
+
+   if (tinyrad_dict_hash_grow(hash) != TRAD_SUCCESS)
+      return(TRAD_ENOMEM);
+
+   tinyrad_dict_hash_insert(hash, hval, obj, key, compar);
+
+   return(TRAD_SUCCESS);
+}
+
+
+/// Builds dictionary hash tables from the sorted dictionary lists
+///
+/// The sorted lists are walked in order so that the last duplicate of a key
+/// wins, which matches the results returned by the binary searches.
+///
+/// @param[in]  dict          dictionary reference
+/// @return returns error code
+int
+tinyrad_dict_hash_build(
+         TinyRadDict *                dict )
+{
+   size_t               pos;
+   uint64_t             hval;
+   TinyRadDictKey       key;
+   TinyRadDictAttr *    attr;
+   TinyRadDictValue *   value;
+   TinyRadDictVendor *  vendor;
+
+   TinyRadDebugTrace();
+
+   assert(dict != NULL);
+
+   tinyrad_dict_hash_free(&dict->attrs_name_hash);
+   tinyrad_dict_hash_free(&dict->attrs_type_hash);
+   tinyrad_dict_hash_free(&dict->values_data_hash);
+   tinyrad_dict_hash_free(&dict->values_name_hash);
+   tinyrad_dict_hash_free(&dict->vendors_id_hash);
+   tinyrad_dict_hash_free(&dict->vendors_name_hash);
+
+   if ( ((tinyrad_dict_hash_init(&dict->attrs_name_hash,   dict->attrs_name_len))   != TRAD_SUCCESS) ||
+        ((tinyrad_dict_hash_init(&dict->attrs_type_hash,   dict->attrs_type_len))   != TRAD_SUCCESS) ||
+        ((tinyrad_dict_hash_init(&dict->values_data_hash,  dict->values_data_len))  != TRAD_SUCCESS) ||
+        ((tinyrad_dict_hash_init(&dict->values_name_hash,  dict->values_name_len))  != TRAD_SUCCESS) ||
+        ((tinyrad_dict_hash_init(&dict->vendors_id_hash,   dict->vendors_id_len))   != TRAD_SUCCESS) ||
+        ((tinyrad_dict_hash_init(&dict->vendors_name_hash, dict->vendors_name_len)) != TRAD_SUCCESS) )
+   {
+      tinyrad_dict_hash_free(&dict->attrs_name_hash);
+      tinyrad_dict_hash_free(&dict->attrs_type_hash);
+      tinyrad_dict_hash_free(&dict->values_data_hash);
+      tinyrad_dict_hash_free(&dict->values_name_hash);
+      tinyrad_dict_hash_free(&dict->vendors_id_hash);
+      tinyrad_dict_hash_free(&dict->vendors_name_hash);
+      return(TRAD_ENOMEM);
+   };
+
+   // index attributes
+   for(pos = 0; (pos < dict->attrs_name_len); pos++)
+   {
+      attr = dict->attrs_name[pos];
+      hval = __dict_str(attr->name)->hash;
+      tinyrad_dict_hash_insert(&dict->attrs_name_hash, hval, attr, attr->name, &tinyrad_dict_attr_cmp_key_name);
+   };
+   for(pos = 0; (pos < dict->attrs_type_len); pos++)
+   {
+      attr = dict->attrs_type[pos];
+      hval = __hash_oid(TRAD_DICT_HASH_SEED, attr->oid);
+      tinyrad_dict_hash_insert(&dict->attrs_type_hash, hval, attr, attr->oid, &tinyrad_dict_attr_cmp_key_type);
+   };
+
+   // index values
+   memset(&key, 0, sizeof(key));
+   for(pos = 0; (pos < dict->values_data_len); pos++)
+   {
+      value    = dict->values_data[pos];
+      key.oid  = value->attr->oid;
+      key.data = value->data;
+      hval     = __hash_u64(__hash_oid(TRAD_DICT_HASH_SEED, key.oid), key.data);
+      tinyrad_dict_hash_insert(&dict->values_data_hash, hval, value, &key, &tinyrad_dict_value_cmp_key_data);
+   };
+   for(pos = 0; (pos < dict->values_name_len); pos++)
+   {
+      value    = dict->values_name[pos];
+      key.oid  = value->attr->oid;
+      key.str  = value->name;
+      hval     = __hash_u64(__hash_oid(TRAD_DICT_HASH_SEED, key.oid), __dict_str(key.str)->hash);
+      tinyrad_dict_hash_insert(&dict->values_name_hash, hval, value, &key, &tinyrad_dict_value_cmp_key_name);
+   };
+
+   // index vendors
+   for(pos = 0; (pos < dict->vendors_id_len); pos++)
+   {
+      vendor = dict->vendors_id[pos];
+      hval   = __hash_u64(TRAD_DICT_HASH_SEED, vendor->id);
+      tinyrad_dict_hash_insert(&dict->vendors_id_hash, hval, vendor, &vendor->id, &tinyrad_dict_vendor_cmp_key_id);
+   };
+   for(pos = 0; (pos < dict->vendors_name_len); pos++)
+   {
+      vendor = dict->vendors_name[pos];
+      hval   = __dict_str(vendor->name)->hash;
+      tinyrad_dict_hash_insert(&dict->vendors_name_hash, hval, vendor, vendor->name, &tinyrad_dict_vendor_cmp_key_name);
+   };
+
+   return(TRAD_SUCCESS);
+}
+
+
+/// Frees slots of frozen dictionary hash table
+///
+/// @param[in]  hash          hash table reference
+void
+tinyrad_dict_hash_free(
+         TinyRadDictHash *             hash )
+{
+   assert(hash != NULL);
+   if ((hash->slots))
+      free(hash->slots);
+   hash->slots = NULL;
+   hash->size  = 0;
+   hash->count = 0;
+   return;
+}
+
+
+/// Grows dictionary hash table so one more object can be stored
+///
+/// @param[in]  hash          hash table reference
+/// @return returns error code
+int
+tinyrad_dict_hash_grow(
+         TinyRadDictHash *             hash )
+{
+   size_t               pos;
+   size_t               idx;
+   size_t               mask;
+   size_t               size;
+   TinyRadDictSlot *    slots;
+
+   assert(hash != NULL);
+
+   if ( ((hash->count + 1) * 2) <= hash->size )
+      return(TRAD_SUCCESS);
+
+   size = ((hash->size)) ? (hash->size * 2) : TRAD_DICT_HASH_MIN_SIZE;
+   if ((slots = calloc(size, sizeof(TinyRadDictSlot))) == NULL)
+      return(TRAD_ENOMEM);
+   mask = size - 1;
+   for(pos = 0; (pos < hash->size); pos++)
+   {
+      if (!(hash->slots[pos].obj))
+         continue;
+      for(idx = (size_t)hash->slots[pos].hash & mask; ((slots[idx].obj)); idx = (idx + 1) & mask);
+      slots[idx] = hash->slots[pos];
+   };
+   free(hash->slots);
+   hash->slots = slots;
+   hash->size  = size;
+
+   return(TRAD_SUCCESS);
+}
+
+
+/// Allocates slots of frozen dictionary hash table
+///
+/// The table is sized to the next power of two which keeps the load factor
+/// at or below 50%, so linear probing stays short.
+///
+/// @param[in]  hash          hash table reference
+/// @param[in]  len           number of objects which will be stored
+/// @return returns error code
+int
+tinyrad_dict_hash_init(
+         TinyRadDictHash *             hash,
+         size_t                        len )
+{
+   size_t      size;
+
+   assert(hash != NULL);
+
+   for(size = TRAD_DICT_HASH_MIN_SIZE; (size < (len * 2)); size <<= 1);
+
+   if ((hash->slots = calloc(size, sizeof(TinyRadDictSlot))) == NULL)
+      return(TRAD_ENOMEM);
+   hash->size  = size;
+   hash->count = 0;
+
+   return(TRAD_SUCCESS);
+}
+
+
+/// Stores object in frozen dictionary hash table
+///
+/// Objects must be inserted in sorted order. An object with a key matching
+/// an existing slot replaces the previous object, which mirrors the
+/// TINYRAD_ARRAY_LASTDUP behavior of the sorted lists.
+///
+/// @param[in]  hash          hash table reference
+/// @param[in]  hval          hash value of object's key
+/// @param[in]  obj           object to store
+/// @param[in]  key           object's key
+/// @param[in]  compar        key comparison function
+void
+tinyrad_dict_hash_insert(
+         TinyRadDictHash *             hash,
+         uint64_t                      hval,
+         void *                        obj,
+         const void *                  key,
+         int (*compar)(const void *, const void *) )
+{
+   size_t               mask;
+   size_t               pos;
+   TinyRadDictSlot *    slot;
+
+   assert(hash        != NULL);
+   assert(hash->slots != NULL);
+   assert(obj         != NULL);
+
+   mask = hash->size - 1;
+   for(pos = (size_t)hval & mask; ; pos = (pos + 1) & mask)
+   {
+      slot = &hash->slots[pos];
+      if ( (!(slot->obj)) || ( (slot->hash == hval) && (!(compar(&slot->obj, key))) ) )
+      {
+         if (!(slot->obj))
+            hash->count++;
+         slot->hash = hval;
+         slot->obj  = obj;
+         return;
+      };
+   };
+}
+
+
+/// Retrieves object from frozen dictionary hash table
+///
+/// @param[in]  hash          hash table reference
+/// @param[in]  hval          hash value of key
+/// @param[in]  key           key to search for
+/// @param[in]  compar        key comparison function
+/// @return returns matching object or NULL if not found
+void *
+tinyrad_dict_hash_lookup(
+         const TinyRadDictHash *       hash,
+         uint64_t                      hval,
+         const void *                  key,
+         int (*compar)(const void *, const void *) )
+{
+   size_t                  mask;
+   size_t                  pos;
+   const TinyRadDictSlot * slot;
+
+   assert(hash != NULL);
+
+   if (!(hash->slots))
+      return(NULL);
+
+   mask = hash->size - 1;
+   for(pos = (size_t)hval & mask; ; pos = (pos + 1) & mask)
+   {
+      tinyrad_dict_probes++;
+      slot = &hash->slots[pos];
+      if (!(slot->obj))
+         return(NULL);
+      if ( (slot->hash == hval) && (!(compar(&slot->obj, key))) )
+         return(slot->obj);
+   };
+}
+
+
+//-----------------------------//
+// dictionary import functions //
+//-----------------------------//
+#pragma mark dictionary import functions
+
+int
+tinyrad_dict_builtin(
+         TinyRadDict *                 dict,
+         char ***                      msgsp )
+{
+   int rc;
+   TinyRadDebugTrace();
+   assert(dict != NULL);
+   if (tinyrad_dict_is_readonly(dict) == TRAD_YES)
+      return(TRAD_EDICTRO);
+   if ((dict->opts & TRAD_BUILTIN_DICT_LOADED))
+      return(TRAD_SUCCESS);
+   if ((rc = tinyrad_dict_import(dict, tinyrad_dict_default_vendors, tinyrad_dict_default_attrs, tinyrad_dict_default_values, msgsp)) != TRAD_SUCCESS)
+      return(rc);
+   dict->opts |= TRAD_BUILTIN_DICT_LOADED;
+   return(TRAD_SUCCESS);
+}
+
+
+int
+tinyrad_dict_import(
+         TinyRadDict *                 dict,
+         const TinyRadDictVendorDef *  vendor_defs,
+         const TinyRadDictAttrDef *    attr_defs,
+         const TinyRadDictValueDef *   value_defs,
+         char ***                      msgsp )
+{
+   int                     rc;
+
+   TinyRadDebugTrace();
+
+   assert(dict != NULL);
+
+   if ((msgsp))
+      *msgsp = NULL;
+
+   if (tinyrad_dict_is_readonly(dict) == TRAD_YES)
+      return(TRAD_EDICTRO);
+
+   if ((rc = tinyrad_dict_bulk_begin(dict)) != TRAD_SUCCESS)
+      return(tinyrad_error_msgs(rc, msgsp, "out of virtual memory"));
+   rc = tinyrad_dict_import_defs(dict, vendor_defs, attr_defs, value_defs, msgsp);
+   tinyrad_dict_bulk_end(dict);
+
+   return(rc);
+}
+
+
+int
+tinyrad_dict_import_defs(
+         TinyRadDict *                 dict,
+         const TinyRadDictVendorDef *  vendor_defs,
+         const TinyRadDictAttrDef *    attr_defs,
+         const TinyRadDictValueDef *   value_defs,
+         char ***                      msgsp )
+{
+   int                     rc;
+   size_t                  pos;
+   uint8_t                 type;
+   uint8_t                 data_type;
+   uint32_t                flags;
+   uint64_t                data;
+   uint32_t                vendor_id;
+   uint8_t                 type_octs;
+   uint8_t                 len_octs;
+   const char *            attr_name;
+   const char *            value_name;
+   const char *            vendor_name;
+   TinyRadDictValue *      value;
+   TinyRadDictVendor *     vendor;
+   TinyRadDictAttr *       attr;
+   TinyRadOID              oid;
+
+   TinyRadDebugTrace();
+
+   assert(dict != NULL);
+
+   if ((vendor_defs))
+   {
+      for(pos = 0; ((vendor_defs[pos].name)); pos++)
+      {
+         vendor_name = vendor_defs[pos].name;
+         vendor_id   = (uint32_t)vendor_defs[pos].vendor_id;
+         type_octs   = (uint8_t)vendor_defs[pos].vendor_type_octs;
+         len_octs    = (uint8_t)vendor_defs[pos].vendor_len_octs;
+         if ((vendor = tinyrad_dict_vendor_alloc(dict, vendor_name, vendor_id, type_octs, len_octs)) == NULL)
+            return(tinyrad_error_msgs(TRAD_ENOMEM, msgsp, "out of virtual memory"));
+         rc = tinyrad_dict_add_vendor(dict, vendor);
+         tinyrad_obj_release(&vendor->obj);
+         if (rc != TRAD_SUCCESS)
+            return(tinyrad_error_msgs(rc, msgsp, "default attribute %s(%" PRIu32 "): ", vendor_name, vendor_id));
+      };
+   };
+
+   if ((attr_defs))
+   {
+      for(pos = 0; ((attr_defs[pos].name)); pos++)
+      {
+         attr_name       = attr_defs[pos].name;
+         type            = (uint8_t)attr_defs[pos].type;
+         data_type       = (uint8_t)attr_defs[pos].data_type;
+         flags           = (uint32_t)attr_defs[pos].flags;
+         oid.oid_len     = ((attr_defs[pos].vendor_id)) ? 3 : 1;
+         oid.oid_val[0]  = (uint32_t)attr_defs[pos].type;
+         oid.oid_val[1]  = (uint32_t)attr_defs[pos].vendor_id;
+         oid.oid_val[2]  = (uint32_t)attr_defs[pos].vendor_type;
+         if ((attr = tinyrad_dict_attr_alloc(dict, attr_name, &oid, data_type, flags)) == NULL)
+            return(tinyrad_error_msgs(TRAD_ENOMEM, msgsp, "out of virtual memory"));
+         rc = tinyrad_dict_add_attr(dict, attr);
+         tinyrad_obj_release(&attr->obj);
+         if (rc != TRAD_SUCCESS)
+            return(tinyrad_error_msgs(rc, msgsp, "default attribute %s(%" PRIu32 "): ", attr_name, type));
+      };
+   };
+
+   if ((value_defs))
+   {
+      attr = NULL;
+      for(pos = 0; ((value_defs[pos].attr_name)); pos++)
+      {
+         attr_name  = value_defs[pos].attr_name;
+         value_name = value_defs[pos].value_name;
+         data       = value_defs[pos].data;
+         if ((attr))
+            if ((strcasecmp(attr_name, attr->name)))
+               attr = NULL;
+         if (!(attr))
+            attr = tinyrad_dict_attr_lookup(dict, attr_name, NULL);
+         if (!(attr))
+            return(tinyrad_error_msgs(TRAD_ENOENT, msgsp, "default value: %s %s(%" PRIu64 "): ", attr_name, value_name, data));
+         if ((value = tinyrad_dict_value_alloc(dict, attr, value_name, data)) == NULL)
+            return(tinyrad_error_msgs(TRAD_ENOMEM, msgsp, "out of virtual memory"));
+         rc = tinyrad_dict_add_value(dict,attr, value);
+         tinyrad_obj_release(&value->obj);
+         if (rc != TRAD_SUCCESS)
+            return(tinyrad_error_msgs(rc, msgsp, "default value: %s %s(%" PRIu64 "): ", attr_name, value_name, data));
+      };
+   };
+
+   return(TRAD_SUCCESS);
+}
+
+
+//----------------------------//
+// dictionary parse functions //
+//----------------------------//
+#pragma mark dictionary parse functions
+
+/// Imports file into dictionary
+///
+/// @param[in]  dict          dictionary reference
+/// @param[in]  path          path to import file
+/// @param[out] msgsp         pointer to generated error details
+/// @param[in]  opts          import options
+/// @return returns error code
+int
+tinyrad_dict_parse(
+         TinyRadDict *                dict,
+         const char *                 path,
+         char ***                     msgsp,
+         uint32_t                     opts )
+{
+   int                   rc;
+   TinyRadDict *         owner;
+
+   TinyRadDebugTrace();
+
+   assert(dict != NULL);
+   assert(path != NULL);
+
+   if ((msgsp))
+      *msgsp = NULL;
+
+   if (tinyrad_dict_is_readonly(dict) == TRAD_YES)
+      return(TRAD_EDICTRO);
+
+   if ((rc = tinyrad_dict_bulk_begin(dict)) != TRAD_SUCCESS)
+      return(tinyrad_error_msgs(rc, msgsp, "out of virtual memory"));
+
+   // lookups made while parsing do not trigger parsing of deferred blocks
+   owner = tinyrad_dict_blocks_owner;
+   tinyrad_dict_blocks_owner = dict;
+
+   // vendor blocks are not deferred when parsing in parallel
+   if ((opts & TRAD_DICT_PARSE_PARALLEL))
+      rc = tinyrad_dict_parse_parallel(dict, path, msgsp, (opts & ~(TRAD_DICT_PARSE_PARALLEL|TRAD_DICT_PARSE_LAZY)));
+   else
+      rc = tinyrad_dict_parse_file(dict, path, msgsp, opts);
+
+   tinyrad_dict_blocks_owner = owner;
+   tinyrad_dict_bulk_end(dict);
+
+   return(rc);
+}
+
+
+int
+tinyrad_dict_parse_file(
+         TinyRadDict *                dict,
+         const char *                 path,
+         char ***                     msgsp,
+         uint32_t                     opts )
+{
+   int                   rc;
+   int                   argc;
+   int                   keyword;
+   int                   line;
+   char *                argv[TRAD_ARGV_MAX];
+   char                  buff[TRAD_LINE_MAX_LEN];
+   size_t                len;
+   off_t                 offset;
+   uint32_t              lazy;
+   TinyRadFile *         file;
+   TinyRadFile *         parent;
+   TinyRadDictVendor *   vendor;
+   TinyRadDictVendor *   skip;
+
+   TinyRadDebugTrace();
+
+   assert(dict != NULL);
+   assert(path != NULL);
+
+   vendor = NULL;
+   skip   = NULL;
+   offset = 0;
+   line   = 0;
+   lazy   = opts & TRAD_DICT_PARSE_LAZY;
+   opts  &= ~TRAD_DICT_PARSE_LAZY;
+
+   // initialize file buffer
+   if ((rc = tinyrad_file_init(&file, path, dict->paths, NULL)) != TRAD_SUCCESS)
+   {
+      tinyrad_file_error(file, rc, msgsp);
+      tinyrad_file_destroy(file, TRAD_FILE_RECURSE);
+      return(rc);
+   };
+   if ((rc = tinyrad_dict_parse_source(dict, file)) != TRAD_SUCCESS)
+   {
+      tinyrad_file_error(file, rc, msgsp);
+      tinyrad_file_destroy(file, TRAD_FILE_RECURSE);
+      return(rc);
+   };
+
+   // loops through dictionary file
+   while((file))
+   {
+      // reads next line
+      if ((rc = tinyrad_file_readline(file, buff, sizeof(buff), &len)) < 0)
+      {
+         tinyrad_file_error(file, rc, msgsp);
+         tinyrad_file_destroy(file, TRAD_FILE_RECURSE);
+         return(rc);
+      };
+      file->line++;
+      if ( (len == 0) && (!(skip)) )
+      {
+         parent = file->parent;
+         tinyrad_file_destroy(file, TRAD_FILE_NORECURSE);
+         file = parent;
+         continue;
+      };
+      if ((rc = tinyrad_strtoargv(buff, argv, TRAD_ARGV_MAX, &argc)) != TRAD_SUCCESS)
+      {
+         tinyrad_file_error(file, rc, msgsp);
+         tinyrad_file_destroy(file, TRAD_FILE_RECURSE);
+         return(rc);
+      };
+
+      // index deferred vendor block without parsing it
+      if ((skip))
+      {
+         keyword = (argc > 0) ? tinyrad_map_lookup_name(tinyrad_dict_options, argv[0], NULL) : 0;
+         if ( (len == 0) || (keyword == TRAD_DICT_KEYWORD_INCLUDE) || (keyword == TRAD_DICT_KEYWORD_VENDOR) )
+         {
+            // blocks which include files, define vendors, or are not
+            // terminated within the file are parsed immediately
+            rc         = tinyrad_file_seek(file, offset);
+            file->line = line;
+            vendor     = skip;
+            skip       = NULL;
+         }
+         else if (keyword == TRAD_DICT_KEYWORD_END_VENDOR)
+         {
+            vendor = skip;
+            if ((rc = tinyrad_dict_parse_end_vendor(dict, argc, argv, &vendor)) == TRAD_SUCCESS)
+               rc = tinyrad_dict_blocks_add(dict, skip, file, offset, line);
+            skip = NULL;
+         };
+         if (rc != TRAD_SUCCESS)
+         {
+            tinyrad_file_error(file, rc, msgsp);
+            tinyrad_file_destroy(file, TRAD_FILE_RECURSE);
+            return(rc);
+         };
+         continue;
+      };
+
+      if (argc < 1)
+         continue;
+
+      // defer vendor block until the vendor is used
+      keyword = tinyrad_map_lookup_name(tinyrad_dict_options, argv[0], NULL);
+      if ( ((lazy)) && (keyword == TRAD_DICT_KEYWORD_BEGIN_VENDOR) && (!(vendor)) && (argc == 2) )
+      {
+         if ( ((skip = tinyrad_dict_vendor_lookup_local(dict, argv[1], 0)) != NULL) &&
+              ((offset = tinyrad_file_tell(file)) != -1) )
+         {
+            line = file->line;
+            continue;
+         };
+         skip = NULL;
+      };
+
+      // perform requested action
+      if (keyword == TRAD_DICT_KEYWORD_INCLUDE)
+         rc = tinyrad_dict_parse_include(dict, argc, argv, &file);
+      else
+         rc = tinyrad_dict_parse_keyword(dict, keyword, argc, argv, &vendor, opts);
+      if (rc != TRAD_SUCCESS)
+      {
+         tinyrad_file_error(file, rc, msgsp);
+         tinyrad_file_destroy(file, TRAD_FILE_RECURSE);
+         return(rc);
+      };
+   };
+
+   tinyrad_file_error(NULL, TRAD_SUCCESS, msgsp);
+
+   return(TRAD_SUCCESS);
+}
+
+
+int
+tinyrad_dict_parse_attribute(
+         TinyRadDict *                dict,
+         int                          argc,
+         char **                      argv,
+         TinyRadDictVendor *          vendor,
+         uint32_t                     opts )
+{
+   TinyRadDictAttr *    attr;
+   uint8_t              data_type;
+   uint32_t             flags;
+   uint32_t             flag;
+   uint32_t             attr_type;
+   int                  rc;
+   char *               ptr;
+   char *               str;
+   TinyRadOID           oid;
+
+   TinyRadDebugTrace();
+
+   assert(dict != NULL);
+   assert(opts == 0);
+
+   if ( (argc < 4) || (argc > 5) )
+      return(TRAD_ESYNTAX);
+
+   if ((data_type = (uint8_t)tinyrad_map_lookup_name(tinyrad_dict_data_type, argv[3], NULL)) == 0)
+      return(TRAD_ESYNTAX);
+
+   if ((attr_type = (uint32_t)strtoul(argv[2], &ptr, 10)) == 0)
+      return(TRAD_ESYNTAX);
+
+   if ((ptr[0] != '\0') || (argv[2] == ptr))
+      return(TRAD_ESYNTAX);
+
+   flags = 0;
+   if (argc == 5)
+   {
+      ptr = argv[4];
+      while ((str = ptr) != NULL)
+      {
+         if ((ptr = strchr(str, ',')) != NULL)
+            ptr[0] = '\0';
          if ((flag = (uint32_t)tinyrad_map_lookup_name(tinyrad_dict_attr_flags, str, NULL)) == 0)
             return(TRAD_ESYNTAX);
          if ( ((flag & TRAD_FLG_ENCRYPT_MASK) != 0) && ((flags & TRAD_FLG_ENCRYPT_MASK) != 0) )
@@ -1707,399 +3670,1618 @@ tinyrad_dict_parse_attribute(
       };
    };
 
-   oid.oid_len    = ((vendor)) ? 3                         : 1;
-   oid.oid_val[0] = ((vendor)) ? TRAD_ATTR_VENDOR_SPECIFIC : attr_type;
-   oid.oid_val[1] = ((vendor)) ? vendor->id                : 0;
-   oid.oid_val[2] = ((vendor)) ? attr_type                 : 0;
+   oid.oid_len    = ((vendor)) ? 3                         : 1;
+   oid.oid_val[0] = ((vendor)) ? TRAD_ATTR_VENDOR_SPECIFIC : attr_type;
+   oid.oid_val[1] = ((vendor)) ? vendor->id                : 0;
+   oid.oid_val[2] = ((vendor)) ? attr_type                 : 0;
+
+   if ((attr = tinyrad_dict_attr_alloc(dict, argv[1], &oid, data_type, flags)) == NULL)
+      return(TRAD_ENOMEM);
+   rc = tinyrad_dict_add_attr(dict, attr);
+   tinyrad_obj_release(&attr->obj);
+   return(rc);
+}
+
+
+/// Determines if a dictionary file is already being parsed by an including file
+///
+/// @param[in]  file          file buffer reference
+/// @return returns TRAD_YES if the file includes itself, otherwise TRAD_NO
+static int
+tinyrad_dict_parse_cycle(
+         const TinyRadFile *          file )
+{
+   const TinyRadFile *  parent;
+
+   TinyRadDebugTrace();
+
+   assert(file != NULL);
+
+   if (!(file->fullpath))
+      return(TRAD_NO);
+
+   for(parent = file->parent; ((parent)); parent = parent->parent)
+      if ( ((parent->fullpath)) && (!(strcmp(parent->fullpath, file->fullpath))) )
+         return(TRAD_YES);
+
+   return(TRAD_NO);
+}
+
+
+int
+tinyrad_dict_parse_begin_vendor(
+         TinyRadDict *                dict,
+         int                          argc,
+         char **                      argv,
+         TinyRadDictVendor **         vendorp )
+{
+   TinyRadDebugTrace();
+
+   assert(dict    != NULL);
+   assert(vendorp != NULL);
+
+   if (argc != 2)
+      return(TRAD_ESYNTAX);
+   if ((*vendorp))
+      return(TRAD_ESYNTAX);
+   if ((*vendorp = tinyrad_dict_vendor_lookup(dict, argv[1], 0)) == NULL)
+      return(TRAD_ESYNTAX);
+
+   return(TRAD_SUCCESS);
+}
+
+
+int
+tinyrad_dict_parse_end_vendor(
+         TinyRadDict *                dict,
+         int                          argc,
+         char **                      argv,
+         TinyRadDictVendor **         vendorp )
+{
+   TinyRadDebugTrace();
+
+   assert(dict    != NULL);
+   assert(vendorp != NULL);
+
+   if (argc != 2)
+      return(TRAD_ESYNTAX);
+   if (!(*vendorp))
+      return(TRAD_ESYNTAX);
+   if ((strcasecmp((*vendorp)->name, argv[1])))
+      return(TRAD_ESYNTAX);
+
+   *vendorp = NULL;
+
+   return(TRAD_SUCCESS);
+}
+
+
+int
+tinyrad_dict_parse_include(
+         TinyRadDict *                dict,
+         int                          argc,
+         char **                      argv,
+         TinyRadFile **               filep )
+{
+   int            rc;
+   TinyRadFile *  incl;
+
+   TinyRadDebugTrace();
+
+   assert(dict  != NULL);
+   assert(filep != NULL);
+
+   if (argc != 2)
+      return(TRAD_ESYNTAX);
+
+   if ((rc = tinyrad_file_init(&incl, argv[1], dict->paths, *filep)) != TRAD_SUCCESS)
+   {
+      *filep = ((incl)) ? incl : *filep;
+      return(rc);
+   };
+
+   *filep = incl;
+
+   // reject files which include themselves
+   if (tinyrad_dict_parse_cycle(incl) == TRAD_YES)
+      return(TRAD_ESYNTAX);
+
+   return(tinyrad_dict_parse_source(dict, incl));
+}
+
+
+/// Allocates job which tokenizes a dictionary file on a worker thread
+///
+/// Only the path is queued, the file is opened by the worker which tokenizes
+/// it.  Jobs nested too deeply are marked finished with the error instead of
+/// being queued, the error is reported when the job is merged.
+///
+/// @param[in]  pool          worker pool reference
+/// @param[in]  parent        job of including file
+/// @param[in]  path          path to dictionary file
+/// @return returns job reference or NULL if out of memory
+static TinyRadDictJob *
+tinyrad_dict_parse_job(
+         TinyRadDictPool *            pool,
+         TinyRadDictJob *             parent,
+         const char *                 path )
+{
+   TinyRadDictJob *     job;
+
+   TinyRadDebugTrace();
+
+   assert(pool != NULL);
+   assert(path != NULL);
+
+   if ((job = malloc(sizeof(TinyRadDictJob))) == NULL)
+      return(NULL);
+   memset(job, 0, sizeof(TinyRadDictJob));
+   job->parent = parent;
+   job->depth  = ((parent)) ? (parent->depth + 1) : 0;
+   if ((job->path = tinyrad_strdup(path)) == NULL)
+   {
+      free(job);
+      return(NULL);
+   };
+
+   pthread_mutex_lock(&pool->mutex);
+   job->jobs  = pool->jobs;
+   pool->jobs = job;
+   if (job->depth <= TRAD_DICT_PARSE_DEPTH)
+   {
+      if ((pool->queue_tail))
+         pool->queue_tail->next = job;
+      else
+         pool->queue = job;
+      pool->queue_tail = job;
+   } else {
+      job->rc   = TRAD_ESYNTAX;
+      job->done = TRAD_YES;
+   };
+   pthread_cond_broadcast(&pool->cond);
+   pthread_mutex_unlock(&pool->mutex);
+
+   return(job);
+}
+
+
+/// Opens file of job and records file attributes for dictionary sources
+///
+/// @param[in]  pool          worker pool reference
+/// @param[in]  job           job reference
+/// @return returns error code
+static int
+tinyrad_dict_parse_job_open(
+         TinyRadDictPool *            pool,
+         TinyRadDictJob *             job )
+{
+   int                  rc;
+   struct stat          sb;
+
+   TinyRadDebugTrace();
+
+   assert(pool != NULL);
+   assert(job  != NULL);
+
+   if ((rc = tinyrad_file_init(&job->file, job->path, pool->paths, ((job->parent)) ? job->parent->file : NULL)) != TRAD_SUCCESS)
+      return(rc);
+
+   // reject files which include themselves before any of their includes are queued
+   if (tinyrad_dict_parse_cycle(job->file) == TRAD_YES)
+      return(TRAD_ESYNTAX);
+   if (fstat(job->file->fd, &sb) == -1)
+      return(TRAD_EACCES);
+
+   job->mtime       = (int64_t)sb.st_mtime;
+   job->mtime_nsec  = (uint32_t)sb.st_mtim.tv_nsec;
+   job->size        = (int64_t)sb.st_size;
+   job->opened      = TRAD_YES;
+
+   return(TRAD_SUCCESS);
+}
+
+
+/// Splits dictionary file into lines of arguments
+///
+/// Lines are recorded up to the first error so that errors are reported in
+/// the same order as a serial parse.
+///
+/// @param[in]  pool          worker pool reference
+/// @param[in]  job           job reference
+/// @return returns error code
+static int
+tinyrad_dict_parse_job_tokenize(
+         TinyRadDictPool *            pool,
+         TinyRadDictJob *             job )
+{
+   int                  rc;
+   int                  argc;
+   int                  keyword;
+   char **              argv;
+   char                 buff[TRAD_LINE_MAX_LEN];
+   size_t               len;
+   size_t               size;
+   void *               ptr;
+   TinyRadDictJob *     incl;
+   TinyRadDictLine *    line;
+
+   TinyRadDebugTrace();
+
+   assert(pool != NULL);
+   assert(job  != NULL);
+
+   while(1)
+   {
+      // reads next line
+      if ((rc = tinyrad_file_readline(job->file, buff, sizeof(buff), &len)) < 0)
+         return(rc);
+      job->file->line++;
+      if (len == 0)
+         return(TRAD_SUCCESS);
+      if ((rc = tinyrad_strtoargs(buff, &argv, &argc)) != TRAD_SUCCESS)
+         return(rc);
+      if (argc < 1)
+      {
+         tinyrad_strsfree(argv);
+         continue;
+      };
+
+      // validates keyword
+      keyword = tinyrad_map_lookup_name(tinyrad_dict_options, argv[0], NULL);
+      if ( (!(keyword)) || ( (keyword == TRAD_DICT_KEYWORD_INCLUDE) && (argc != 2) ) )
+      {
+         tinyrad_strsfree(argv);
+         return(TRAD_ESYNTAX);
+      };
+
+      // queues included file
+      incl = NULL;
+      if (keyword == TRAD_DICT_KEYWORD_INCLUDE)
+      {
+         if ((incl = tinyrad_dict_parse_job(pool, job, argv[1])) == NULL)
+         {
+            tinyrad_strsfree(argv);
+            return(TRAD_ENOMEM);
+         };
+      };
+
+      // grows list of lines
+      if (job->lines_len >= job->lines_size)
+      {
+         size = ((job->lines_size)) ? (job->lines_size * 2) : TRAD_DICT_BULK_MIN_SIZE;
+         if ((ptr = realloc(job->lines, (sizeof(TinyRadDictLine) * size))) == NULL)
+         {
+            tinyrad_strsfree(argv);
+            return(TRAD_ENOMEM);
+         };
+         job->lines      = ptr;
+         job->lines_size = size;
+      };
+
+      line = &job->lines[job->lines_len++];
+      memset(line, 0, sizeof(TinyRadDictLine));
+      line->line     = job->file->line;
+      line->keyword  = keyword;
+      line->argc     = argc;
+      line->argv     = argv;
+      line->incl     = incl;
+   };
+
+   return(TRAD_SUCCESS);
+}
+
+
+/// Processes a dictionary keyword other than $INCLUDE
+///
+/// @param[in]  dict          dictionary reference
+/// @param[in]  keyword       keyword of line
+/// @param[in]  argc          number of arguments
+/// @param[in]  argv          arguments of line
+/// @param[in]  vendorp       pointer to vendor of current vendor block
+/// @param[in]  opts          import options
+/// @return returns error code
+static int
+tinyrad_dict_parse_keyword(
+         TinyRadDict *                dict,
+         int                          keyword,
+         int                          argc,
+         char **                      argv,
+         TinyRadDictVendor **         vendorp,
+         uint32_t                     opts )
+{
+   TinyRadDebugTrace();
+
+   assert(dict    != NULL);
+   assert(vendorp != NULL);
+
+   switch(keyword)
+   {
+      case TRAD_DICT_KEYWORD_ATTRIBUTE:
+      return(tinyrad_dict_parse_attribute(dict, argc, argv, *vendorp, opts));
+
+      case TRAD_DICT_KEYWORD_BEGIN_VENDOR:
+      return(tinyrad_dict_parse_begin_vendor(dict, argc, argv, vendorp));
+
+      case TRAD_DICT_KEYWORD_END_VENDOR:
+      return(tinyrad_dict_parse_end_vendor(dict, argc, argv, vendorp));
+
+      case TRAD_DICT_KEYWORD_VALUE:
+      return(tinyrad_dict_parse_value(dict, argc, argv, opts));
+
+      case TRAD_DICT_KEYWORD_VENDOR:
+      return(tinyrad_dict_parse_vendor(dict, argc, argv, opts));
+
+      default:
+      break;
+   };
+
+   return(TRAD_ESYNTAX);
+}
+
+
+/// Adds tokenized lines of a file and its included files to dictionary
+///
+/// @param[in]  dict          dictionary reference
+/// @param[in]  pool          worker pool reference
+/// @param[in]  job           job reference
+/// @param[in]  vendorp       pointer to vendor of current vendor block
+/// @param[out] msgsp         pointer to generated error details
+/// @param[in]  opts          import options
+/// @return returns error code
+static int
+tinyrad_dict_parse_merge(
+         TinyRadDict *                dict,
+         TinyRadDictPool *            pool,
+         TinyRadDictJob *             job,
+         TinyRadDictVendor **         vendorp,
+         char ***                     msgsp,
+         uint32_t                     opts )
+{
+   int                  rc;
+   size_t               pos;
+   TinyRadDictLine *    line;
+
+   TinyRadDebugTrace();
+
+   assert(dict != NULL);
+   assert(pool != NULL);
+   assert(job  != NULL);
+
+   // waits for worker to finish file
+   pthread_mutex_lock(&pool->mutex);
+   while(!(job->done))
+      pthread_cond_wait(&pool->cond, &pool->mutex);
+   pthread_mutex_unlock(&pool->mutex);
+
+   // reports files which could not be opened against the including line
+   if (!(job->opened))
+      return(tinyrad_file_error( ((job->file)) ? job->file : ((job->parent)) ? job->parent->file : NULL, job->rc, msgsp));
+
+   if ((rc = tinyrad_dict_add_source(dict, job->file->path, job->file->fullpath, job->mtime, job->mtime_nsec, job->size, job->depth)) != TRAD_SUCCESS)
+      return(tinyrad_file_error(job->file, rc, msgsp));
+
+   for(pos = 0; (pos < job->lines_len); pos++)
+   {
+      line = &job->lines[pos];
+      job->file->line = line->line;
+      if (line->keyword == TRAD_DICT_KEYWORD_INCLUDE)
+         rc = tinyrad_dict_parse_merge(dict, pool, line->incl, vendorp, msgsp, opts);
+      else if ((rc = tinyrad_dict_parse_keyword(dict, line->keyword, line->argc, line->argv, vendorp, opts)) != TRAD_SUCCESS)
+         tinyrad_file_error(job->file, rc, msgsp);
+      if (rc != TRAD_SUCCESS)
+         return(rc);
+   };
+
+   // reports error which stopped tokenizing
+   job->file->line = job->line;
+   if (job->rc != TRAD_SUCCESS)
+      return(tinyrad_file_error(job->file, job->rc, msgsp));
+
+   return(TRAD_SUCCESS);
+}
+
+
+/// Imports file into dictionary using worker threads to tokenize files
+///
+/// The include tree is discovered and tokenized by a pool of worker
+/// threads while the calling thread adds the tokenized lines to the
+/// dictionary in include order, duplicate and override semantics match
+/// tinyrad_dict_parse_file().
+///
+/// @param[in]  dict          dictionary reference
+/// @param[in]  path          path to import file
+/// @param[out] msgsp         pointer to generated error details
+/// @param[in]  opts          import options
+/// @return returns error code
+static int
+tinyrad_dict_parse_parallel(
+         TinyRadDict *                dict,
+         const char *                 path,
+         char ***                     msgsp,
+         uint32_t                     opts )
+{
+   int                  rc;
+   long                 cpus;
+   TinyRadDictPool      pool;
+   TinyRadDictJob *     job;
+   TinyRadDictVendor *  vendor;
+
+   TinyRadDebugTrace();
+
+   assert(dict != NULL);
+   assert(path != NULL);
+
+   // determine number of workers, a single worker still overlaps reading with merging
+   if ((cpus = sysconf(_SC_NPROCESSORS_ONLN)) < 1)
+      cpus = 1;
+   cpus = (cpus < TRAD_DICT_PARSE_THREADS) ? cpus : TRAD_DICT_PARSE_THREADS;
+
+   memset(&pool, 0, sizeof(pool));
+   pool.paths = dict->paths;
+   if ((pthread_mutex_init(&pool.mutex, NULL)))
+      return(tinyrad_error_msgs(TRAD_ENOMEM, msgsp, "out of virtual memory"));
+   if ((pthread_cond_init(&pool.cond, NULL)))
+   {
+      pthread_mutex_destroy(&pool.mutex);
+      return(tinyrad_error_msgs(TRAD_ENOMEM, msgsp, "out of virtual memory"));
+   };
+
+   // queue top level file before starting workers
+   if ((job = tinyrad_dict_parse_job(&pool, NULL, path)) == NULL)
+   {
+      tinyrad_dict_parse_pool_free(&pool);
+      return(tinyrad_error_msgs(TRAD_ENOMEM, msgsp, "out of virtual memory"));
+   };
+
+   // start workers, falls back to serial parsing if no threads are available
+   for(pool.threads_len = 0; (pool.threads_len < (size_t)cpus); pool.threads_len++)
+      if ((pthread_create(&pool.threads[pool.threads_len], NULL, &tinyrad_dict_parse_pool_worker, &pool)))
+         break;
+   if (!(pool.threads_len))
+   {
+      tinyrad_dict_parse_pool_free(&pool);
+      return(tinyrad_dict_parse_file(dict, path, msgsp, opts));
+   };
+
+   vendor = NULL;
+   rc     = tinyrad_dict_parse_merge(dict, &pool, job, &vendor, msgsp, opts);
+
+   tinyrad_dict_parse_pool_free(&pool);
+
+   if (rc == TRAD_SUCCESS)
+      tinyrad_file_error(NULL, TRAD_SUCCESS, msgsp);
+
+   return(rc);
+}
+
+
+/// Stops worker threads and frees jobs of pool
+///
+/// @param[in]  pool          worker pool reference
+static void
+tinyrad_dict_parse_pool_free(
+         TinyRadDictPool *            pool )
+{
+   size_t               pos;
+   TinyRadDictJob *     job;
+
+   TinyRadDebugTrace();
+
+   assert(pool != NULL);
+
+   pthread_mutex_lock(&pool->mutex);
+   pool->shutdown = TRAD_YES;
+   pthread_cond_broadcast(&pool->cond);
+   pthread_mutex_unlock(&pool->mutex);
+
+   for(pos = 0; (pos < pool->threads_len); pos++)
+      pthread_join(pool->threads[pos], NULL);
+
+   while((job = pool->jobs) != NULL)
+   {
+      pool->jobs = job->jobs;
+      for(pos = 0; (pos < job->lines_len); pos++)
+         tinyrad_strsfree(job->lines[pos].argv);
+      if ((job->lines))
+         free(job->lines);
+      if ((job->file))
+         tinyrad_file_destroy(job->file, TRAD_FILE_NORECURSE);
+      free(job->path);
+      free(job);
+   };
+
+   pthread_cond_destroy(&pool->cond);
+   pthread_mutex_destroy(&pool->mutex);
+
+   return;
+}
+
+
+/// Tokenizes queued jobs until pool is shut down
+///
+/// @param[in]  arg           worker pool reference
+/// @return returns NULL
+static void *
+tinyrad_dict_parse_pool_worker(
+         void *                       arg )
+{
+   int                  rc;
+   TinyRadDictPool *    pool;
+   TinyRadDictJob *     job;
+
+   TinyRadDebugTrace();
+
+   assert(arg != NULL);
+
+   pool = arg;
+
+   pthread_mutex_lock(&pool->mutex);
+   while(!(pool->shutdown))
+   {
+      if ((job = pool->queue) == NULL)
+      {
+         pthread_cond_wait(&pool->cond, &pool->mutex);
+         continue;
+      };
+      if ((pool->queue = job->next) == NULL)
+         pool->queue_tail = NULL;
+      pthread_mutex_unlock(&pool->mutex);
+
+      // file is opened only while tokenized to bound open descriptors and buffers
+      if ((rc = tinyrad_dict_parse_job_open(pool, job)) == TRAD_SUCCESS)
+         rc = tinyrad_dict_parse_job_tokenize(pool, job);
+      if ((job->file))
+         tinyrad_file_close(job->file);
+
+      pthread_mutex_lock(&pool->mutex);
+      job->rc   = rc;
+      job->line = ((job->file)) ? job->file->line : 0;
+      job->done = TRAD_YES;
+      pthread_cond_broadcast(&pool->cond);
+   };
+   pthread_mutex_unlock(&pool->mutex);
+
+   return(NULL);
+}
+
+
+/// Records file being parsed as a source of the dictionary
+///
+/// @param[in]  dict          dictionary reference
+/// @param[in]  file          file buffer reference
+/// @return returns error code
+int
+tinyrad_dict_parse_source(
+         TinyRadDict *                dict,
+         TinyRadFile *                file )
+{
+   uint32_t       depth;
+   TinyRadFile *  parent;
+   struct stat    sb;
+
+   TinyRadDebugTrace();
+
+   assert(dict != NULL);
+   assert(file != NULL);
+
+   if (fstat(file->fd, &sb) == -1)
+      return(TRAD_EACCES);
+
+   for(depth = 0, parent = file->parent; ((parent)); parent = parent->parent)
+      depth++;
+
+   return(tinyrad_dict_add_source(dict, file->path, file->fullpath, (int64_t)sb.st_mtime, (uint32_t)sb.st_mtim.tv_nsec, (int64_t)sb.st_size, depth));
+}
+
+
+int
+tinyrad_dict_parse_value(
+         TinyRadDict *                dict,
+         int                          argc,
+         char **                      argv,
+         uint32_t                     opts )
+{
+   TinyRadDictAttr *    attr;
+   TinyRadDictValue *   value;
+   uint64_t             data;
+   int                  rc;
+   char *               ptr;
+
+   TinyRadDebugTrace();
+
+   assert(dict != NULL);
+   assert(opts == 0);
+
+   if (argc == 3)
+      return(TRAD_ESYNTAX);
+   // attribute may be defined by a deferred vendor block
+   attr = tinyrad_dict_attr_lookup(dict, argv[1], NULL);
+   if ( (!(attr)) && ((atomic_load(&dict->blocks_pending))) && (tinyrad_dict_blocks_load(dict, NULL) == TRAD_SUCCESS) )
+      attr = tinyrad_dict_attr_lookup(dict, argv[1], NULL);
+   if (!(attr))
+      return(TRAD_ESYNTAX);
+   data = (uint64_t)strtoull(argv[3], &ptr, 0);
+   if ((ptr[0] != '\0') || (argv[3] == ptr))
+      return(TRAD_ESYNTAX);
+
+   if ((value = tinyrad_dict_value_alloc(dict, attr, argv[2], data)) == NULL)
+      return(TRAD_ENOMEM);
+
+   rc = tinyrad_dict_add_value(dict, attr, value);
+   tinyrad_obj_release(&value->obj);
+   return(rc);
+}
+
+
+/// Imports file into dictionary
+///
+/// @param[in]  dict          dictionary reference
+/// @param[in]  opts          import options
+/// @return returns error code
+int
+tinyrad_dict_parse_vendor(
+         TinyRadDict *                dict,
+         int                          argc,
+         char **                      argv,
+         uint32_t                     opts )
+{
+   int                     rc;
+   char *                  endptr;
+   char *                  str;
+   uint32_t                id;
+   uint8_t                 type_octs;
+   uint8_t                 len_octs;
+
+   TinyRadDictVendor *     vendor;
+
+   TinyRadDebugTrace();
+
+   assert(dict != NULL);
+   assert(opts == 0);
+
+   // checks arguments
+   if ((argc < 3) || (argc > 4))
+      return(TRAD_ESYNTAX);
+
+   // initializes flags
+   type_octs = 1;
+   len_octs  = 1;
+
+   // verifies arguments list length
+   if ((argc < 3) || (argc > 4))
+      return(TRAD_ESYNTAX);
+
+   // process vendor-id
+   id = (uint32_t)strtoul(argv[2], &endptr, 10);
+   if (endptr[0] != '\0')
+      return(TRAD_ESYNTAX);
+
+   // process flags
+   if (argc == 4)
+   {
+      // initial string checks
+      if (!(strcmp("format=", argv[3])))
+         return(TRAD_ESYNTAX);
+      str = strchr(argv[3], '=');
+      str++;
+
+      // parse type length
+      type_octs = (uint8_t)strtoul(str, &endptr, 10);
+      if (endptr == str)
+         return(TRAD_ESYNTAX);
+      if (endptr[0] != ',')
+         return(TRAD_ESYNTAX);
+      str = &endptr[1];
+      if ( (type_octs != 1) && (type_octs != 2) && (type_octs != 4) )
+         return(TRAD_ESYNTAX);
+
+      // parse value length
+      len_octs = (uint8_t)strtoul(str, &endptr, 10);
+      if (endptr == str)
+         return(TRAD_ESYNTAX);
+      if (endptr[0] != '\0')
+         return(TRAD_ESYNTAX);
+      if (len_octs > 2)
+         return(TRAD_ESYNTAX);
+   };
+
+   // initialize vendor struct
+   if ((vendor = tinyrad_dict_vendor_alloc(dict, argv[1], id, type_octs, len_octs)) == NULL)
+      return(TRAD_ENOMEM);
+   rc = tinyrad_dict_add_vendor(dict, vendor);
+   tinyrad_obj_release(&vendor->obj);
+   return(rc);
+}
+
+
+//----------------------------//
+// dictionary print functions //
+//----------------------------//
+#pragma mark dictionary print functions
+
+/// Writes dictionary as C source of static definition tables
+///
+/// The tables are written in the order of the dictionary's sorted lists
+/// (vendors by ID, attributes by vendor and type, values by attribute and
+/// data) so tinyrad_dict_import() loads them into already sorted lists.
+/// Duplicate definitions keep their relative order, so the imported
+/// dictionary resolves duplicates the same way as the source dictionary.
+///
+/// @param[in]  dict          dictionary reference
+/// @param[in]  file          output file, or NULL for standard output
+/// @param[in]  prefix        prefix of table names
+/// @return returns error code
+int
+tinyrad_dict_compile(
+         TinyRadDict *                 dict,
+         const char *                  file,
+         const char *                  prefix )
+{
+   size_t               pos;
+   int                  rc;
+   FILE *               fs;
+   const char *         str;
+   TinyRadDictAttr *    attr;
+   TinyRadDictValue *   value;
+   TinyRadDictVendor *  vendor;
+
+   TinyRadDebugTrace();
+
+   assert(dict != NULL);
+
+   prefix = ((prefix)) ? prefix : "tinyrad_dict_compiled";
+
+   if ((rc = tinyrad_dict_blocks_load(dict, NULL)) != TRAD_SUCCESS)
+      return(rc);
+
+   // verify attributes are representable by TinyRadDictAttrDef
+   for(pos = 0; (pos < dict->attrs_type_len); pos++)
+   {
+      attr = dict->attrs_type[pos];
+      if (attr->oid->oid_len == 1)
+         continue;
+      if ( (attr->oid->oid_len == 3) && (attr->oid->oid_val[0] == TRAD_ATTR_VENDOR_SPECIFIC) )
+         continue;
+      return(TRAD_EATTRIBUTE);
+   };
+
+   if (!(file))
+      fs = stdout;
+   else if ((fs = fopen(file, "w")) == NULL)
+      return( (errno == ENOENT) ? TRAD_ENOENT : TRAD_EACCES );
+
+   fprintf(fs, "/*\n");
+   fprintf(fs, " *  dictionary compiled with %s (%s)\n", PACKAGE_NAME, PACKAGE_VERSION);
+   fprintf(fs, " *\n");
+   fprintf(fs, " *  Load with:\n");
+   fprintf(fs, " *     tinyrad_dict_import(dict, %s_vendors, %s_attrs, %s_values, &msgs);\n", prefix, prefix, prefix);
+   fprintf(fs, " */\n");
+   fprintf(fs, "#include <stddef.h>\n");
+   fprintf(fs, "#include <tinyrad.h>\n");
+   fprintf(fs, "\n\n");
+
+   // write vendor definitions
+   fprintf(fs, "const TinyRadDictVendorDef %s_vendors[] =\n{\n", prefix);
+   for(pos = 0; (pos < dict->vendors_id_len); pos++)
+   {
+      vendor = dict->vendors_id[pos];
+      fprintf(fs, "   { ");
+      tinyrad_dict_compile_str(fs, vendor->name, 31);
+      fprintf(fs, " %10" PRIu32 ", %" PRIu8 ", %" PRIu8 " },\n", vendor->id, vendor->type_octs, vendor->len_octs);
+   };
+   fprintf(fs, "   { NULL, 0, 0, 0 }\n};\n\n\n");
+
+   // write attribute definitions
+   fprintf(fs, "const TinyRadDictAttrDef %s_attrs[] =\n{\n", prefix);
+   for(pos = 0; (pos < dict->attrs_type_len); pos++)
+   {
+      attr = dict->attrs_type[pos];
+      str  = tinyrad_map_lookup_value(tinyrad_dict_data_type, attr->data_type, NULL);
+      fprintf(fs, "   { ");
+      tinyrad_dict_compile_str(fs, attr->name, 31);
+      fprintf(fs, " %3" PRIu8 ", %10" PRIu32 ", %5" PRIu32 ", %3" PRIu8 ", 0x%04" PRIx32 " },", __attr_type(attr), __attr_vendor_id(attr), __attr_vendor_type(attr), attr->data_type, attr->flags);
+      fprintf(fs, "  // %s\n", ((str)) ? str : "unknown");
+   };
+   fprintf(fs, "   { NULL, 0, 0, 0, 0, 0 }\n};\n\n\n");
+
+   // write value definitions
+   fprintf(fs, "const TinyRadDictValueDef %s_values[] =\n{\n", prefix);
+   for(pos = 0; (pos < dict->values_data_len); pos++)
+   {
+      value = dict->values_data[pos];
+      fprintf(fs, "   { ");
+      tinyrad_dict_compile_str(fs, value->attr->name, 31);
+      fprintf(fs, " ");
+      tinyrad_dict_compile_str(fs, value->name, 31);
+      fprintf(fs, " %" PRIu64 "%s },\n", value->data, ((value->data > INT64_MAX) ? "ULL" : ""));
+   };
+   fprintf(fs, "   { NULL, NULL, 0 }\n};\n\n");
+   fprintf(fs, "/* end of source */\n");
+
+   rc = (ferror(fs)) ? TRAD_EACCES : TRAD_SUCCESS;
+   if (fs != stdout)
+      if (fclose(fs) != 0)
+         rc = TRAD_EACCES;
+
+   return(rc);
+}
+
+
+/// Writes quoted C string literal followed by a comma
+///
+/// @param[in]  fs            output stream
+/// @param[in]  str           string to quote
+/// @param[in]  width         minimum width of quoted string and comma
+static void
+tinyrad_dict_compile_str(
+         FILE *                        fs,
+         const char *                  str,
+         int                           width )
+{
+   int         len;
+
+   fputc('"', fs);
+   for(len = 3; ((*str)); str++, len++)
+   {
+      if ( (*str == '"') || (*str == '\\') )
+      {
+         fputc('\\', fs);
+         len++;
+      };
+      fputc(*str, fs);
+   };
+   fputs("\",", fs);
+   for(; (len < width); len++)
+      fputc(' ', fs);
+
+   return;
+}
+
+
+void
+tinyrad_dict_print(
+         TinyRadDict *                 dict,
+         uint32_t                      opts )
+{
+   size_t            pos;
+
+   TinyRadDebugTrace();
+
+   assert(dict   != NULL);
+   assert(opts   != 0);
+
+   tinyrad_dict_blocks_load(dict, NULL);
+
+   printf("# dictionary processed with %s (%s)\n", PACKAGE_NAME, PACKAGE_VERSION);
+   printf("#\n");
+
+   // print attribute definitions
+   for(pos = 0; (pos < dict->attrs_type_len); pos ++)
+   {
+      if ((__attr_vendor_id(dict->attrs_type[pos])))
+         continue;
+      if ( ((pos + 1) < dict->attrs_type_len) && (!(tinyrad_oid_cmp(&dict->attrs_type[pos+1]->oid, &dict->attrs_type[pos]->oid))) )
+         continue;
+      tinyrad_dict_print_attribute(dict, pos);
+   };
+
+   // print vendor definitions
+   for(pos = 0; (pos < dict->vendors_id_len); pos++)
+   {
+      if ( ((pos + 1) < dict->vendors_id_len) && (dict->vendors_id[pos]->id == dict->vendors_id[pos+1]->id) )
+         continue;
+      tinyrad_dict_print_vendor(dict, pos);
+   };
+
+   printf("\n");
+   printf("# end of processed dictionary\n");
+
+   return;
+}
+
+
+void
+tinyrad_dict_print_attribute(
+         TinyRadDict *                 dict,
+         size_t                        attr_idx )
+{
+   size_t               pos;
+   size_t               flags;
+   char                 flagstr[128];
+   char                 datatype[32];
+   const char *         str;
+   ssize_t              value_idx;
+   TinyRadDictAttr *    attr;
+
+   TinyRadDebugTrace();
+
+   assert(dict     != NULL);
+   assert(attr_idx  < dict->attrs_type_len);
+
+   attr = dict->attrs_type[attr_idx];
+
+   flags      = 0;
+   flagstr[0] = '\0';
+   for(pos = 0; ((tinyrad_dict_attr_flags[pos].map_name)); pos++)
+   {
+      if ((attr->flags & tinyrad_dict_attr_flags[pos].map_value) != 0)
+      {
+         strncat(flagstr, (((flags)) ? "," : " "), (sizeof(flagstr)-strlen(flagstr)-1));
+         strncat(flagstr, tinyrad_dict_attr_flags[pos].map_name, (sizeof(flagstr)-strlen(flagstr)-1));
+         flags++;
+      };
+   };
+
+   str = tinyrad_map_lookup_value(tinyrad_dict_data_type, attr->data_type, NULL);
+   str = ((str)) ? str : "unknown";
+   for(pos = 0; ((str[pos])); pos++)
+      datatype[pos] = ((str[pos] >= 'A')&&(str[pos] <= 'Z')) ? (str[pos] - 'A' + 'a') : str[pos];
+   datatype[pos] = '\0';
+
+   printf("ATTRIBUTE     %-31s %-21" PRIu32 " %s%s\n", attr->name, (((__attr_vendor_id(attr))) ? __attr_vendor_type(attr) : __attr_type(attr)), datatype, flagstr);
+
+   if ((value_idx = tinyrad_dict_value_index(dict, NULL, attr->oid, 0, TRAD_YES)) < 0)
+      return;
+
+   tinyrad_dict_print_value(dict, value_idx);
+
+   return;
+}
+
+
+void
+tinyrad_dict_print_value(
+         TinyRadDict *                 dict,
+         size_t                        value_idx )
+{
+   size_t               pos;
+   ssize_t              attr_idx;
+   TinyRadDictKey       key;
+   TinyRadDictAttr *    attr;
+   TinyRadDictValue *   value;
+
+   TinyRadDebugTrace();
+
+   assert(dict     != NULL);
+   assert(value_idx  < dict->values_data_len);
+
+   value = dict->values_data[value_idx];
+   memset(&key, 0, sizeof(key));
+   key.oid           = value->attr->oid;
+
+   for(pos = value_idx; ((pos > 0) && (!(tinyrad_dict_value_cmp_key_attr(&dict->values_data[pos-1], &key)))); pos--);
+   value_idx = pos;
+
+   if ((attr_idx = tinyrad_dict_attr_index(dict, NULL, value->attr->oid, TRAD_NO)) < 0)
+      return;
+   attr = dict->attrs_type[attr_idx];
+
+   printf("\n# %s Values\n", attr->name);
+   for(pos = value_idx; ((pos < dict->values_data_len) && (!(tinyrad_dict_value_cmp_key_attr(&dict->values_data[pos], &key)))); pos++)
+   {
+      value = dict->values_data[pos];
+      printf("VALUE         %-31s %-21s %" PRIu64 "\n", attr->name, value->name, value->data );
+   };
+   printf("\n");
+
+   return;
+}
+
+
+void
+tinyrad_dict_print_vendor(
+         TinyRadDict *                 dict,
+         size_t                        vendor_idx )
+{
+   size_t                  pos;
+   ssize_t                 idx;
+   char                    vendorstr[128];
+   TinyRadOID              oid;
+   TinyRadDictVendor *     vendor;
+
+   TinyRadDebugTrace();
+
+   assert(dict       != NULL);
+   assert(vendor_idx  < dict->vendors_id_len);
+
+   vendor = dict->vendors_id[vendor_idx];
+
+   for(pos = vendor_idx; ((pos > 0) && (dict->vendors_id[pos-1]->id == vendor->id)); pos--);
+   vendor_idx = pos;
+
+   snprintf(vendorstr, sizeof(vendorstr), "%s VSA's", vendor->name);
+   printf("\n");
+   printf("##############################################################################\n");
+   printf("#                                                                            #\n");
+   printf("#   %-70s   #\n", vendorstr);
+   printf("#                                                                            #\n");
+   printf("##############################################################################\n");
+   printf("\n");
+
+   // print vendor definition
+   for(pos = vendor_idx; ((pos < dict->vendors_id_len) && (dict->vendors_id[pos]->id == vendor->id)); pos++)
+   {
+      if ( (vendor->len_octs != 1) || (vendor->type_octs != 1) )
+         printf("VENDOR        %-31s %-21" PRIu32 " format=%" PRIu8 ",%" PRIu8 "\n", dict->vendors_id[pos]->name, vendor->id, vendor->type_octs, vendor->len_octs);
+      else
+         printf("VENDOR        %-31s %" PRIu32 "\n", dict->vendors_id[pos]->name, vendor->id);
+   };
+   printf("\n");
+
+   oid.oid_val[0] = TRAD_ATTR_VENDOR_SPECIFIC;
+   oid.oid_val[1] = vendor->id;
+   oid.oid_val[2] = 0;
+   oid.oid_len    = 3;
+   if ((idx = tinyrad_dict_attr_index(dict, NULL, &oid, TRAD_YES)) < 0)
+      return;
+
+   printf("BEGIN-VENDOR  %s\n\n", vendor->name);
+   for(pos = ((size_t)idx); ((pos < dict->attrs_type_len) && (__attr_vendor_id(dict->attrs_type[pos]) == vendor->id)); pos++)
+      tinyrad_dict_print_attribute(dict, pos);
+   printf("\nEND-VENDOR    %s\n\n", vendor->name);
+
+   return;
+}
+
+
+//----------------------------//
+// dictionary stats functions //
+//----------------------------//
+#pragma mark dictionary stats functions
+
+/// Calculates bytes used by hash table slots
+///
+/// @param[in]  hash          hash table reference
+/// @return returns size of hash table in bytes
+static size_t
+__dict_stats_hash(
+         const TinyRadDictHash *       hash )
+{
+   return(hash->size * sizeof(TinyRadDictSlot));
+}
+
+
+/// Updates lookup counters of dictionary
+///
+/// Counters are only updated if the dictionary was initialized with
+/// TRAD_DICT_STATS, so lookups do not contend on shared counters by default.
+/// Counters are updated with relaxed ordering, they are statistics and do
+/// not order any other memory access.
+///
+/// @param[in]  dict          dictionary passed to the public lookup
+/// @param[in]  obj           result of lookup
+/// @param[in]  probes        value of tinyrad_dict_probes before lookup
+static void
+__dict_stats_lookup(
+         TinyRadDict *                 dict,
+         const void *                  obj,
+         uint64_t                      probes )
+{
+   if (!(dict->opts & TRAD_DICT_STATS))
+      return;
+   atomic_fetch_add_explicit(&dict->stats_lookups, 1, memory_order_relaxed);
+   if (!(obj))
+      atomic_fetch_add_explicit(&dict->stats_misses, 1, memory_order_relaxed);
+   if ((probes = tinyrad_dict_probes - probes) != 0)
+      atomic_fetch_add_explicit(&dict->stats_probes, probes, memory_order_relaxed);
+   return;
+}
+
+
+/// Reports object counts, memory used by indexes, and lookup counters
+///
+/// Objects and indexes of base dictionaries are not included, lookups are
+/// counted against the dictionary passed to the lookup function.
+///
+/// @param[in]  dict          dictionary reference
+/// @param[out] stats         dictionary statistics
+static void
+tinyrad_dict_stats(
+         TinyRadDict *                 dict,
+         TinyRadDictStats *            stats )
+{
+   size_t                  pos;
+   TinyRadDictVendor *     vendor;
+   TinyRadDictAttr *       attr;
+   TinyRadDictStrBlock *   block;
+
+   TinyRadDebugTrace();
+
+   assert(dict  != NULL);
+   assert(stats != NULL);
+
+   memset(stats, 0, sizeof(TinyRadDictStats));
+
+   stats->vendors       = dict->vendors_id_len;
+   stats->attrs         = dict->attrs_type_len;
+   stats->values        = dict->values_data_len;
+   stats->sources       = dict->sources_len;
+
+   stats->objs_bytes    = dict->vendors_id_len  * sizeof(TinyRadDictVendor);
+   stats->objs_bytes   += dict->attrs_type_len  * (sizeof(TinyRadDictAttr) + sizeof(TinyRadOID));
+   stats->objs_bytes   += dict->values_data_len * sizeof(TinyRadDictValue);
+   stats->objs_bytes   += dict->sources_len     * sizeof(TinyRadDictSource);
+
+   stats->lists_bytes   = dict->attrs_name_len   * sizeof(TinyRadDictAttr *);
+   stats->lists_bytes  += dict->attrs_type_len   * sizeof(TinyRadDictAttr *);
+   stats->lists_bytes  += dict->values_data_len  * sizeof(TinyRadDictValue *);
+   stats->lists_bytes  += dict->values_name_len  * sizeof(TinyRadDictValue *);
+   stats->lists_bytes  += dict->vendors_id_len   * sizeof(TinyRadDictVendor *);
+   stats->lists_bytes  += dict->vendors_name_len * sizeof(TinyRadDictVendor *);
+
+   stats->hashes_bytes  = __dict_stats_hash(&dict->attrs_name_hash);
+   stats->hashes_bytes += __dict_stats_hash(&dict->attrs_type_hash);
+   stats->hashes_bytes += __dict_stats_hash(&dict->values_data_hash);
+   stats->hashes_bytes += __dict_stats_hash(&dict->values_name_hash);
+   stats->hashes_bytes += __dict_stats_hash(&dict->vendors_id_hash);
+   stats->hashes_bytes += __dict_stats_hash(&dict->vendors_name_hash);
+
+   for(pos = 0; (pos < dict->vendors_id_len); pos++)
+   {
+      vendor                = dict->vendors_id[pos];
+      stats->vendors_bytes += vendor->attrs_len * sizeof(TinyRadDictAttr *);
+      stats->vendors_bytes += __dict_stats_hash(&vendor->attrs_hash);
+   };
+
+   for(pos = 0; (pos < dict->attrs_type_len); pos++)
+   {
+      attr                  = dict->attrs_type[pos];
+      stats->values_bytes  += attr->values_len * sizeof(TinyRadDictValue *);
+   };
+
+   stats->names_bytes   = tinyrad_dict_trie_size(dict->attrs_name_trie);
+
+   if ((dict->strpool))
+   {
+      for(block = dict->strpool->blocks; ((block)); block = block->next)
+      {
+         stats->strpool_bytes += sizeof(TinyRadDictStrBlock) + block->size;
+         stats->strpool_used  += block->used;
+      };
+      stats->strpool_strings  = dict->strpool->index.count;
+      stats->hashes_bytes    += __dict_stats_hash(&dict->strpool->index);
+   };
+
+   stats->lookups       = atomic_load_explicit(&dict->stats_lookups, memory_order_relaxed);
+   stats->lookup_misses = atomic_load_explicit(&dict->stats_misses,  memory_order_relaxed);
+   stats->lookup_probes = atomic_load_explicit(&dict->stats_probes,  memory_order_relaxed);
 
-   if ((attr = tinyrad_dict_attr_alloc(dict, argv[1], &oid, data_type, flags)) == NULL)
-      return(TRAD_ENOMEM);
-   rc = tinyrad_dict_add_attr(dict, attr);
-   tinyrad_obj_release(&attr->obj);
-   return(rc);
+   return;
 }
 
 
-int
-tinyrad_dict_parse_begin_vendor(
-         TinyRadDict *                dict,
-         int                          argc,
-         char **                      argv,
-         TinyRadDictVendor **         vendorp )
-{
-   TinyRadDebugTrace();
-
-   assert(dict    != NULL);
-   assert(vendorp != NULL);
-
-   if (argc != 2)
-      return(TRAD_ESYNTAX);
-   if ((*vendorp))
-      return(TRAD_ESYNTAX);
-   if ((*vendorp = tinyrad_dict_vendor_lookup(dict, argv[1], 0)) == NULL)
-      return(TRAD_ESYNTAX);
+//-----------------------------//
+// dictionary string functions //
+//-----------------------------//
+#pragma mark dictionary string functions
 
-   return(TRAD_SUCCESS);
+/// Retrieves header of string interned by dictionary string pool
+///
+/// @param[in]  str           interned string
+/// @return returns string header
+static const TinyRadDictStr *
+__dict_str(
+         const char *                  str )
+{
+   assert(str != NULL);
+   return((const TinyRadDictStr *)(const void *)(str - offsetof(TinyRadDictStr, str)));
 }
 
 
-int
-tinyrad_dict_parse_end_vendor(
-         TinyRadDict *                dict,
-         int                          argc,
-         char **                      argv,
-         TinyRadDictVendor **         vendorp )
+TinyRadDictStrPool *
+tinyrad_dict_strpool_alloc(
+         void )
 {
+   TinyRadDictStrPool *    pool;
    TinyRadDebugTrace();
+   if ((pool = tinyrad_obj_alloc(sizeof(TinyRadDictStrPool), (void(*)(void*))&tinyrad_dict_strpool_free)) == NULL)
+      return(NULL);
+   return(tinyrad_obj_retain(&pool->obj));
+}
 
-   assert(dict    != NULL);
-   assert(vendorp != NULL);
-
-   if (argc != 2)
-      return(TRAD_ESYNTAX);
-   if (!(*vendorp))
-      return(TRAD_ESYNTAX);
-   if ((strcasecmp((*vendorp)->name, argv[1])))
-      return(TRAD_ESYNTAX);
-
-   *vendorp = NULL;
 
-   return(TRAD_SUCCESS);
+int
+tinyrad_dict_strpool_cmp_key(
+         const void *                  ptr,
+         const void *                  key )
+{
+   const TinyRadDictStr * const *   obj = ptr;
+   const char *                     dat = key;
+   return(strcmp((*obj)->str, dat));
 }
 
 
-int
-tinyrad_dict_parse_include(
-         TinyRadDict *                dict,
-         int                          argc,
-         char **                      argv,
-         TinyRadFile **               filep )
+void
+tinyrad_dict_strpool_free(
+         TinyRadDictStrPool *          pool )
 {
-   int            rc;
-   TinyRadFile *  incl;
+   TinyRadDictStrBlock *   block;
 
    TinyRadDebugTrace();
 
-   assert(dict  != NULL);
-   assert(filep != NULL);
-
-   if (argc != 2)
-      return(TRAD_ESYNTAX);
+   if (!(pool))
+      return;
 
-   if ((rc = tinyrad_file_init(&incl, argv[1], dict->paths, *filep)) != TRAD_SUCCESS)
+   while((block = pool->blocks) != NULL)
    {
-      *filep = ((incl)) ? incl : *filep;
-      return(rc);
+      pool->blocks = block->next;
+      free(block);
    };
 
-   *filep = incl;
+   tinyrad_dict_hash_free(&pool->index);
 
-   return(TRAD_SUCCESS);
+   memset(pool, 0, sizeof(TinyRadDictStrPool));
+   free(pool);
+
+   return;
 }
 
 
-int
-tinyrad_dict_parse_value(
-         TinyRadDict *                dict,
-         int                          argc,
-         char **                      argv,
-         uint32_t                     opts )
+/// Stores string in dictionary string pool
+///
+/// Strings are packed into large blocks along with their length and
+/// case-folded hash.  Identical strings are stored once, so names shared by
+/// many values (e.g. "Enabled") consume a single copy.
+///
+/// @param[in]  pool          dictionary string pool
+/// @param[in]  str           string to intern
+/// @return returns interned string or NULL on error
+char *
+tinyrad_dict_strpool_intern(
+         TinyRadDictStrPool *          pool,
+         const char *                  str )
 {
-   TinyRadDictAttr *    attr;
-   TinyRadDictValue *   value;
-   uint64_t             data;
-   int                  rc;
-   char *               ptr;
+   size_t                  len;
+   size_t                  size;
+   size_t                  bsize;
+   uint64_t                hval;
+   TinyRadDictStr *        rec;
+   TinyRadDictStrBlock *   block;
 
    TinyRadDebugTrace();
 
-   assert(dict != NULL);
-   assert(opts == 0);
+   assert(pool != NULL);
+   assert(str  != NULL);
 
-   if (argc == 3)
-      return(TRAD_ESYNTAX);
-   if ((attr = tinyrad_dict_attr_lookup(dict, argv[1], NULL)) == NULL)
-      return(TRAD_ESYNTAX);
-   data = (uint64_t)strtoull(argv[3], &ptr, 0);
-   if ((ptr[0] != '\0') || (argv[3] == ptr))
-      return(TRAD_ESYNTAX);
+   hval = __hash_str(TRAD_DICT_HASH_SEED, str);
+   if ((rec = tinyrad_dict_hash_lookup(&pool->index, hval, str, &tinyrad_dict_strpool_cmp_key)) != NULL)
+      return(rec->str);
 
-   if ((value = tinyrad_dict_value_alloc(dict, attr, argv[2], data)) == NULL)
-      return(TRAD_ENOMEM);
+   // records are padded to keep headers aligned
+   len  = strlen(str);
+   size = (sizeof(TinyRadDictStr) + len + 1 + 7) & ~((size_t)7);
+   if ( (!(pool->blocks)) || ((pool->blocks->size - pool->blocks->used) < size) )
+   {
+      bsize = (size > TRAD_DICT_STRPOOL_BLOCK) ? size : TRAD_DICT_STRPOOL_BLOCK;
+      if ((block = malloc(sizeof(TinyRadDictStrBlock) + bsize)) == NULL)
+         return(NULL);
+      block->next  = pool->blocks;
+      block->size  = bsize;
+      block->used  = 0;
+      pool->blocks = block;
+   };
 
-   rc = tinyrad_dict_add_value(dict, attr, value);
-   tinyrad_obj_release(&value->obj);
-   return(rc);
+   block       = pool->blocks;
+   rec         = (TinyRadDictStr *)(void *)&block->data[block->used];
+   rec->hash   = hval;
+   rec->len    = (uint32_t)len;
+   rec->pad32  = 0;
+   memcpy(rec->str, str, len+1);
+
+   if (tinyrad_dict_hash_add(&pool->index, hval, rec, rec->str, &tinyrad_dict_strpool_cmp_key) != TRAD_SUCCESS)
+      return(NULL);
+   block->used += size;
+
+   return(rec->str);
 }
 
 
-/// Imports file into dictionary
+//---------------------------//
+// dictionary trie functions //
+//---------------------------//
+#pragma mark dictionary trie functions
+
+/// Locates child of trie node whose label begins with case-folded byte
 ///
-/// @param[in]  dict          dictionary reference
-/// @param[in]  opts          import options
-/// @return returns error code
-int
-tinyrad_dict_parse_vendor(
-         TinyRadDict *                dict,
-         int                          argc,
-         char **                      argv,
-         uint32_t                     opts )
+/// The first byte of each child's label is kept inline in the parent, so the
+/// search does not dereference child nodes.
+///
+/// @param[in]  node          trie node
+/// @param[in]  c             case-folded byte
+/// @return returns index of matching child, or index at which it belongs
+static size_t
+__trie_child(
+         const TinyRadDictTrie *       node,
+         unsigned char                 c )
 {
-   int                     rc;
-   char *                  endptr;
-   char *                  str;
-   uint32_t                id;
-   uint8_t                 type_octs;
-   uint8_t                 len_octs;
-
-   TinyRadDictVendor *     vendor;
-
-   TinyRadDebugTrace();
+   size_t      low;
+   size_t      high;
+   size_t      mid;
 
-   assert(dict != NULL);
-   assert(opts == 0);
+   low  = 0;
+   high = node->children_len;
+   while(low < high)
+   {
+      mid = (low + high) / 2;
+      if (node->keys[mid] < c)
+         low = mid + 1;
+      else
+         high = mid;
+   };
 
-   // checks arguments
-   if ((argc < 3) || (argc > 4))
-      return(TRAD_ESYNTAX);
+   return(low);
+}
 
-   // initializes flags
-   type_octs = 1;
-   len_octs  = 1;
 
-   // verifies arguments list length
-   if ((argc < 3) || (argc > 4))
-      return(TRAD_ESYNTAX);
+static unsigned char
+__trie_fold(
+         unsigned char                 c )
+{
+   return( ( (c >= 'A') && (c <= 'Z') ) ? (c | 0x20) : c );
+}
 
-   // process vendor-id
-   id = (uint32_t)strtoul(argv[2], &endptr, 10);
-   if (endptr[0] != '\0')
-      return(TRAD_ESYNTAX);
 
-   // process flags
-   if (argc == 4)
-   {
-      // initial string checks
-      if (!(strcmp("format=", argv[3])))
-         return(TRAD_ESYNTAX);
-      str = strchr(argv[3], '=');
-      str++;
+/// Allocates trie node with case-folded copy of label
+///
+/// @param[in]  label         edge label
+/// @param[in]  len           length of label
+/// @return returns trie node or NULL on error
+static TinyRadDictTrie *
+tinyrad_dict_trie_alloc(
+         const char *                  label,
+         size_t                        len )
+{
+   size_t               pos;
+   TinyRadDictTrie *    node;
 
-      // parse type length
-      type_octs = (uint8_t)strtoul(str, &endptr, 10);
-      if (endptr == str)
-         return(TRAD_ESYNTAX);
-      if (endptr[0] != ',')
-         return(TRAD_ESYNTAX);
-      str = &endptr[1];
-      if ( (type_octs != 1) && (type_octs != 2) && (type_octs != 4) )
-         return(TRAD_ESYNTAX);
+   if ((node = malloc(sizeof(TinyRadDictTrie) + len + 1)) == NULL)
+      return(NULL);
+   memset(node, 0, sizeof(TinyRadDictTrie));
 
-      // parse value length
-      len_octs = (uint8_t)strtoul(str, &endptr, 10);
-      if (endptr == str)
-         return(TRAD_ESYNTAX);
-      if (endptr[0] != '\0')
-         return(TRAD_ESYNTAX);
-      if (len_octs > 2)
-         return(TRAD_ESYNTAX);
-   };
+   for(pos = 0; (pos < len); pos++)
+      node->label[pos] = (char)__trie_fold((unsigned char)label[pos]);
+   node->label[len] = '\0';
+   node->len        = len;
 
-   // initialize vendor struct
-   if ((vendor = tinyrad_dict_vendor_alloc(dict, argv[1], id, type_octs, len_octs)) == NULL)
-      return(TRAD_ENOMEM);
-   rc = tinyrad_dict_add_vendor(dict, vendor);
-   tinyrad_obj_release(&vendor->obj);
-   return(rc);
+   return(node);
 }
 
 
-//----------------------------//
-// dictionary print functions //
-//----------------------------//
-#pragma mark dictionary print functions
-
-void
-tinyrad_dict_print(
-         TinyRadDict *                 dict,
-         uint32_t                      opts )
+/// Builds attribute name trie used by prefix queries of frozen dictionaries
+///
+/// @param[in]  dict          dictionary reference
+/// @return returns error code
+static int
+tinyrad_dict_trie_build(
+         TinyRadDict *                 dict )
 {
-   size_t            pos;
+   int                  rc;
+   size_t               pos;
+   TinyRadDictAttr *    attr;
 
    TinyRadDebugTrace();
 
-   assert(dict   != NULL);
-   assert(opts   != 0);
-
-   printf("# dictionary processed with %s (%s)\n", PACKAGE_NAME, PACKAGE_VERSION);
-   printf("#\n");
+   assert(dict != NULL);
 
-   // print attribute definitions
-   for(pos = 0; (pos < dict->attrs_type_len); pos ++)
-   {
-      if ((__attr_vendor_id(dict->attrs_type[pos])))
-         continue;
-      if ( ((pos + 1) < dict->attrs_type_len) && (!(tinyrad_oid_cmp(&dict->attrs_type[pos+1]->oid, &dict->attrs_type[pos]->oid))) )
-         continue;
-      tinyrad_dict_print_attribute(dict, pos);
-   };
+   tinyrad_dict_trie_free(dict->attrs_name_trie);
+   dict->attrs_name_trie = NULL;
 
-   // print vendor definitions
-   for(pos = 0; (pos < dict->vendors_id_len); pos++)
+   for(pos = 0; (pos < dict->attrs_name_len); pos++)
    {
-      if ( ((pos + 1) < dict->vendors_id_len) && (dict->vendors_id[pos]->id == dict->vendors_id[pos+1]->id) )
+      attr = dict->attrs_name[pos];
+      if (!(attr->name))
          continue;
-      tinyrad_dict_print_vendor(dict, pos);
+      rc = tinyrad_dict_trie_insert(&dict->attrs_name_trie, attr->name, attr);
+      if ( (rc != TRAD_SUCCESS) && (rc != TRAD_EEXISTS) )
+      {
+         tinyrad_dict_trie_free(dict->attrs_name_trie);
+         dict->attrs_name_trie = NULL;
+         return(rc);
+      };
    };
 
-   printf("\n");
-   printf("# end of processed dictionary\n");
-
-   return;
+   return(TRAD_SUCCESS);
 }
 
 
-void
-tinyrad_dict_print_attribute(
-         TinyRadDict *                 dict,
-         size_t                        attr_idx )
-{
-   size_t               pos;
-   size_t               flags;
-   char                 flagstr[128];
-   char                 datatype[32];
-   const char *         str;
-   ssize_t              value_idx;
-   TinyRadDictAttr *    attr;
-
-   TinyRadDebugTrace();
-
-   assert(dict     != NULL);
-   assert(attr_idx  < dict->attrs_type_len);
-
-   attr = dict->attrs_type[attr_idx];
+/// Retrieves trie node matching key
+///
+/// Each byte of the key is case-folded and compared once.  If prefix is
+/// TRAD_YES, the key may end within the label of a node, and the node whose
+/// subtree contains every key beginning with the prefix is returned.
+///
+/// @param[in]  trie          root of trie
+/// @param[in]  key           key to search for
+/// @param[in]  prefix        TRAD_YES to match keys beginning with key
+/// @return returns matching node or NULL if not found
+static const TinyRadDictTrie *
+tinyrad_dict_trie_find(
+         const TinyRadDictTrie *       trie,
+         const char *                  key,
+         int                           prefix )
+{
+   size_t                  pos;
+   unsigned char           c;
+   const TinyRadDictTrie * node;
 
-   flags      = 0;
-   flagstr[0] = '\0';
-   for(pos = 0; ((tinyrad_dict_attr_flags[pos].map_name)); pos++)
+   for(node = trie; ( ((node)) && ((*key)) ); key += node->len)
    {
-      if ((attr->flags & tinyrad_dict_attr_flags[pos].map_value) != 0)
+      c   = __trie_fold((unsigned char)key[0]);
+      pos = __trie_child(node, c);
+      if ( (pos >= node->children_len) || (node->keys[pos] != c) )
+         return(NULL);
+      node = node->children[pos];
+
+      for(pos = 1; (pos < node->len); pos++)
       {
-         strncat(flagstr, (((flags)) ? "," : " "), (sizeof(flagstr)-strlen(flagstr)-1));
-         strncat(flagstr, tinyrad_dict_attr_flags[pos].map_name, (sizeof(flagstr)-strlen(flagstr)-1));
-         flags++;
+         if (!(key[pos]))
+            return( (prefix == TRAD_YES) ? node : NULL );
+         if (__trie_fold((unsigned char)key[pos]) != (unsigned char)node->label[pos])
+            return(NULL);
       };
    };
 
-   str = tinyrad_map_lookup_value(tinyrad_dict_data_type, attr->data_type, NULL);
-   str = ((str)) ? str : "unknown";
-   for(pos = 0; ((str[pos])); pos++)
-      datatype[pos] = ((str[pos] >= 'A')&&(str[pos] <= 'Z')) ? (str[pos] - 'A' + 'a') : str[pos];
-   datatype[pos] = '\0';
+   return(node);
+}
 
-   printf("ATTRIBUTE     %-31s %-21" PRIu32 " %s%s\n", attr->name, (((__attr_vendor_id(attr))) ? __attr_vendor_type(attr) : __attr_type(attr)), datatype, flagstr);
 
-   if ((value_idx = tinyrad_dict_value_index(dict, NULL, attr->oid, 0, TRAD_YES)) < 0)
+static void
+tinyrad_dict_trie_free(
+         TinyRadDictTrie *             trie )
+{
+   size_t      pos;
+
+   if (!(trie))
       return;
 
-   tinyrad_dict_print_value(dict, value_idx);
+   for(pos = 0; (pos < trie->children_len); pos++)
+      tinyrad_dict_trie_free(trie->children[pos]);
+   free(trie->children);
+   free(trie->keys);
+   free(trie);
 
    return;
 }
 
 
-void
-tinyrad_dict_print_value(
-         TinyRadDict *                 dict,
-         size_t                        value_idx )
+/// Adds object to trie
+///
+/// Edges are split where keys diverge, so every node other than the root
+/// has a non-empty label and no two children begin with the same byte.
+///
+/// @param[in]  triep         pointer to root of trie
+/// @param[in]  key           key of object
+/// @param[in]  obj           object to store
+/// @return returns error code
+static int
+tinyrad_dict_trie_insert(
+         TinyRadDictTrie **            triep,
+         const char *                  key,
+         void *                        obj )
 {
    size_t               pos;
-   ssize_t              attr_idx;
-   TinyRadDictKey       key;
-   TinyRadDictAttr *    attr;
-   TinyRadDictValue *   value;
+   size_t               off;
+   unsigned char        c;
+   void *               ptr;
+   TinyRadDictTrie *    node;
+   TinyRadDictTrie *    child;
+   TinyRadDictTrie *    mid;
 
-   TinyRadDebugTrace();
+   assert(triep != NULL);
+   assert(key   != NULL);
+   assert(obj   != NULL);
 
-   assert(dict     != NULL);
-   assert(value_idx  < dict->values_data_len);
+   if (!(*triep))
+      if ((*triep = tinyrad_dict_trie_alloc("", 0)) == NULL)
+         return(TRAD_ENOMEM);
 
-   value = dict->values_data[value_idx];
-   memset(&key, 0, sizeof(key));
-   key.oid           = value->attr->oid;
+   for(node = *triep; ((*key)); node = child, key += off)
+   {
+      c   = __trie_fold((unsigned char)key[0]);
+      pos = __trie_child(node, c);
 
-   for(pos = value_idx; ((pos > 0) && (!(tinyrad_dict_value_cmp_key_attr(&dict->values_data[pos-1], &key)))); pos--);
-   value_idx = pos;
+      // add remainder of key as new leaf
+      if ( (pos >= node->children_len) || (node->keys[pos] != c) )
+      {
+         if ((ptr = realloc(node->children, (node->children_len+1) * sizeof(TinyRadDictTrie *))) == NULL)
+            return(TRAD_ENOMEM);
+         node->children = ptr;
+         if ((ptr = realloc(node->keys, (node->children_len+1))) == NULL)
+            return(TRAD_ENOMEM);
+         node->keys = ptr;
+         if ((child = tinyrad_dict_trie_alloc(key, strlen(key))) == NULL)
+            return(TRAD_ENOMEM);
+         child->obj = obj;
+         memmove(&node->children[pos+1], &node->children[pos], (node->children_len-pos) * sizeof(TinyRadDictTrie *));
+         memmove(&node->keys[pos+1],     &node->keys[pos],     (node->children_len-pos));
+         node->children[pos] = child;
+         node->keys[pos]     = c;
+         node->children_len++;
+         return(TRAD_SUCCESS);
+      };
 
-   if ((attr_idx = tinyrad_dict_attr_index(dict, NULL, value->attr->oid, TRAD_NO)) < 0)
-      return;
-   attr = dict->attrs_type[attr_idx];
+      // follow edge while label matches key
+      child = node->children[pos];
+      for(off = 1; ( (off < child->len) && ((key[off])) ); off++)
+         if (__trie_fold((unsigned char)key[off]) != (unsigned char)child->label[off])
+            break;
+      if (off == child->len)
+         continue;
 
-   printf("\n# %s Values\n", attr->name);
-   for(pos = value_idx; ((pos < dict->values_data_len) && (!(tinyrad_dict_value_cmp_key_attr(&dict->values_data[pos], &key)))); pos++)
-   {
-      value = dict->values_data[pos];
-      printf("VALUE         %-31s %-21s %" PRIu64 "\n", attr->name, value->name, value->data );
+      // split edge where key diverges from label
+      if ((mid = tinyrad_dict_trie_alloc(child->label, off)) == NULL)
+         return(TRAD_ENOMEM);
+      mid->children = malloc(sizeof(TinyRadDictTrie *));
+      mid->keys     = malloc(1);
+      if ( (!(mid->children)) || (!(mid->keys)) )
+      {
+         tinyrad_dict_trie_free(mid);
+         return(TRAD_ENOMEM);
+      };
+      child->len -= off;
+      memmove(child->label, &child->label[off], child->len + 1);
+      mid->children[0]    = child;
+      mid->keys[0]        = (unsigned char)child->label[0];
+      mid->children_len   = 1;
+      node->children[pos] = mid;
+      child               = mid;
    };
-   printf("\n");
 
-   return;
+   if ((node->obj))
+      return(TRAD_EEXISTS);
+   node->obj = obj;
+
+   return(TRAD_SUCCESS);
 }
 
 
-void
-tinyrad_dict_print_vendor(
-         TinyRadDict *                 dict,
-         size_t                        vendor_idx )
+/// Calculates bytes used by trie nodes
+///
+/// @param[in]  trie          root of trie
+/// @return returns size of trie in bytes
+static size_t
+tinyrad_dict_trie_size(
+         const TinyRadDictTrie *       trie )
 {
-   size_t                  pos;
-   ssize_t                 idx;
-   char                    vendorstr[128];
-   TinyRadOID              oid;
-   TinyRadDictVendor *     vendor;
-
-   TinyRadDebugTrace();
+   size_t      pos;
+   size_t      size;
 
-   assert(dict       != NULL);
-   assert(vendor_idx  < dict->vendors_id_len);
+   if (!(trie))
+      return(0);
 
-   vendor = dict->vendors_id[vendor_idx];
+   size  = sizeof(TinyRadDictTrie) + trie->len + 1;
+   size += trie->children_len * (sizeof(TinyRadDictTrie *) + 1);
+   for(pos = 0; (pos < trie->children_len); pos++)
+      size += tinyrad_dict_trie_size(trie->children[pos]);
 
-   for(pos = vendor_idx; ((pos > 0) && (dict->vendors_id[pos-1]->id == vendor->id)); pos--);
-   vendor_idx = pos;
+   return(size);
+}
 
-   snprintf(vendorstr, sizeof(vendorstr), "%s VSA's", vendor->name);
-   printf("\n");
-   printf("##############################################################################\n");
-   printf("#                                                                            #\n");
-   printf("#   %-70s   #\n", vendorstr);
-   printf("#                                                                            #\n");
-   printf("##############################################################################\n");
-   printf("\n");
 
-   // print vendor definition
-   for(pos = vendor_idx; ((pos < dict->vendors_id_len) && (dict->vendors_id[pos]->id == vendor->id)); pos++)
-   {
-      if ( (vendor->len_octs != 1) || (vendor->type_octs != 1) )
-         printf("VENDOR        %-31s %-21" PRIu32 " format=%" PRIu8 ",%" PRIu8 "\n", dict->vendors_id[pos]->name, vendor->id, vendor->type_octs, vendor->len_octs);
-      else
-         printf("VENDOR        %-31s %" PRIu32 "\n", dict->vendors_id[pos]->name, vendor->id);
-   };
-   printf("\n");
+/// Passes objects of trie to function in case-folded key order
+///
+/// @param[in]  trie          trie node
+/// @param[in]  func          function called with each object and ctx
+/// @param[in]  ctx           context passed to function
+/// @return returns first error code returned by function
+static int
+tinyrad_dict_trie_walk(
+         const TinyRadDictTrie *       trie,
+         int (*func)(void *, void *),
+         void *                        ctx )
+{
+   int         rc;
+   size_t      pos;
 
-   oid.oid_val[0] = TRAD_ATTR_VENDOR_SPECIFIC;
-   oid.oid_val[1] = vendor->id;
-   oid.oid_val[2] = 0;
-   oid.oid_len    = 3;
-   if ((idx = tinyrad_dict_attr_index(dict, NULL, &oid, TRAD_YES)) < 0)
-      return;
+   if ((trie->obj))
+      if ((rc = func(trie->obj, ctx)) != TRAD_SUCCESS)
+         return(rc);
 
-   printf("BEGIN-VENDOR  %s\n\n", vendor->name);
-   for(pos = ((size_t)idx); ((pos < dict->attrs_type_len) && (__attr_vendor_id(dict->attrs_type[pos]) == vendor->id)); pos++)
-      tinyrad_dict_print_attribute(dict, pos);
-   printf("\nEND-VENDOR    %s\n\n", vendor->name);
+   for(pos = 0; (pos < trie->children_len); pos++)
+      if ((rc = tinyrad_dict_trie_walk(trie->children[pos], func, ctx)) != TRAD_SUCCESS)
+         return(rc);
 
-   return;
+   return(TRAD_SUCCESS);
 }
 
 
@@ -2154,11 +5336,12 @@ tinyrad_dict_value_alloc(
    if ((value = tinyrad_obj_alloc(sizeof(TinyRadDictValue), (void(*)(void*))&tinyrad_dict_value_free)) == NULL)
       return(NULL);
 
-   if ((value->name = tinyrad_strdup(name)) == NULL)
+   if ((value->name = tinyrad_dict_strpool_intern(dict->strpool, name)) == NULL)
    {
       tinyrad_dict_value_free(value);
       return(NULL);
    };
+   value->strpool = tinyrad_obj_retain(&dict->strpool->obj);
 
    value->attr = tinyrad_obj_retain(&attr->obj);
 
@@ -2315,8 +5498,8 @@ tinyrad_dict_value_cmp_obj_name(
    if ((rc = tinyrad_dict_value_cmp_obj_attr(a, b)) != 0)
       return(rc);
 
-   // compare pointers
-   if ( (!((*x)->name)) && (!((*y)->name)) )
+   // compare pointers, interned names are shared
+   if ((*x)->name == (*y)->name)
       return(0);
    if (!((*x)->name))
       return(-1);
@@ -2340,8 +5523,8 @@ tinyrad_dict_value_free(
    if ((value->attr))
       tinyrad_obj_release(&value->attr->obj);
 
-   if ((value->name))
-      free(value->name);
+   if ((value->strpool))
+      tinyrad_obj_release(&value->strpool->obj);
 
    memset(value, 0, sizeof(TinyRadDictValue));
    free(value);
@@ -2392,44 +5575,25 @@ tinyrad_dict_value_index(
          uint64_t                      data,
          int                           by_attr )
 {
-   size_t               width;
-   size_t               len;
-   unsigned             opts;
-   TinyRadDictValue **  list;
    TinyRadDictKey       key;
-   int (*compar)(const void *, const void *);
 
    TinyRadDebugTrace();
 
    assert(dict != NULL);
    assert((by_attr == TRAD_YES) || (by_attr == TRAD_NO));
 
-   width = sizeof(TinyRadDictAttr *);
-
    memset(&key, 0, sizeof(key));
    key.str           = name;
    key.oid           = oid;
    key.data          = data;
 
    if ((name))
-   {
-      len      = dict->values_name_len;
-      list     = dict->values_name;
-      compar   = &tinyrad_dict_value_cmp_key_name;
-      opts     = TINYRAD_ARRAY_LASTDUP;
-   } else if (by_attr == TRAD_YES) {
-      len      = dict->values_data_len;
-      list     = dict->values_data;
-      compar   = &tinyrad_dict_value_cmp_key_attr;
-      opts     = TINYRAD_ARRAY_FIRSTDUP;
-   } else {
-      len      = dict->values_data_len;
-      list     = dict->values_data;
-      compar   = &tinyrad_dict_value_cmp_key_data;
-      opts     = TINYRAD_ARRAY_LASTDUP;
-   };
+      return(tinyrad_dict_value_search_name(dict->values_name, dict->values_name_len, &key, TINYRAD_ARRAY_LASTDUP));
 
-   return(tinyrad_array_search(list, len, width, &key, opts, NULL, compar));
+   if (by_attr == TRAD_YES)
+      return(tinyrad_dict_value_search_attr(dict->values_data, dict->values_data_len, &key, TINYRAD_ARRAY_FIRSTDUP));
+
+   return(tinyrad_dict_value_search_data(dict->values_data, dict->values_data_len, &key, TINYRAD_ARRAY_LASTDUP));
 }
 
 
@@ -2514,43 +5678,97 @@ tinyrad_dict_value_lookup(
          const char *                 name,
          uint64_t                     data )
 {
-   size_t               width;
-   size_t               len;
-   unsigned             opts;
+   uint64_t             probes;
+   TinyRadDict *        next;
+   TinyRadDictValue *   value;
+
+   TinyRadDebugTrace();
+
+   assert(dict   != NULL);
+   assert(attr   != NULL);
+
+   probes = tinyrad_dict_probes;
+   value  = NULL;
+
+   // search overlays before base dictionaries
+   for(next = dict; ( ((next)) && (!(value)) ); next = next->base)
+   {
+      if (__dict_blocks_pending(next) == TRAD_NO)
+      {
+         value = tinyrad_dict_value_lookup_local(next, attr, name, data);
+         continue;
+      };
+
+      // values of vendor specific attributes are defined by blocks of their vendor
+      if ((attr->vendor))
+         tinyrad_dict_blocks_vendor(next, NULL, attr->vendor->id);
+
+      pthread_rwlock_rdlock(&next->blocks_lock);
+      value = tinyrad_dict_value_lookup_local(next, attr, name, data);
+      pthread_rwlock_unlock(&next->blocks_lock);
+
+      // values of other attributes may be defined by any deferred block
+      if ( (!(value)) && (!(attr->vendor)) && (tinyrad_dict_blocks_load(next, NULL) == TRAD_SUCCESS) )
+         value = tinyrad_dict_value_lookup_local(next, attr, name, data);
+   };
+
+   __dict_stats_lookup(dict, value, probes);
+
+   return(value);
+}
+
+
+static TinyRadDictValue *
+tinyrad_dict_value_lookup_local(
+         TinyRadDict *                dict,
+         TinyRadDictAttr *            attr,
+         const char *                 name,
+         uint64_t                     data )
+{
+   ssize_t              idx;
+   uint64_t             hval;
    TinyRadDictKey       key;
-   TinyRadDictValue **  list;
-   TinyRadDictValue **  res;
-   int (*compar)(const void *, const void *);
 
    TinyRadDebugTrace();
 
    assert(dict   != NULL);
    assert(attr   != NULL);
 
-   width    = sizeof(TinyRadDictValue *);
-   opts     = TINYRAD_ARRAY_LASTDUP;
+   // values of frozen dictionary's attributes are direct-indexed by data
+   if ( (!(name)) && ((attr->values)) && (attr->strpool == dict->strpool) && (!(dict->bulk)) )
+      return( (data < attr->values_len) ? attr->values[data] : NULL );
 
    memset(&key, 0, sizeof(key));
    key.str           = name;
    key.oid           = attr->oid;
    key.data          = data;
 
+   // probe hash tables of frozen or bulk loading dictionary
+   if (__dict_is_hashed(dict) == TRAD_YES)
+   {
+      hval = __hash_oid(TRAD_DICT_HASH_SEED, key.oid);
+      if ((name))
+         return(tinyrad_dict_hash_lookup(&dict->values_name_hash, __hash_u64(hval, __hash_str(TRAD_DICT_HASH_SEED, name)), &key, &tinyrad_dict_value_cmp_key_name));
+      return(tinyrad_dict_hash_lookup(&dict->values_data_hash, __hash_u64(hval, data), &key, &tinyrad_dict_value_cmp_key_data));
+   };
+
    if ((name))
    {
-      len      = dict->values_name_len;
-      list     = dict->values_name;
-      compar   = &tinyrad_dict_value_cmp_key_name;
-   } else {
-      len      = dict->values_data_len;
-      list     = dict->values_data;
-      compar   = &tinyrad_dict_value_cmp_key_data;
+      idx = tinyrad_dict_value_search_name(dict->values_name, dict->values_name_len, &key, TINYRAD_ARRAY_LASTDUP);
+      return( (idx >= 0) ? dict->values_name[idx] : NULL);
    };
 
-   res = tinyrad_array_get(list, len, width, &key, opts, compar);
-   return( ((res)) ? *res : NULL);
+   idx = tinyrad_dict_value_search_data(dict->values_data, dict->values_data_len, &key, TINYRAD_ARRAY_LASTDUP);
+   return( (idx >= 0) ? dict->values_data[idx] : NULL);
 }
 
 
+/// Searches sorted value lists without indirect comparator calls
+TINYRAD_ARRAY_SEARCH_FUNC(static, tinyrad_dict_value_search_attr, TinyRadDictValue *, const TinyRadDictKey *, tinyrad_dict_value_cmp_key_attr)
+TINYRAD_ARRAY_SEARCH_FUNC(static, tinyrad_dict_value_search_data, TinyRadDictValue *, const TinyRadDictKey *, tinyrad_dict_value_cmp_key_data)
+TINYRAD_ARRAY_SEARCH_FUNC(static, tinyrad_dict_value_search_name, TinyRadDictValue *, const TinyRadDictKey *, tinyrad_dict_value_cmp_key_name)
+
+
 //-----------------------------//
 // dictionary vendor functions //
 //-----------------------------//
@@ -2572,11 +5790,12 @@ tinyrad_dict_vendor_alloc(
    if ((vendor = tinyrad_obj_alloc(sizeof(TinyRadDictVendor), (void(*)(void*))&tinyrad_dict_vendor_free)) == NULL)
       return(NULL);
 
-   if ((vendor->name = tinyrad_strdup(name)) == NULL)
+   if ((vendor->name = tinyrad_dict_strpool_intern(dict->strpool, name)) == NULL)
    {
       tinyrad_dict_vendor_free(vendor);
       return(NULL);
    };
+   vendor->strpool = tinyrad_obj_retain(&dict->strpool->obj);
 
    dict->order_count++;
    vendor->order     = dict->order_count;
@@ -2588,6 +5807,26 @@ tinyrad_dict_vendor_alloc(
 }
 
 
+/// Retrieves vendor specific attribute from vendor's attribute index
+///
+/// The index is only populated once the dictionary is frozen.
+///
+/// @param[in]  vendor        dictionary vendor reference
+/// @param[in]  vendor_type   vendor's attribute type
+/// @return returns attribute or NULL if not found
+TinyRadDictAttr *
+tinyrad_dict_vendor_attr_lookup(
+         TinyRadDictVendor *          vendor,
+         uint32_t                     vendor_type )
+{
+   TinyRadDebugTrace();
+   assert(vendor != NULL);
+   if ((vendor->attrs))
+      return( (vendor_type < vendor->attrs_len) ? vendor->attrs[vendor_type] : NULL );
+   return(tinyrad_dict_hash_lookup(&vendor->attrs_hash, __hash_u64(TRAD_DICT_HASH_SEED, vendor_type), &vendor_type, &tinyrad_dict_attr_cmp_key_vendor_type));
+}
+
+
 int
 tinyrad_dict_vendor_cmp_key_id(
          const void *                 ptr,
@@ -2638,7 +5877,8 @@ tinyrad_dict_vendor_cmp_obj_name(
    const TinyRadDictVendor * const * x = a;
    const TinyRadDictVendor * const * y = b;
 
-   if ( (!((*x)->name)) && (!((*y)->name)) )
+   // interned names are shared, so identical pointers are identical names
+   if ((*x)->name == (*y)->name)
       return(0);
 
    if (!((*x)->name))
@@ -2663,8 +5903,13 @@ tinyrad_dict_vendor_free(
    if (!(vendor))
       return;
 
-   if ((vendor->name))
-      free(vendor->name);
+   if ((vendor->strpool))
+      tinyrad_obj_release(&vendor->strpool->obj);
+
+   if ((vendor->attrs))
+      free(vendor->attrs);
+   tinyrad_dict_hash_free(&vendor->attrs_hash);
+   tinyrad_dict_blocks_free(vendor->blocks);
 
    memset(vendor, 0, sizeof(TinyRadDictVendor));
    free(vendor);
@@ -2743,44 +5988,160 @@ tinyrad_dict_vendor_info(
 }
 
 
-/// wrapper around stat() for dictionary processing
+/// Builds index of vendor's attributes keyed by vendor type
 ///
+/// Vendors whose attribute types are small, or densely packed, are indexed
+/// with an array addressed by vendor type. Vendors with sparse types are
+/// indexed with a hash table.  Attributes are read from the sorted list of
+/// attributes by type, so the last duplicate of a vendor type wins.
+///
+/// @param[in]  dict          dictionary reference
+/// @param[in]  vendor        dictionary vendor reference
+/// @return returns error code
+int
+tinyrad_dict_vendor_index(
+         TinyRadDict *                dict,
+         TinyRadDictVendor *          vendor )
+{
+   ssize_t              idx;
+   size_t               pos;
+   size_t               len;
+   size_t               count;
+   uint32_t             vendor_type;
+   uint32_t             max;
+   TinyRadOID           oid;
+   TinyRadDictAttr *    attr;
+
+   TinyRadDebugTrace();
+
+   assert(dict   != NULL);
+   assert(vendor != NULL);
+
+   if ( ((vendor->attrs)) || ((vendor->attrs_hash.slots)) )
+      return(TRAD_SUCCESS);
+
+   // locate vendor's attributes within list sorted by vendor and type
+   memset(&oid, 0, sizeof(oid));
+   oid.oid_len    = 2;
+   oid.oid_val[0] = TRAD_ATTR_VENDOR_SPECIFIC;
+   oid.oid_val[1] = vendor->id;
+   if ((idx = tinyrad_dict_attr_index(dict, NULL, &oid, TRAD_YES)) < 0)
+      return(TRAD_SUCCESS);
+
+   // determine range of vendor specific attributes
+   max   = 0;
+   count = 0;
+   for(pos = (size_t)idx; (pos < dict->attrs_type_len); pos++)
+   {
+      attr = dict->attrs_type[pos];
+      if (__attr_vendor_id(attr) != vendor->id)
+         break;
+      if ( (attr->oid->oid_len != 3) || (attr->oid->oid_val[0] != TRAD_ATTR_VENDOR_SPECIFIC) )
+         continue;
+      max = (attr->oid->oid_val[2] > max) ? attr->oid->oid_val[2] : max;
+      count++;
+   };
+   len = pos;
+   if (!(count))
+      return(TRAD_SUCCESS);
+
+   // populate dense index
+   if ( (max < TRAD_DICT_VENDOR_DENSE_MAX) || (max < (count * 4)) )
+   {
+      if ((vendor->attrs = calloc((size_t)max + 1, sizeof(TinyRadDictAttr *))) == NULL)
+         return(TRAD_ENOMEM);
+      vendor->attrs_len = (size_t)max + 1;
+      for(pos = (size_t)idx; (pos < len); pos++)
+      {
+         attr = dict->attrs_type[pos];
+         if ( (attr->oid->oid_len == 3) && (attr->oid->oid_val[0] == TRAD_ATTR_VENDOR_SPECIFIC) )
+            vendor->attrs[attr->oid->oid_val[2]] = attr;
+      };
+      return(TRAD_SUCCESS);
+   };
+
+   // populate sparse index
+   if (tinyrad_dict_hash_init(&vendor->attrs_hash, count) != TRAD_SUCCESS)
+      return(TRAD_ENOMEM);
+   for(pos = (size_t)idx; (pos < len); pos++)
+   {
+      attr = dict->attrs_type[pos];
+      if ( (attr->oid->oid_len != 3) || (attr->oid->oid_val[0] != TRAD_ATTR_VENDOR_SPECIFIC) )
+         continue;
+      vendor_type = attr->oid->oid_val[2];
+      tinyrad_dict_hash_insert(&vendor->attrs_hash, __hash_u64(TRAD_DICT_HASH_SEED, vendor_type), attr, &vendor_type, &tinyrad_dict_attr_cmp_key_vendor_type);
+   };
+
+   return(TRAD_SUCCESS);
+}
+
+
 TinyRadDictVendor *
 tinyrad_dict_vendor_lookup(
          TinyRadDict *                dict,
          const char *                 name,
          uint32_t                     id )
 {
-   void **                 list;
-   const void *            key;
-   size_t                  len;
-   size_t                  width;
-   unsigned                opts;
-   TinyRadDictVendor **    res;
-   int (*compar)(const void *, const void *);
+   uint64_t                probes;
+   TinyRadDict *           next;
+   TinyRadDictVendor *     vendor;
+
+   TinyRadDebugTrace();
+
+   assert(dict   != NULL);
+
+   probes = tinyrad_dict_probes;
+   vendor = NULL;
+
+   // search overlays before base dictionaries, vendors are never deferred
+   for(next = dict; ( ((next)) && (!(vendor)) ); next = next->base)
+   {
+      if (__dict_blocks_pending(next) == TRAD_YES)
+         vendor = tinyrad_dict_blocks_vendor(next, name, id);
+      else
+         vendor = tinyrad_dict_vendor_lookup_local(next, name, id);
+   };
+
+   __dict_stats_lookup(dict, vendor, probes);
+
+   return(vendor);
+}
+
+
+static TinyRadDictVendor *
+tinyrad_dict_vendor_lookup_local(
+         TinyRadDict *                dict,
+         const char *                 name,
+         uint32_t                     id )
+{
+   ssize_t                 idx;
 
    TinyRadDebugTrace();
 
    assert(dict   != NULL);
 
-   width = sizeof(TinyRadDictVendor *);
-   opts = TINYRAD_ARRAY_LASTDUP;
+   // probe hash tables of frozen or bulk loading dictionary
+   if (__dict_is_hashed(dict) == TRAD_YES)
+   {
+      if ((name))
+         return(tinyrad_dict_hash_lookup(&dict->vendors_name_hash, __hash_str(TRAD_DICT_HASH_SEED, name), name, &tinyrad_dict_vendor_cmp_key_name));
+      return(tinyrad_dict_hash_lookup(&dict->vendors_id_hash, __hash_u64(TRAD_DICT_HASH_SEED, id), &id, &tinyrad_dict_vendor_cmp_key_id));
+   };
 
    if ((name))
    {
-      list   = (void **)dict->vendors_name;
-      len    = dict->vendors_name_len;
-      key    = name;
-      compar = &tinyrad_dict_vendor_cmp_key_name;
-   } else {
-      list   = (void **)dict->vendors_id;
-      len    = dict->vendors_id_len;
-      key    = &id;
-      compar = &tinyrad_dict_vendor_cmp_key_id;
+      idx = tinyrad_dict_vendor_search_name(dict->vendors_name, dict->vendors_name_len, name, TINYRAD_ARRAY_LASTDUP);
+      return( (idx >= 0) ? dict->vendors_name[idx] : NULL);
    };
 
-   res = tinyrad_array_get(list, len, width, key, opts, compar);
-   return( ((res)) ? *res : NULL);
+   idx = tinyrad_dict_vendor_search_id(dict->vendors_id, dict->vendors_id_len, &id, TINYRAD_ARRAY_LASTDUP);
+   return( (idx >= 0) ? dict->vendors_id[idx] : NULL);
 }
 
+
+/// Searches sorted vendor lists without indirect comparator calls
+TINYRAD_ARRAY_SEARCH_FUNC(static, tinyrad_dict_vendor_search_id,   TinyRadDictVendor *, const uint32_t *, tinyrad_dict_vendor_cmp_key_id)
+TINYRAD_ARRAY_SEARCH_FUNC(static, tinyrad_dict_vendor_search_name, TinyRadDictVendor *, const char *,     tinyrad_dict_vendor_cmp_key_name)
+
+
 /* end of source */
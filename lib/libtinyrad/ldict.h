@@ -42,6 +42,9 @@
 #include "libtinyrad.h"
 
 #include <stdatomic.h>
+#include <pthread.h>
+
+#include "lfile.h"
 
 
 ///////////////////
@@ -51,6 +54,33 @@
 ///////////////////
 #pragma mark - Definitions
 
+// minimum number of slots in a frozen dictionary hash table
+#define TRAD_DICT_HASH_MIN_SIZE     16
+
+// number of slots in direct-indexed table of standard attributes
+#define TRAD_DICT_STD_ATTRS         256
+
+// vendors with attribute types below this value always use a dense index
+#define TRAD_DICT_VENDOR_DENSE_MAX  256
+
+// attributes with value data below this value always use a dense index
+#define TRAD_DICT_VALUE_DENSE_MAX   256
+
+// minimum capacity of dictionary lists while bulk loading
+#define TRAD_DICT_BULK_MIN_SIZE     16
+
+// minimum size of blocks allocated by dictionary string pool
+#define TRAD_DICT_STRPOOL_BLOCK     16384
+
+// maximum number of worker threads used by parallel parsing
+#define TRAD_DICT_PARSE_THREADS     8
+
+// maximum include depth followed by parallel parsing
+#define TRAD_DICT_PARSE_DEPTH       32
+
+// FNV-1a offset basis used to seed frozen dictionary hashes
+#define TRAD_DICT_HASH_SEED         0xcbf29ce484222325ULL
+
 
 //////////////////
 //              //
@@ -67,27 +97,183 @@ typedef struct tinyrad_dict_key
 } TinyRadDictKey;
 
 
+typedef struct tinyrad_dict_block
+{
+   struct tinyrad_dict_block *   next;
+   char *                        fullpath;     // file containing vendor block
+   int64_t                       mtime;        // modification time when indexed
+   int64_t                       size;         // file size when indexed
+   off_t                         offset;       // offset of line following BEGIN-VENDOR
+   int                           line;         // line number of BEGIN-VENDOR
+   uint32_t                      mtime_nsec;   // nanoseconds of modification time when indexed
+} TinyRadDictBlock;
+
+
+typedef struct tinyrad_dict_source
+{
+   char *               path;         // file name as included
+   char *               fullpath;     // file name after searching paths
+   int64_t              mtime;        // modification time when parsed
+   int64_t              size;         // file size when parsed
+   uint32_t             depth;        // include depth (0 for top level file)
+   uint32_t             mtime_nsec;   // nanoseconds of modification time when parsed
+} TinyRadDictSource;
+
+
+typedef struct tinyrad_dict_line
+{
+   int                           line;         // line number within file
+   int                           keyword;
+   int                           argc;
+   int                           pad32;
+   char **                       argv;
+   struct tinyrad_dict_job *     incl;         // job of file named by $INCLUDE
+} TinyRadDictLine;
+
+
+typedef struct tinyrad_dict_job
+{
+   char *                        path;         // path of file as queued
+   TinyRadFile *                 file;
+   struct tinyrad_dict_job *     parent;       // job of including file
+   struct tinyrad_dict_job *     next;         // next job in work queue
+   struct tinyrad_dict_job *     jobs;         // next job owned by pool
+   TinyRadDictLine *             lines;        // tokenized lines in file order
+   size_t                        lines_len;
+   size_t                        lines_size;
+   int64_t                       mtime;        // modification time when opened
+   int64_t                       size;         // file size when opened
+   uint32_t                      mtime_nsec;   // nanoseconds of modification time when opened
+   uint32_t                      depth;        // include depth (0 for top level file)
+   int                           opened;       // file was found and opened
+   int                           done;         // tokenizing finished
+   int                           rc;           // result of tokenizing file
+   int                           line;         // line at which tokenizing stopped
+   int                           pad32;
+} TinyRadDictJob;
+
+
+typedef struct tinyrad_dict_pool
+{
+   pthread_mutex_t               mutex;
+   pthread_cond_t                cond;         // signaled when jobs are queued or finished
+   TinyRadDictJob *              queue;        // jobs waiting for a worker
+   TinyRadDictJob *              queue_tail;
+   TinyRadDictJob *              jobs;         // all jobs, freed with pool
+   char **                       paths;
+   int                           shutdown;
+   int                           pad32;
+   size_t                        threads_len;
+   pthread_t                     threads[TRAD_DICT_PARSE_THREADS];
+} TinyRadDictPool;
+
+
+typedef struct tinyrad_dict_slot
+{
+   uint64_t             hash;
+   void *               obj;
+} TinyRadDictSlot;
+
+
+typedef struct tinyrad_dict_trie
+{
+   void *                           obj;            // object whose key ends at this node
+   size_t                           children_len;
+   struct tinyrad_dict_trie **      children;       // sorted by first byte of label
+   unsigned char *                  keys;           // first byte of label of each child
+   size_t                           len;            // length of label
+   char                             label[];        // case-folded edge label
+} TinyRadDictTrie;
+
+
+typedef struct tinyrad_dict_hash
+{
+   size_t               size;         // number of slots, always a power of two
+   size_t               count;        // number of occupied slots
+   TinyRadDictSlot *    slots;
+} TinyRadDictHash;
+
+
+typedef struct tinyrad_dict_lens
+{
+   size_t               attrs_name;
+   size_t               attrs_type;
+   size_t               values_data;
+   size_t               values_name;
+   size_t               vendors_id;
+   size_t               vendors_name;
+} TinyRadDictLens;
+
+
+typedef struct tinyrad_dict_str
+{
+   uint64_t             hash;         // case-folded FNV-1a hash of string
+   uint32_t             len;          // length of string
+   uint32_t             pad32;
+   char                 str[];        // NUL terminated string
+} TinyRadDictStr;
+
+
+typedef struct tinyrad_dict_strblock
+{
+   struct tinyrad_dict_strblock *   next;
+   size_t                           size;
+   size_t                           used;
+   char                             data[];
+} TinyRadDictStrBlock;
+
+
+typedef struct tinyrad_dict_strpool
+{
+   TinyRadObj              obj;
+   TinyRadDictStrBlock *   blocks;
+   TinyRadDictHash         index;        // interned strings by case-folded hash
+} TinyRadDictStrPool;
+
+
 struct _tinyrad_dict
 {
    TinyRadObj              obj;
+   TinyRadDict *           base;                // read-only dictionary searched after this one
    unsigned                opts;
    unsigned                opts_neg;
    atomic_int_least32_t    readonly;
    uint32_t                order_count;
+   uint32_t                bulk;                // nesting depth of bulk loads
+   TinyRadDictLens         bulk_sorted;         // lengths of sorted lists when bulk load began
+   TinyRadDictLens         lists_size;          // capacity of lists
+   uint32_t                blocks_lock_init;    // blocks_lock has been initialized
+   atomic_size_t           blocks_pending;      // number of vendor blocks not yet parsed
+   pthread_rwlock_t        blocks_lock;         // held while deferred vendor blocks are parsed
+   atomic_uint_least64_t   stats_lookups;       // number of public lookups
+   atomic_uint_least64_t   stats_misses;        // number of public lookups returning NULL
+   atomic_uint_least64_t   stats_probes;        // number of hash slots examined by public lookups
    size_t                  attrs_name_len;
    size_t                  attrs_type_len;
    size_t                  values_data_len;
    size_t                  values_name_len;
    size_t                  vendors_id_len;
    size_t                  vendors_name_len;
+   size_t                  sources_len;
    TinyRadDictAttr **      attrs_name;
    TinyRadDictAttr **      attrs_type;
+   TinyRadDictAttr *       attrs_std[TRAD_DICT_STD_ATTRS];  // standard attributes by type
    TinyRadDictValue **     values_data;
    TinyRadDictValue **     values_name;
    TinyRadDictVendor **    vendors_name;
    TinyRadDictVendor **    vendors_id;
    char *                  default_dictfile;
+   char *                  cache_file;
    char **                 paths;
+   TinyRadDictSource *     sources;
+   TinyRadDictStrPool *    strpool;             // interned object names
+   TinyRadDictHash         attrs_name_hash;     // populated when frozen or bulk loading
+   TinyRadDictHash         attrs_type_hash;     // populated when frozen or bulk loading
+   TinyRadDictHash         values_data_hash;    // populated when frozen or bulk loading
+   TinyRadDictHash         values_name_hash;    // populated when frozen or bulk loading
+   TinyRadDictHash         vendors_id_hash;     // populated when frozen or bulk loading
+   TinyRadDictHash         vendors_name_hash;   // populated when frozen or bulk loading
+   TinyRadDictTrie *       attrs_name_trie;     // populated when frozen
 };
 
 
@@ -95,11 +281,16 @@ struct _tinyrad_dict_vendor
 {
    TinyRadObj              obj;
    uintptr_t               order;
-   char *                  name;
+   char *                  name;         // interned in strpool
+   TinyRadDictStrPool *    strpool;
    uint32_t                id;
    uint8_t                 type_octs;
    uint8_t                 len_octs;
    uint16_t                pad16;
+   size_t                  attrs_len;    // length of dense attribute index
+   TinyRadDictAttr **      attrs;        // dense attribute index by vendor type
+   TinyRadDictHash         attrs_hash;   // sparse attribute index by vendor type
+   TinyRadDictBlock *      blocks;       // deferred BEGIN-VENDOR blocks
 };
 
 
@@ -107,13 +298,16 @@ struct _tinyrad_dict_attr
 {
    TinyRadObj              obj;
    uintptr_t               order;
-   char *                  name;
+   char *                  name;         // interned in strpool
+   TinyRadDictStrPool *    strpool;
    TinyRadDictVendor *     vendor;
    TinyRadOID *            oid;
    uint8_t                 data_type;
    uint8_t                 pad8;
    uint16_t                flags;
    uint32_t                pad32;
+   size_t                  values_len;   // length of dense value index
+   TinyRadDictValue **     values;       // dense value index by data
 };
 
 
@@ -121,9 +315,9 @@ struct _tinyrad_dict_value
 {
    TinyRadObj              obj;
    TinyRadDictAttr *       attr;
-   char *                  name;         // value name
+   char *                  name;         // value name, interned in strpool
    uintptr_t               order;
-   uintptr_t               pad_intptr;
+   TinyRadDictStrPool *    strpool;
    uint64_t                data;         // valu data (i.e the actual value)
 };
 
@@ -135,6 +329,45 @@ struct _tinyrad_dict_value
 //////////////////
 #pragma mark - Prototypes
 
+int
+tinyrad_dict_add_attr(
+         TinyRadDict *                 dict,
+         TinyRadDictAttr *             attr );
+
+
+int
+tinyrad_dict_add_source(
+         TinyRadDict *                 dict,
+         const char *                  path,
+         const char *                  fullpath,
+         int64_t                       mtime,
+         uint32_t                      mtime_nsec,
+         int64_t                       size,
+         uint32_t                      depth );
+
+
+int
+tinyrad_dict_add_value(
+         TinyRadDict *                 dict,
+         TinyRadDictAttr *             attr,
+         TinyRadDictValue *            value );
+
+
+int
+tinyrad_dict_add_vendor(
+         TinyRadDict *                 dict,
+         TinyRadDictVendor *           vendor );
+
+
+TinyRadDictAttr *
+tinyrad_dict_attr_alloc(
+         TinyRadDict *                 dict,
+         const char *                  name,
+         const TinyRadOID *            oid,
+         uint8_t                       data_type,
+         uint32_t                      flags );
+
+
 TinyRadDictAttr *
 tinyrad_dict_attr_lookup(
          TinyRadDict *                 dict,
@@ -147,6 +380,22 @@ tinyrad_dict_attr_oidname(
          const TinyRadOID *            oid );
 
 
+int
+tinyrad_dict_blocks_load(
+         TinyRadDict *                 dict,
+         TinyRadDictVendor *           vendor );
+
+
+int
+tinyrad_dict_bulk_begin(
+         TinyRadDict *                 dict );
+
+
+void
+tinyrad_dict_bulk_end(
+         TinyRadDict *                 dict );
+
+
 int
 tinyrad_dict_defaults(
          TinyRadDict *                 dict,
@@ -154,6 +403,19 @@ tinyrad_dict_defaults(
          int                           opts );
 
 
+int
+tinyrad_dict_is_readonly(
+         TinyRadDict *                 dict );
+
+
+TinyRadDictValue *
+tinyrad_dict_value_alloc(
+         TinyRadDict *                 dict,
+         TinyRadDictAttr *             attr,
+         const char *                  name,
+         uint64_t                      data );
+
+
 TinyRadDictValue *
 tinyrad_dict_value_lookup(
          TinyRadDict *                 dict,
@@ -162,6 +424,21 @@ tinyrad_dict_value_lookup(
          uint64_t                      data );
 
 
+TinyRadDictVendor *
+tinyrad_dict_vendor_alloc(
+         TinyRadDict *                 dict,
+         const char *                  name,
+         uint32_t                      id,
+         uint8_t                       type_octs,
+         uint8_t                       len_octs );
+
+
+TinyRadDictAttr *
+tinyrad_dict_vendor_attr_lookup(
+         TinyRadDictVendor *           vendor,
+         uint32_t                      vendor_type );
+
+
 TinyRadDictVendor *
 tinyrad_dict_vendor_lookup(
          TinyRadDict *                 dict,
@@ -93,6 +93,7 @@ tinyrad_error_map(
       case TRAD_EATTRIBUTE:   return("invalid or unknown attribute");
       case TRAD_EATTRVAL:     return("invalid or unknown attribute value");
       case TRAD_EDICTRO:      return("dictionary is read-only");
+      case TRAD_ECACHE:       return("invalid or stale dictionary cache");
       default:
       break;
    };
@@ -46,6 +46,7 @@
 #include <fcntl.h>
 #include <sys/types.h>
 #include <sys/uio.h>
+#include <sys/mman.h>
 #include <unistd.h>
 #include <sys/stat.h>
 #include <errno.h>
@@ -63,6 +64,10 @@
 //////////////////
 #pragma mark - Prototypes
 
+static int
+tinyrad_file_buffer(
+         TinyRadFile *                 file );
+
 
 /////////////////
 //             //
@@ -71,6 +76,83 @@
 /////////////////
 #pragma mark - Functions
 
+/// Attaches a read buffer to a file
+///
+/// Regular files are mapped into memory, other files (pipes, FIFOs, and
+/// sockets) are read in blocks of TRAD_FILE_BUFF_SIZE bytes.
+///
+/// @param[in]  file          file reference
+/// @return returns error code
+static int
+tinyrad_file_buffer(
+         TinyRadFile *                 file )
+{
+   struct stat    sb;
+   off_t          offset;
+   void *         ptr;
+
+   TinyRadDebugTrace();
+
+   if (fstat(file->fd, &sb) == -1)
+      return(TRAD_EINVAL);
+
+   // reading starts from the current offset of the descriptor
+   offset = lseek(file->fd, 0, SEEK_CUR);
+
+   if ( (S_ISREG(sb.st_mode)) && (sb.st_size > 0) && (offset != -1) && (offset <= sb.st_size) )
+   {
+      if ((ptr = mmap(NULL, (size_t)sb.st_size, PROT_READ, MAP_PRIVATE, file->fd, 0)) != MAP_FAILED)
+      {
+         file->buff   = ptr;
+         file->size   = (size_t)sb.st_size;
+         file->len    = (size_t)sb.st_size;
+         file->pos    = (size_t)offset;
+         file->offset = 0;
+         file->mapped = TRAD_YES;
+         return(TRAD_SUCCESS);
+      };
+   };
+
+   if ((file->buff = malloc(TRAD_FILE_BUFF_SIZE)) == NULL)
+      return(TRAD_ENOMEM);
+   file->size   = TRAD_FILE_BUFF_SIZE;
+   file->len    = 0;
+   file->pos    = 0;
+   file->offset = (offset == -1) ? 0 : offset;
+
+   return(TRAD_SUCCESS);
+}
+
+
+/// Closes file descriptor and releases read buffer of a file
+///
+/// @param[in]  file          file reference
+void
+tinyrad_file_close(
+         TinyRadFile *                 file )
+{
+   TinyRadDebugTrace();
+
+   assert(file != NULL);
+
+   if ((file->mapped))
+      munmap(file->buff, file->size);
+   else if ((file->buff))
+      free(file->buff);
+   file->buff   = NULL;
+   file->size   = 0;
+   file->len    = 0;
+   file->pos    = 0;
+   file->mapped = TRAD_NO;
+
+   if (file->fd != -1)
+      close(file->fd);
+   file->fd = -1;
+
+   return;
+}
+
+
 /// Destroys and frees resources of a RADIUS dictionary buffer
 ///
 /// @param[in]  file          dictionary buffer reference
@@ -93,8 +175,7 @@ tinyrad_file_destroy(
          free(file->fullpath);
       if ((file->path))
          free(file->path);
-      if (file->fd != -1)
-         close(file->fd);
+      tinyrad_file_close(file);
       memset(file, 0, sizeof(TinyRadFile));
       free(file);
 
@@ -161,6 +242,47 @@ tinyrad_file_error(
 }
 
 
+/// Initialize file buffer for an open file descriptor
+///
+/// The file buffer takes ownership of the descriptor, which is closed when
+/// the buffer is destroyed.
+///
+/// @param[out] filep         pointer to buffer reference
+/// @param[in]  path          path used in error messages
+/// @param[in]  fd            open file descriptor
+/// @return returns error code
+int
+tinyrad_file_fdopen(
+         TinyRadFile **                filep,
+         const char *                  path,
+         int                           fd )
+{
+   TinyRadFile *           file;
+
+   TinyRadDebugTrace();
+
+   assert(filep != NULL);
+   assert(path  != NULL);
+
+   if ((file = malloc(sizeof(TinyRadFile))) == NULL)
+   {
+      *filep = NULL;
+      close(fd);
+      return(TRAD_ENOMEM);
+   };
+   memset(file, 0, sizeof(TinyRadFile));
+   file->fd = fd;
+   *filep   = file;
+
+   if ((file->path = tinyrad_strdup(path)) == NULL)
+      return(TRAD_ENOMEM);
+   if ((file->fullpath = tinyrad_strdup(path)) == NULL)
+      return(TRAD_ENOMEM);
+
+   return(TRAD_SUCCESS);
+}
+
+
 /// Initialize dicitionary file buffer
 ///
 /// @param[out] filep         pointer to buffer reference
@@ -190,6 +312,7 @@ int tinyrad_file_init(
    if ((file = malloc(sizeof(TinyRadFile))) == NULL)
       return(TRAD_ENOMEM);
    memset(file, 0, sizeof(TinyRadFile));
+   file->fd = -1;
 
    // store dictionary file name
    if ((file->path = tinyrad_strdup(path)) == NULL)
@@ -270,6 +393,174 @@ tinyrad_filetostr(
 }
 
 
+/// Reads next line from a file buffer
+///
+/// Behaves like tinyrad_readline(), but reads the file through the buffer
+/// attached to the file instead of issuing a system call for each byte.
+///
+/// @param[in]  file          file reference
+/// @param[out] str           buffer receiving the line without line ending
+/// @param[in]  size          size of str
+/// @param[out] bytes_read    number of bytes consumed from the file, zero at end of file
+/// @return returns error code
+int
+tinyrad_file_readline(
+         TinyRadFile *                 file,
+         char *                        str,
+         size_t                        size,
+         size_t *                      bytes_read )
+{
+   int               rc;
+   ssize_t           rlen;
+   size_t            pos;
+   size_t            len;
+   char *            src;
+   char *            eol;
+
+   assert(file != NULL);
+   assert(str  != NULL);
+   assert(size  > 1);
+
+   if ((bytes_read))
+      *bytes_read = 0;
+
+   if (!(file->buff))
+   {
+      if (file->fd == -1)
+         return(TRAD_EINVAL);
+      if ((rc = tinyrad_file_buffer(file)) != TRAD_SUCCESS)
+         return(rc);
+   };
+
+   for(pos = 0; (pos < (size-1)); pos += len)
+   {
+      // refill buffer, mapped files are at end of file once the buffer is consumed
+      if (file->pos >= file->len)
+      {
+         if ((file->mapped))
+            break;
+         file->offset += (off_t)file->len;
+         file->len     = 0;
+         file->pos     = 0;
+         if ((rlen = read(file->fd, file->buff, file->size)) == -1)
+         {
+            if (errno == EINTR)
+            {
+               len = 0;
+               continue;
+            };
+            return(TRAD_EUNKNOWN);
+         };
+         if (rlen == 0)
+            break;
+         file->len = (size_t)rlen;
+      };
+
+      // copy buffered data up to end of line
+      src = &file->buff[file->pos];
+      len = file->len - file->pos;
+      len = (len < ((size-1) - pos)) ? len : ((size-1) - pos);
+      if ((eol = memchr(src, '\n', len)) == NULL)
+      {
+         memcpy(&str[pos], src, len);
+         file->pos += len;
+         continue;
+      };
+
+      // process end of line
+      len = (size_t)(eol - src);
+      memcpy(&str[pos], src, len);
+      file->pos += len + 1;
+      pos       += len;
+      str[pos]   = '\0';
+      if ((pos > 0) && (str[pos-1] == '\r'))
+         str[pos-1] = '\0';
+      if ((bytes_read))
+         *bytes_read = (pos+1);
+      return(TRAD_SUCCESS);
+   };
+
+   str[pos] = '\0';
+
+   // process end of file
+   if (pos < (size-1))
+   {
+      if ((bytes_read))
+         *bytes_read = pos;
+      return(TRAD_SUCCESS);
+   };
+
+   if ((bytes_read))
+      *bytes_read = (pos+1);
+
+   return(TRAD_ENOBUFS);
+}
+
+
+/// Moves the read position of a file buffer
+///
+/// @param[in]  file          file reference
+/// @param[in]  offset        offset from start of file
+/// @return returns error code
+int
+tinyrad_file_seek(
+         TinyRadFile *                 file,
+         off_t                         offset )
+{
+   TinyRadDebugTrace();
+
+   assert(file != NULL);
+
+   if (offset < 0)
+      return(TRAD_EACCES);
+
+   // offsets within the buffer do not require a system call
+   if ( ((file->buff)) && (offset >= file->offset) && ((offset - file->offset) <= (off_t)file->len) )
+   {
+      file->pos = (size_t)(offset - file->offset);
+      return(TRAD_SUCCESS);
+   };
+   if ((file->mapped))
+      return(TRAD_EACCES);
+
+   if (lseek(file->fd, offset, SEEK_SET) == -1)
+      return(TRAD_EACCES);
+   file->offset = offset;
+   file->len    = 0;
+   file->pos    = 0;
+
+   return(TRAD_SUCCESS);
+}
+
+
+/// Returns the read position of a file buffer
+///
+/// @param[in]  file          file reference
+/// @return returns offset of the next unread byte, or -1 if the file is not
+///         seekable.
+off_t
+tinyrad_file_tell(
+         TinyRadFile *                 file )
+{
+   off_t       offset;
+
+   TinyRadDebugTrace();
+
+   assert(file != NULL);
+
+   if ((file->mapped))
+      return(file->offset + (off_t)file->pos);
+
+   // pipes, FIFOs, and sockets are not seekable
+   if ((offset = lseek(file->fd, 0, SEEK_CUR)) == -1)
+      return(-1);
+   if (!(file->buff))
+      return(offset);
+
+   return(file->offset + (off_t)file->pos);
+}
+
+
 int
 tinyrad_readline(
          int                           fd,
@@ -54,6 +54,7 @@
 #define TRAD_ARGV_SIZE              10
 #define TRAD_FILE_RECURSE           1
 #define TRAD_FILE_NORECURSE         0
+#define TRAD_FILE_BUFF_SIZE         65536    // size of read buffer for files which are not mapped
 
 
 //////////////////
@@ -71,6 +72,12 @@ struct _tinyrad_file
    char *              path;
    char *              fullpath;
    TinyRadFile *       parent;
+   char *              buff;       // read buffer, or mapping of a regular file
+   size_t              size;       // capacity of read buffer or length of mapping
+   size_t              len;        // number of bytes in buffer
+   size_t              pos;        // offset in buffer of next unread byte
+   off_t               offset;     // file offset of first byte in buffer
+   int                 mapped;     // buffer is a read-only mapping of the file
 };
 
 
@@ -81,6 +88,11 @@ struct _tinyrad_file
 //////////////////
 #pragma mark - Prototypes
 
+void
+tinyrad_file_close(
+       TinyRadFile *                   file );
+
+
 void
 tinyrad_file_destroy(
        TinyRadFile *                   file,
@@ -94,6 +106,13 @@ tinyrad_file_error(
          char ***                      msgsp );
 
 
+int
+tinyrad_file_fdopen(
+         TinyRadFile **                filep,
+         const char *                  path,
+         int                           fd );
+
+
 int
 tinyrad_file_init(
          TinyRadFile **                filep,
@@ -102,6 +121,25 @@ tinyrad_file_init(
          TinyRadFile *                 parent );
 
 
+int
+tinyrad_file_readline(
+         TinyRadFile *                 file,
+         char *                        str,
+         size_t                        size,
+         size_t *                      bytes_read );
+
+
+int
+tinyrad_file_seek(
+         TinyRadFile *                 file,
+         off_t                         offset );
+
+
+off_t
+tinyrad_file_tell(
+         TinyRadFile *                 file );
+
+
 int
 tinyrad_filetostr(
          char *                        dst,
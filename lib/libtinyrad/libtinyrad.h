@@ -49,6 +49,7 @@
 #include <stdint.h>
 #include <stdatomic.h>
 #include <stdio.h>
+#include <pthread.h>
 #include <stdarg.h>
 
 #include <tinyrad.h>
@@ -113,7 +114,8 @@ struct _tinyrad_obj
 struct _tinyrad
 {
    TinyRadObj            obj;
-   TinyRadDict *         dict;
+   TinyRadDict *         dict;          // published dictionary, guarded by dict_lock
+   pthread_mutex_t       dict_lock;
    TinyRadURLDesc *      trud;
    TinyRadURLDesc *      trud_cur;
    char *                secret;
@@ -130,7 +132,7 @@ struct _tinyrad
    int                   s;
    int                   timeout;
    int                   rand;
-   int                   padint;
+   int                   dict_lock_init; // dict_lock has been initialized
 };
 
 
@@ -104,13 +104,19 @@ tinyrad_set_option_socket_bind_addresses(
 
 
 int
-tinyrad_tiyrad_defaults(
+tinyrad_tinyrad_defaults(
          TinyRad *                     tr,
          unsigned                      opts );
 
 
 void
-tinyrad_tiyrad_free(
+tinyrad_tinyrad_dict_swap(
+         TinyRad *                     tr,
+         TinyRadDict *                 dict );
+
+
+void
+tinyrad_tinyrad_free(
          TinyRad *                     tr );
 
 
@@ -338,7 +344,7 @@ tinyrad_srandom_seed(
 #pragma mark TinyRad functions
 
 int
-tinyrad_tiyrad_defaults(
+tinyrad_tinyrad_defaults(
          TinyRad *                     tr,
          unsigned                      opts )
 {
@@ -385,11 +391,70 @@ tinyrad_tiyrad_defaults(
 }
 
 
+/// Retains dictionary currently published to Tiny RADIUS reference
+///
+/// Callers keep using the returned dictionary after it has been replaced,
+/// the dictionary is freed once the last reference is released.
+///
+/// @param[in]  tr            Tiny RADIUS reference
+/// @return returns retained dictionary reference
+TinyRadDict *
+tinyrad_tinyrad_dict(
+         TinyRad *                     tr )
+{
+   TinyRadDict *     dict;
+
+   TinyRadDebugTrace();
+
+   assert(tr != NULL);
+
+   pthread_mutex_lock(&tr->dict_lock);
+   dict = tinyrad_obj_retain(&tr->dict->obj);
+   pthread_mutex_unlock(&tr->dict_lock);
+
+   return(dict);
+}
+
+
+/// Publishes dictionary to Tiny RADIUS reference
+///
+/// Only the swap is performed here, callers which reload dictionaries parse
+/// and freeze the new dictionary on their own thread before publishing it.
+///
+/// @param[in]  tr            Tiny RADIUS reference
+/// @param[in]  dict          read-only dictionary reference
+void
+tinyrad_tinyrad_dict_swap(
+         TinyRad *                     tr,
+         TinyRadDict *                 dict )
+{
+   TinyRadDict *     old;
+
+   TinyRadDebugTrace();
+
+   assert(tr   != NULL);
+   assert(dict != NULL);
+
+   dict = tinyrad_obj_retain(&dict->obj);
+
+   pthread_mutex_lock(&tr->dict_lock);
+   old      = tr->dict;
+   tr->dict = dict;
+   pthread_mutex_unlock(&tr->dict_lock);
+
+   // readers which retained the previous dictionary keep it alive
+   if ((old))
+      tinyrad_obj_release(&old->obj);
+
+   return;
+}
+
+
 /// destroy Tiny RADIUS reference
 ///
 /// @param[in]  tr            dictionary reference
 void
-tinyrad_tiyrad_free(
+tinyrad_tinyrad_free(
          TinyRad *                     tr )
 {
    TinyRadDebugTrace();
@@ -399,6 +464,9 @@ tinyrad_tiyrad_free(
    if ((tr->dict))
       tinyrad_obj_release(&tr->dict->obj);
 
+   if ((tr->dict_lock_init))
+      pthread_mutex_destroy(&tr->dict_lock);
+
    if ((tr->secret))
       free(tr->secret);
 
@@ -493,7 +561,7 @@ tinyrad_get_option(
 
       case TRAD_OPT_DICTIONARY:
       TinyRadDebug(TRAD_DEBUG_ARGS, "   == %s( tr, TRAD_OPT_DICTIONARY, outvalue )", __func__);
-      *((TinyRadDict **)outvalue) = tinyrad_obj_retain(&tr->dict->obj);
+      *((TinyRadDict **)outvalue) = tinyrad_tinyrad_dict(tr);
       break;
 
       case TRAD_OPT_IPV4:
@@ -605,19 +673,25 @@ tinyrad_initialize(
 
    TinyRadDebug(TRAD_DEBUG_ARGS, "   == %s( \"%s\", 0x08x )", __func__, url, opts);
 
-   if ((tr = tinyrad_obj_alloc(sizeof(TinyRad), (void(*)(void*))&tinyrad_tiyrad_free)) == NULL)
+   if ((tr = tinyrad_obj_alloc(sizeof(TinyRad), (void(*)(void*))&tinyrad_tinyrad_free)) == NULL)
       return(TRAD_ENOMEM);
    tr->opts       = (uint32_t)(opts & TRAD_OPTS_USER);
    tr->s          = -1;
    tr->timeout    = -1;
    tr->rand       = -1;
+   if (pthread_mutex_init(&tr->dict_lock, NULL) != 0)
+   {
+      tinyrad_tinyrad_free(tr);
+      return(TRAD_ENOMEM);
+   };
+   tr->dict_lock_init = 1;
 
    // parses and saves URL
    if ((url))
    {
       if ((rc = tinyrad_set_option(tr, TRAD_OPT_URI, url)) != TRAD_SUCCESS)
       {
-         tinyrad_tiyrad_free(tr);
+         tinyrad_tinyrad_free(tr);
          return(rc);
       };
    };
@@ -627,7 +701,7 @@ tinyrad_initialize(
    {
       if ((rc = tinyrad_dict_initialize(&tr->dict, (opts|TRAD_NOINIT))) != TRAD_SUCCESS)
       {
-         tinyrad_tiyrad_free(tr);
+         tinyrad_tinyrad_free(tr);
          return(rc);
       };
    };
@@ -635,7 +709,7 @@ tinyrad_initialize(
    // read init files
    if ((rc = tinyrad_conf(tr, (((dict)) ? NULL : tr->dict), opts)) != TRAD_SUCCESS)
    {
-      tinyrad_tiyrad_free(tr);
+      tinyrad_tinyrad_free(tr);
       return(rc);
    };
 
@@ -644,31 +718,35 @@ tinyrad_initialize(
    {
       if ((rc = tinyrad_dict_defaults(tr->dict, NULL, opts)) != TRAD_SUCCESS)
       {
-         tinyrad_tiyrad_free(tr);
+         tinyrad_tinyrad_free(tr);
          return(rc);
       };
       opt = TRAD_YES;
-      tinyrad_dict_set_option(tr->dict, TRAD_DICT_OPT_READONLY, &opt);
+      if ((rc = tinyrad_dict_set_option(tr->dict, TRAD_DICT_OPT_READONLY, &opt)) != TRAD_SUCCESS)
+      {
+         tinyrad_tinyrad_free(tr);
+         return(rc);
+      };
    };
 
    // apply defaults
-   if ((rc = tinyrad_tiyrad_defaults(tr, opts)) != TRAD_SUCCESS)
+   if ((rc = tinyrad_tinyrad_defaults(tr, opts)) != TRAD_SUCCESS)
    {
-      tinyrad_tiyrad_free(tr);
+      tinyrad_tinyrad_free(tr);
       return(rc);
    };
 
    // initialize random number generator
    if ((rc = tinyrad_srandom(tr)) != TRAD_SUCCESS)
    {
-      tinyrad_tiyrad_free(tr);
+      tinyrad_tinyrad_free(tr);
       return(rc);
    };
 
    // generates initial authenticator
    if ((rc = tinyrad_random_buf(tr, &tr->authenticator, sizeof(tr->authenticator))) != TRAD_SUCCESS)
    {
-      tinyrad_tiyrad_free(tr);
+      tinyrad_tinyrad_free(tr);
       return(rc);
    };
 
@@ -687,6 +765,7 @@ tinyrad_set_option(
    uint32_t             opts;
    int                  rc;
    TinyRadURLDesc *     trud;
+   TinyRadDict *        dict;
    char                 buff[256];
 
    TinyRadDebugTrace();
@@ -738,7 +817,11 @@ tinyrad_set_option(
 
       case TRAD_OPT_DICTIONARY:
       TinyRadDebug(TRAD_DEBUG_ARGS, "   == %s( tr, TRAD_OPT_DICTIONARY, invalue )", __func__);
-      return(TRAD_EOPTERR);
+      dict = (TinyRadDict *)((uintptr_t)invalue);
+      if (tinyrad_dict_is_readonly(dict) != TRAD_YES)
+         return(TRAD_EINVAL);
+      tinyrad_tinyrad_dict_swap(tr, dict);
+      break;
 
       case TRAD_OPT_IPV4:
       TinyRadDebug(TRAD_DEBUG_ARGS, "   == %s( tr, TRAD_OPT_IPV4, %s )", __func__, (((*((const int *)invalue))) ? "TRAD_ON" : "TRAD_OFF"));
@@ -87,6 +87,16 @@ tinyrad_random_buf(
          size_t                        nbytes );
 
 
+//--------------------//
+// TinyRad prototypes //
+//--------------------//
+#pragma mark TinyRad prototypes
+
+TinyRadDict *
+tinyrad_tinyrad_dict(
+         TinyRad *                     tr );
+
+
 //--------------------------------//
 // TinyRadBinValue list functions //
 //--------------------------------//
@@ -102,8 +102,8 @@ tinyrad_attr_vals_alloc(
 
 int
 tinyrad_attr_vals_cmp_key(
-         const TinyRadAttrValues **    obj,
-         const TinyRadObj *            oid );
+         TinyRadAttrValues * const *   obj,
+         const TinyRadOID *            oid );
 
 
 int
@@ -130,6 +130,14 @@ tinyrad_attr_vals_lookup(
          const TinyRadOID *            attr_oid );
 
 
+static ssize_t
+tinyrad_attr_vals_search(
+         TinyRadAttrValues * const *   base,
+         size_t                        nel,
+         const TinyRadOID *            key,
+         unsigned                      opts );
+
+
 //------------------------//
 // pckt memory prototypes //
 //------------------------//
@@ -198,7 +206,6 @@ tinyrad_attr_list_add_vals(
          TinyRadAttrValues **          avp,
          const TinyRadOID *            attr_oid )
 {
-   void *               ptr;
    ssize_t              rc;
    size_t               width;
    uint8_t              attr_data_type;
@@ -214,13 +221,6 @@ tinyrad_attr_list_add_vals(
    assert(list       != NULL);
    assert(attr_oid   != NULL);
 
-   // increase size of array
-   if ((ptr = realloc(list->attrvals, (sizeof(TinyRadAttrValues *) * (list->attrvals_len+2)))) == NULL)
-      return(TRAD_ENOMEM);
-   list->attrvals                       = ptr;
-   list->attrvals[list->attrvals_len+0] = NULL;
-   list->attrvals[list->attrvals_len+1] = NULL;
-
    // look up attribute name
    attr_name      = NULL;
    attr_flags     = 0;
@@ -251,6 +251,13 @@ tinyrad_attr_list_add_vals(
    opts        = TINYRAD_ARRAY_INSERT;
    compar      = (int(*)(const void*, const void*)) &tinyrad_attr_vals_cmp_obj;
 
+   // grow list geometrically before saving value
+   if (tinyrad_array_grow(listp, *lenp, &list->attrvals_size, width, &realloc) != 0)
+   {
+      tinyrad_obj_release(&av->obj);
+      return(TRAD_ENOMEM);
+   };
+
    // save value to list
    if ((rc = tinyrad_array_add(listp, lenp, width, &av, opts, compar, NULL, NULL)) < 0)
    {
@@ -309,15 +316,18 @@ tinyrad_attr_list_initialize(
          TinyRadAttrList **            listp )
 {
    TinyRadAttrList *    list;
+   TinyRadDict *        dict;
 
    assert(tr    != NULL);
    assert(listp != NULL);
 
-   if ((list = tinyrad_attr_list_alloc(tr->dict)) == NULL)
+   // list keeps the dictionary published when it was created
+   dict = tinyrad_tinyrad_dict(tr);
+   list = tinyrad_attr_list_alloc(dict);
+   tinyrad_obj_release(&dict->obj);
+   if (!(list))
       return(TRAD_ENOMEM);
 
-   list->dict = tinyrad_obj_retain(&tr->dict->obj);
-
    *listp = tinyrad_obj_retain(&list->obj);
 
    return(TRAD_SUCCESS);
@@ -394,8 +404,8 @@ tinyrad_attr_vals_alloc(
 
 int
 tinyrad_attr_vals_cmp_key(
-         const TinyRadAttrValues **    obj,
-         const TinyRadObj *            oid )
+         TinyRadAttrValues * const *   obj,
+         const TinyRadOID *            oid )
 {
    int   rc;
    if ((rc = tinyrad_oid_cmp(&(*obj)->oid, &oid)) != 0)
@@ -443,24 +453,10 @@ tinyrad_attr_vals_index(
          TinyRadAttrList *             list,
          const TinyRadOID *            attr_oid )
 {
-   void *               list_ptr;
-   size_t               list_len;
-   size_t               list_width;
-   unsigned             opts;
-   int (*compar)(const void *, const void *);
-
    TinyRadDebugTrace();
-
    assert(list     != NULL);
    assert(attr_oid != NULL);
-
-   list_ptr    = list->attrvals;
-   list_len    = list->attrvals_len;
-   list_width  = sizeof(TinyRadAttrValues *);
-   opts        = TINYRAD_ARRAY_LASTDUP;
-   compar      = (int(*)(const void *, const void *))&tinyrad_attr_vals_cmp_key;
-
-   return(tinyrad_array_search(list_ptr, list_len, list_width, attr_oid, opts, NULL, compar));
+   return(tinyrad_attr_vals_search(list->attrvals, list->attrvals_len, attr_oid, TINYRAD_ARRAY_LASTDUP));
 }
 
 
@@ -502,6 +498,10 @@ tinyrad_attr_vals_lookup(
 }
 
 
+/// Searches sorted attribute values without indirect comparator calls
+TINYRAD_ARRAY_SEARCH_FUNC(static, tinyrad_attr_vals_search, TinyRadAttrValues *, const TinyRadOID *, tinyrad_attr_vals_cmp_key)
+
+
 //-----------------------//
 // pckt memory functions //
 //-----------------------//
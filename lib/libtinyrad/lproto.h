@@ -82,6 +82,7 @@ struct _tinyrad_attr_list
    TinyRadObj           obj;
    TinyRadDict *        dict;
    size_t               attrvals_len;
+   size_t               attrvals_size;
    TinyRadAttrValues ** attrvals;
 };
 
@@ -75,6 +75,12 @@
 //////////////////
 #pragma mark - Prototypes
 
+static const char *
+tinyrad_strexpand_token(
+         int                           token,
+         char *                        buff,
+         size_t                        size );
+
 
 /////////////////
 //             //
@@ -118,12 +124,8 @@ tinyrad_strexpand(
    size_t            offset;
    char              buff[4096];
    char *            ptr;
+   const char *      token;
    char              quote;
-   struct utsname    unam;
-   struct passwd     pwd;
-   struct passwd *   pwres;
-   struct group      grp;
-   struct group *    grres;
 
    TinyRadDebugTrace();
 
@@ -162,88 +164,20 @@ tinyrad_strexpand(
          switch(src[pos])
          {
             case 'D': // domain name
-            if (uname(&unam) == -1)
-               return(NULL);
-            strncpy(buff, unam.nodename, sizeof(buff));
-            if ((ptr = strchr(buff, '.')) == NULL)
-               buff[0] = '\0';
-            ptr = ((ptr)) ? &ptr[1] : buff;
-            dst[offset] = '\0';
-            tinyrad_strlcat(dst, ptr, len);
-            offset += strlen(ptr);
-            break;
-
             case 'd': // home directory
-            getpwuid_r(getuid(), &pwd, buff, sizeof(buff), &pwres);
-            if (!(pwres))
-               break;
-            dst[offset] = '\0';
-            tinyrad_strlcat(dst, pwres->pw_dir, len);
-            offset += strlen(pwres->pw_dir);
-            break;
-
             case 'G': // gid
-            snprintf(buff, sizeof(buff), "%u", getgid());
-            dst[offset] = '\0';
-            tinyrad_strlcat(dst, buff, len);
-            offset += strlen(buff);
-            break;
-
             case 'g': // group name
-            getgrgid_r(getgid(), &grp, buff, sizeof(buff), &grres);
-            if (!(grres))
-               break;
-            dst[offset] = '\0';
-            tinyrad_strlcat(dst, grres->gr_name, len);
-            offset += strlen(grres->gr_name);
-            break;
-
             case 'H': // fully qualified hostname
-            if (uname(&unam) == -1)
-               break;
-            dst[offset] = '\0';
-            tinyrad_strlcat(dst, unam.nodename, len);
-            offset += strlen(unam.nodename);
-            break;
-
             case 'h': // short hostname
-            if (uname(&unam) == -1)
-               break;
-            strncpy(buff, unam.nodename, sizeof(buff));
-            if ((ptr = strchr(buff, '.')) != NULL)
-               ptr[0] = '\0';
-            dst[offset] = '\0';
-            tinyrad_strlcat(dst, buff, len);
-            offset += strlen(buff);
-            break;
-
             case 'P': // process ID
-            snprintf(buff, sizeof(buff), "%u", getppid());
-            dst[offset] = '\0';
-            tinyrad_strlcat(dst, buff, len);
-            offset += strlen(buff);
-            break;
-
             case 'p': // process name/ident
-            dst[offset] = '\0';
-            tinyrad_strlcat(dst, tinyrad_debug_ident, len);
-            offset += strlen(tinyrad_debug_ident);
-            break;
-
             case 'U': // uid
-            snprintf(buff, sizeof(buff), "%u", getgid());
-            dst[offset] = '\0';
-            tinyrad_strlcat(dst, buff, len);
-            offset += strlen(buff);
-            break;
-
             case 'u': // username
-            getpwuid_r(getuid(), &pwd, buff, sizeof(buff), &pwres);
-            if (!(pwres))
-               break;
+            if ((token = tinyrad_strexpand_token(src[pos], buff, sizeof(buff))) == NULL)
+               return(NULL);
             dst[offset] = '\0';
-            tinyrad_strlcat(dst, pwres->pw_name, len);
-            offset += strlen(pwres->pw_name);
+            tinyrad_strlcat(dst, token, len);
+            offset += strlen(token);
             break;
 
             case '%': // '%' character
@@ -323,6 +257,310 @@ tinyrad_strexpand(
 }
 
 
+/// Compiles a string into a template for repeated expansion
+///
+/// Quotes are removed and escape sequences are decoded once using the rules
+/// of tinyrad_strexpand(), leaving only '%' tokens to resolve when the
+/// template is expanded.  A template without tokens expands with a single
+/// memcpy().  The template is freed with tinyrad_free().
+///
+/// @param[in]  src               string to compile
+/// @param[in]  force_expansion   expand strings which are not double quoted
+/// @param[out] tmplp             reference to store compiled template
+/// @return returns TRAD_SUCCESS, TRAD_ENOMEM, or TRAD_ESYNTAX if an escape
+///         sequence or quoted string is malformed.
+int
+tinyrad_strexpand_compile(
+         const char *                  src,
+         int                           force_expansion,
+         TinyRadStrTmpl **             tmplp )
+{
+   int               token;
+   size_t            pos;
+   size_t            len;
+   char              c;
+   char              quote;
+   char              buff[4];
+   char *            ptr;
+   TinyRadStrSeg *   seg;
+   TinyRadStrTmpl *  tmpl;
+
+   TinyRadDebugTrace();
+
+   assert(src   != NULL);
+   assert(tmplp != NULL);
+
+   // allocate template with room for a segment per character
+   len = strlen(src);
+   if ((tmpl = malloc(sizeof(TinyRadStrTmpl) + ((len + 1) * sizeof(TinyRadStrSeg)) + len + 1)) == NULL)
+      return(TRAD_ENOMEM);
+   memset(tmpl, 0, sizeof(TinyRadStrTmpl));
+   tmpl->segs = (TinyRadStrSeg *)&tmpl[1];
+   tmpl->text = (char *)&tmpl->segs[len+1];
+   seg        = NULL;
+
+   // decode escapes into literal segments separated by tokens
+   quote  = ((src[0] == '\'')||(src[0] == '"')) ? src[0] : 0;
+   for(pos = (((quote)) ? 1 : 0); ((src[pos])); pos++)
+   {
+      c     = src[pos];
+      token = 0;
+      if ( ((quote == '"') || (force_expansion == TRAD_YES)) && ((src[pos+1])) )
+      {
+         switch(c)
+         {
+            case '%':
+            c = src[++pos];
+            if ((strchr("DdGgHhPpUu", c)))
+               token = c;
+            break;
+
+            case '\\':
+            switch(c = src[++pos])
+            {
+               case 'n': c = '\n'; break;
+               case 'r': c = '\r'; break;
+               case 't': c = '\t'; break;
+               case 'v': c = '\v'; break;
+
+               // \xnn - treat nn as hex value
+               case 'x':
+               buff[0] = src[pos+1];
+               buff[1] = ((buff[0])) ? src[pos+2] : '\0';
+               buff[2] = '\0';
+               c = (char)strtoul(buff, &ptr, 16);
+               if (ptr != &buff[2])
+               {
+                  free(tmpl);
+                  return(TRAD_ESYNTAX);
+               };
+               pos += 2;
+               break;
+
+               // \nnn - treat nnn as octal value
+               case '0':
+               case '1':
+               case '2':
+               case '3':
+               case '4':
+               case '5':
+               case '6':
+               case '7':
+               buff[0] = src[pos];
+               buff[1] = src[pos+1];
+               buff[2] = ((buff[1])) ? src[pos+2] : '\0';
+               buff[3] = '\0';
+               c = (char)strtoul(buff, &ptr, 8);
+               if (ptr != &buff[3])
+               {
+                  free(tmpl);
+                  return(TRAD_ESYNTAX);
+               };
+               pos += 2;
+               break;
+
+               default:
+               break;
+            };
+            break;
+
+            default:
+            break;
+         };
+      };
+
+      // append token segment
+      if ((token))
+      {
+         seg         = &tmpl->segs[tmpl->segs_len++];
+         seg->token  = token;
+         seg->len    = 0;
+         continue;
+      };
+
+      // append character to literal segment
+      if ( (!(seg)) || ((seg->token)) )
+      {
+         seg         = &tmpl->segs[tmpl->segs_len++];
+         seg->token  = 0;
+         seg->len    = 0;
+      };
+      tmpl->text[tmpl->text_len++] = c;
+      seg->len++;
+   };
+   tmpl->text[tmpl->text_len] = '\0';
+
+   // remove closing quote
+   if ((quote))
+   {
+      if (!(seg))
+      {
+         free(tmpl);
+         return(TRAD_ESYNTAX);
+      };
+      if ((seg->token))
+         tmpl->trim = 1;
+      else if ((--seg->len))
+         tmpl->text[--tmpl->text_len] = '\0';
+      else
+      {
+         tmpl->text[--tmpl->text_len] = '\0';
+         tmpl->segs_len--;
+      };
+   };
+
+   *tmplp = tmpl;
+
+   return(TRAD_SUCCESS);
+}
+
+
+/// Expands a compiled string template
+///
+/// @param[out] dst           buffer to store expanded string
+/// @param[in]  tmpl          template returned by tinyrad_strexpand_compile()
+/// @param[in]  len           size of buffer
+/// @return returns dst, or NULL if a token could not be resolved or the
+///         expansion was truncated to fit the buffer.
+char *
+tinyrad_strexpand_tmpl(
+         char *                        dst,
+         const TinyRadStrTmpl *        tmpl,
+         size_t                        len )
+{
+   size_t            pos;
+   size_t            offset;
+   size_t            size;
+   char              buff[4096];
+   const char *      str;
+   const char *      text;
+
+   TinyRadDebugTrace();
+
+   assert(dst  != NULL);
+   assert(tmpl != NULL);
+   assert(len   > 0);
+
+   offset = 0;
+   text   = tmpl->text;
+   for(pos = 0; (pos < tmpl->segs_len); pos++)
+   {
+      if (!(tmpl->segs[pos].token))
+      {
+         str   = text;
+         size  = tmpl->segs[pos].len;
+         text += size;
+      }
+      else
+      {
+         if ((str = tinyrad_strexpand_token(tmpl->segs[pos].token, buff, sizeof(buff))) == NULL)
+            return(NULL);
+         size = strlen(str);
+      };
+      if ((offset + size) >= len)
+      {
+         memcpy(&dst[offset], str, (len - offset - 1));
+         dst[len-1] = '\0';
+         return(NULL);
+      };
+      memcpy(&dst[offset], str, size);
+      offset += size;
+   };
+
+   if ((tmpl->trim))
+   {
+      if (!(offset))
+      {
+         dst[0] = '\0';
+         return(NULL);
+      };
+      offset--;
+   };
+   dst[offset] = '\0';
+
+   return(dst);
+}
+
+
+/// Resolves a '%' token of an expanded string
+///
+/// @param[in]  token         character following '%'
+/// @param[in]  buff          scratch buffer which may hold the value
+/// @param[in]  size          size of scratch buffer
+/// @return returns value of token, an empty string if the value is not
+///         available, or NULL on error.
+static const char *
+tinyrad_strexpand_token(
+         int                           token,
+         char *                        buff,
+         size_t                        size )
+{
+   char *            ptr;
+   struct utsname    unam;
+   struct passwd     pwd;
+   struct passwd *   pwres;
+   struct group      grp;
+   struct group *    grres;
+
+   switch(token)
+   {
+      case 'D': // domain name
+      if (uname(&unam) == -1)
+         return(NULL);
+      strncpy(buff, unam.nodename, size);
+      if ((ptr = strchr(buff, '.')) == NULL)
+         buff[0] = '\0';
+      return(((ptr)) ? &ptr[1] : buff);
+
+      case 'd': // home directory
+      getpwuid_r(getuid(), &pwd, buff, size, &pwres);
+      return(((pwres)) ? pwres->pw_dir : "");
+
+      case 'G': // gid
+      snprintf(buff, size, "%u", getgid());
+      return(buff);
+
+      case 'g': // group name
+      getgrgid_r(getgid(), &grp, buff, size, &grres);
+      return(((grres)) ? grres->gr_name : "");
+
+      case 'H': // fully qualified hostname
+      if (uname(&unam) == -1)
+         return("");
+      strncpy(buff, unam.nodename, size);
+      return(buff);
+
+      case 'h': // short hostname
+      if (uname(&unam) == -1)
+         return("");
+      strncpy(buff, unam.nodename, size);
+      if ((ptr = strchr(buff, '.')) != NULL)
+         ptr[0] = '\0';
+      return(buff);
+
+      case 'P': // process ID
+      snprintf(buff, size, "%u", getppid());
+      return(buff);
+
+      case 'p': // process name/ident
+      return(tinyrad_debug_ident);
+
+      case 'U': // uid
+      snprintf(buff, size, "%u", getgid());
+      return(buff);
+
+      case 'u': // username
+      getpwuid_r(getuid(), &pwd, buff, size, &pwres);
+      return(((pwres)) ? pwres->pw_name : "");
+
+      default:
+      break;
+   };
+
+   return("");
+}
+
+
 size_t
 tinyrad_strlcpy(
          char * restrict               dst,
@@ -588,6 +826,75 @@ tinyrad_strsplit(
 }
 
 
+/// Splits string at delimiter into spans without copying the string
+///
+/// Uses the same rules as tinyrad_strsplit(), delimiters within quotes do not
+/// split the string.
+///
+/// @param[in]  str           string to split
+/// @param[in]  len           maximum length of string, splitting also stops at NUL
+/// @param[in]  delim         delimiter
+/// @param[out] spans         caller provided array of spans
+/// @param[in]  max           number of spans in array
+/// @param[out] countp        number of spans stored
+/// @return returns TRAD_SUCCESS, TRAD_ESYNTAX if a quote is not terminated, or
+///         TRAD_ENOBUFS if the string contains more than max spans.
+int
+tinyrad_strsplitspans(
+         const char *                  str,
+         size_t                        len,
+         int                           delim,
+         TinyRadSpan *                 spans,
+         size_t                        max,
+         size_t *                      countp )
+{
+   char           quote;
+   size_t         pos;
+   size_t         bol;
+   size_t         count;
+
+   TinyRadDebugTrace();
+
+   assert(str    != NULL);
+   assert(delim  != 0);
+   assert(countp != NULL);
+
+   *countp = 0;
+   count   = 0;
+   bol     = 0;
+
+   for(pos = 0; ( (pos < len) && ((str[pos])) ); pos++)
+   {
+      if ( ((str[pos] == '"') || (str[pos] == '\'')) && (str[pos] != delim) )
+      {
+         quote = str[pos];
+         for(pos += 1; ( (pos < len) && (str[pos] != '\0') && (str[pos] != quote) ); pos++)
+            if ( (quote == '"') && (str[pos] == '\\') && ((pos+1) < len) && (str[pos+1] == '"') )
+               pos++;
+         if ( (pos >= len) || (str[pos] != quote) )
+            return(TRAD_ESYNTAX);
+         continue;
+      };
+      if (str[pos] != delim)
+         continue;
+      if (count >= max)
+         return(TRAD_ENOBUFS);
+      spans[count].str = &str[bol];
+      spans[count].len = pos - bol;
+      count++;
+      bol = pos + 1;
+   };
+
+   if (count >= max)
+      return(TRAD_ENOBUFS);
+   spans[count].str = &str[bol];
+   spans[count].len = pos - bol;
+   *countp = count + 1;
+
+   return(TRAD_SUCCESS);
+}
+
+
 int
 tinyrad_strtoargs(
          char *                        str,
@@ -693,6 +1000,55 @@ tinyrad_strtoargs(
 }
 
 
+/// Splits string into arguments in place without allocating memory
+///
+/// Each argument is terminated within str and argv is terminated by NULL.
+///
+/// @param[in]  str           string to split, modified by this function
+/// @param[out] argv          caller provided array of at most TRAD_ARGV_MAX pointers
+/// @param[in]  max           number of pointers in argv
+/// @param[out] argcp         number of arguments
+/// @return returns TRAD_SUCCESS, or TRAD_ESYNTAX if the string is malformed or
+///         has more than max - 1 arguments.
+int
+tinyrad_strtoargv(
+         char *                        str,
+         char **                       argv,
+         size_t                        max,
+         int *                         argcp )
+{
+   int            rc;
+   size_t         pos;
+   size_t         count;
+   TinyRadSpan    spans[TRAD_ARGV_MAX];
+
+   TinyRadDebugTrace();
+
+   assert(str   != NULL);
+   assert(argv  != NULL);
+   assert(max   >  0);
+   assert(max   <= TRAD_ARGV_MAX);
+   assert(argcp != NULL);
+
+   argv[0] = NULL;
+   *argcp  = 0;
+
+   if ((rc = tinyrad_strtospans(str, strlen(str), spans, (max - 1), &count)) != TRAD_SUCCESS)
+      return((rc == TRAD_ENOBUFS) ? TRAD_ESYNTAX : rc);
+
+   // arguments are followed by white space, a comment, or end of string
+   for(pos = 0; (pos < count); pos++)
+   {
+      argv[pos] = &str[spans[pos].str - str];
+      argv[pos][spans[pos].len] = '\0';
+   };
+   argv[count] = NULL;
+   *argcp      = (int)count;
+
+   return(TRAD_SUCCESS);
+}
+
+
 int
 tinyrad_strtobool(
          const char *                  str )
@@ -708,6 +1064,88 @@ tinyrad_strtobool(
 }
 
 
+/// Splits string into argument spans without copying or modifying the string
+///
+/// Uses the same rules as tinyrad_strtoargs(): arguments are separated by
+/// white space, '#' starts a comment, and quoted arguments include their
+/// quotes.  The string does not need to be NUL terminated, so lines may be
+/// tokenized within a mapped file.
+///
+/// @param[in]  str           string to split
+/// @param[in]  len           maximum length of string, splitting also stops at NUL
+/// @param[out] spans         caller provided array of spans
+/// @param[in]  max           number of spans in array
+/// @param[out] countp        number of spans stored
+/// @return returns TRAD_SUCCESS, TRAD_ESYNTAX if the string is malformed, or
+///         TRAD_ENOBUFS if the string contains more than max arguments.
+int
+tinyrad_strtospans(
+         const char *                  str,
+         size_t                        len,
+         TinyRadSpan *                 spans,
+         size_t                        max,
+         size_t *                      countp )
+{
+   char           quote;
+   size_t         pos;
+   size_t         bol;
+   size_t         count;
+
+   TinyRadDebugTrace();
+
+   assert(str    != NULL);
+   assert(countp != NULL);
+
+   *countp = 0;
+   count   = 0;
+   pos     = 0;
+
+   while ( (pos < len) && (str[pos] != '\0') && (str[pos] != '#') )
+   {
+      bol = pos;
+      switch(str[pos])
+      {
+         // skip white space
+         case ' ':
+         case '\t':
+         pos++;
+         continue;
+
+         // span quoted argument
+         case '"':
+         case '\'':
+         quote = str[pos];
+         for(pos += 1; ( (pos < len) && (str[pos] != '\0') && (str[pos] != quote) ); pos++)
+            if ( (quote == '"') && (str[pos] == '\\') && ((pos+1) < len) && (str[pos+1] == '"') )
+               pos++;
+         if ( (pos >= len) || (str[pos] != quote) )
+            return(TRAD_ESYNTAX);
+         pos++;
+         if ( (pos < len) && (str[pos] != '\0') && (str[pos] != '#') && (str[pos] != ' ') && (str[pos] != '\t') )
+            return(TRAD_ESYNTAX);
+         break;
+
+         // span unquoted argument
+         default:
+         for(; ( (pos < len) && (str[pos] != ' ') && (str[pos] != '\t') && (str[pos] != '\0') && (str[pos] != '#') ); pos++)
+            if ( (str[pos] < '!') || (str[pos] > '~') || (str[pos] == '"') || (str[pos] == '\'') )
+               return(TRAD_ESYNTAX);
+         break;
+      };
+
+      if (count >= max)
+         return(TRAD_ENOBUFS);
+      spans[count].str = &str[bol];
+      spans[count].len = pos - bol;
+      count++;
+   };
+
+   *countp = count;
+
+   return(TRAD_SUCCESS);
+}
+
+
 char *
 tinyrad_strtrim(
          char *                        str )
@@ -55,6 +55,33 @@
 #pragma mark - Definitions
 
 
+//////////////////
+//              //
+//  Data Types  //
+//              //
+//////////////////
+#pragma mark - Data Types
+
+// segment of a compiled string template
+typedef struct tinyrad_str_seg
+{
+   size_t                  len;     // length of literal text, zero for a token
+   int                     token;   // '%' token expanded at run time, zero for literal text
+   int                     padint;
+} TinyRadStrSeg;
+
+
+struct tinyrad_str_tmpl
+{
+   size_t                  segs_len;   // number of segments
+   size_t                  text_len;   // length of all literal text
+   int                     trim;       // drop final character of expansion (closing quote)
+   int                     padint;
+   TinyRadStrSeg *         segs;       // segments in order of expansion
+   char *                  text;       // literal text of all segments, escapes decoded
+};
+
+
 //////////////////
 //              //
 //  Prototypes  //
@@ -70,9 +70,12 @@ trutils_close(
    if (!(fb))
       return;
 
-   if (fb->fd != -1)
+   if ( (fb->fd != -1) && (fb->fd != STDIN_FILENO) )
       close(fb->fd);
 
+   if ((fb->buff))
+      free(fb->buff);
+
    if ((fb->filename))
       free(fb->filename);
 
@@ -82,25 +85,40 @@ trutils_close(
 }
 
 
+/// Opens a file for reading one line at a time
+///
+/// The file is read through a buffer of `size` bytes which is doubled
+/// whenever a single line does not fit, so line length is bounded only by
+/// available memory.  Pipes and character devices are accepted in addition
+/// to regular files, and a filename of "-" reads from standard input.
+///
+/// @param[in]  opts          utility options
+/// @param[in]  filename      path of file, or "-" for standard input
+/// @param[in]  size          initial size of read buffer, 0 for default
+/// @return Returns file buffer on success or NULL on error.
 TRUtilsFile *
 trutils_open(
          unsigned                      opts,
-         const char *                  filename )
+         const char *                  filename,
+         size_t                        size )
 {
    TRUtilsFile *  fb;
    struct stat    sb;
 
    assert(filename != NULL);
 
+   size = ((size)) ? size : TRUTILS_FILE_BUFF_SIZE;
+   size = (size < TRUTILS_FILE_BUFF_MIN) ? TRUTILS_FILE_BUFF_MIN : size;
+
    // verify file exists
-   if (stat(filename, &sb) == -1)
+   if ( ((strcmp("-", filename))) && (stat(filename, &sb) == -1) )
    {
       trutils_error(opts,  NULL, "%s: %s", filename, strerror(errno));
       return(NULL);
    };
-   if ((sb.st_mode & S_IFMT) != S_IFREG)
+   if ( ((strcmp("-", filename))) && ((sb.st_mode & S_IFMT) == S_IFDIR) )
    {
-      trutils_error(opts,  NULL, "%s: is not a file", filename);
+      trutils_error(opts,  NULL, "%s: is a directory", filename);
       return(NULL);
    };
 
@@ -121,7 +139,21 @@ trutils_open(
       return(NULL);
    };
 
+   // allocate buffer
+   if ((fb->buff = malloc(size)) == NULL)
+   {
+      trutils_error(opts,  NULL, "out of virtual memory");
+      trutils_close(fb);
+      return(NULL);
+   };
+   fb->size = size;
+
    // open file
+   if (!(strcmp("-", filename)))
+   {
+      fb->fd = STDIN_FILENO;
+      return(fb);
+   };
    if ((fb->fd = open(filename, O_RDONLY)) == -1)
    {
       trutils_error(opts,  NULL, "%s: %s", filename, strerror(errno));
@@ -129,62 +161,108 @@ trutils_open(
       return(NULL);
    };
 
+#ifdef POSIX_FADV_SEQUENTIAL
+   // hint kernel to read ahead aggressively
+   if ((sb.st_mode & S_IFMT) == S_IFREG)
+      posix_fadvise(fb->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
    return(fb);
 }
 
 
+/// Returns the next line from file
+///
+/// The returned line is a view into the file's buffer: it is NUL terminated
+/// with the line feed (and any preceding carriage return) removed, may be
+/// modified in place, and remains valid until the next call.  A final line
+/// without a line feed is returned as a complete line.
+///
+/// @param[in]  opts          utility options
+/// @param[in]  fb            file buffer
+/// @param[out] linep         reference to store start of line
+/// @param[out] lenp          reference to store length of line
+/// @return Returns 1 if a line was read, 0 at end of file, or -1 on error.
 int
 trutils_readline(
          unsigned                      opts,
-         TRUtilsFile *                 fb )
+         TRUtilsFile *                 fb,
+         char **                       linep,
+         size_t *                      lenp )
 {
-   size_t      offset;
-   size_t      pos;
+   size_t      len;
    size_t      size;
+   char *      line;
+   char *      eol;
    ssize_t     rc;
 
-   assert(fb != 0);
-
-   // adjusts beginning of line
-   fb->bol = ((fb->eol)) ? &fb->eol[1] : fb->buff;
+   assert(fb    != NULL);
+   assert(linep != NULL);
 
-   // look for end line
-   if ((fb->eol = strchr(fb->bol, '\n')) != NULL)
+   while(1)
    {
-      fb->eol[0] = '\0';
-      return(1);
-   };
+      // look for end of line within unread data
+      line = &fb->buff[fb->pos];
+      if ( (fb->pos < fb->len) && ((eol = memchr(line, '\n', (fb->len - fb->pos))) != NULL) )
+      {
+         len      = (size_t)(eol - line);
+         fb->pos += len + 1;
+         break;
+      };
 
-   // shift buffer
-   offset = (size_t)(fb->bol = fb->buff);
-   for(pos = 0; ((pos+offset) < fb->len); pos++)
-      fb->buff[pos] = fb->buff[pos+offset];
-   fb->buff[pos]  = '\0';
-   fb->len       -= offset;
+      // return remaining data as final line
+      if ((fb->eof))
+      {
+         if (fb->pos >= fb->len)
+            return(0);
+         len     = fb->len - fb->pos;
+         fb->pos = fb->len;
+         break;
+      };
 
-   // attempt to fill buffer
-   size = sizeof(fb->buff) - fb->len - 1;
-   if ((rc = read(fb->fd, &fb->buff[fb->len], size)) == -1)
-   {
-      trutils_error(opts, NULL, "%s: %s", fb->filename, strerror(errno));
-      return(-1);
-   };
-   fb->len           += (size_t)rc;
-   fb->buff[fb->len]  = '\0';
-   fb->bol            = fb->buff;
-   if (!(fb->len))
-      return(0);
-
-   // look for end line
-   if ((fb->eol = strchr(fb->bol, '\n')) != NULL)
-   {
-      fb->eol[0] = '\0';
-      return(1);
+      // shift partial line to start of buffer
+      if ((fb->pos))
+      {
+         memmove(fb->buff, line, (fb->len - fb->pos));
+         fb->len -= fb->pos;
+         fb->pos  = 0;
+      };
+
+      // grow buffer if partial line fills it, reserving room for terminator
+      if ((fb->len + 1) >= fb->size)
+      {
+         size = fb->size * 2;
+         if ((line = realloc(fb->buff, size)) == NULL)
+         {
+            trutils_error(opts, NULL, "out of virtual memory");
+            return(-1);
+         };
+         fb->buff = line;
+         fb->size = size;
+      };
+
+      // fill buffer
+      if ((rc = read(fb->fd, &fb->buff[fb->len], (fb->size - fb->len - 1))) == -1)
+      {
+         if (errno == EINTR)
+            continue;
+         trutils_error(opts, NULL, "%s: %s", fb->filename, strerror(errno));
+         return(-1);
+      };
+      fb->len += (size_t)rc;
+      fb->eof  = (rc == 0) ? 1 : 0;
    };
 
-   fb->eol = &fb->bol[strlen(fb->bol)];
+   // terminate line
+   if ( (len > 0) && (line[len-1] == '\r') )
+      len--;
+   line[len] = '\0';
+
+   *linep = line;
+   if ((lenp))
+      *lenp = len;
 
-   return(0);
+   return(1);
 }
 
 
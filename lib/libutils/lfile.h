@@ -54,6 +54,9 @@
 ///////////////////
 #pragma mark - Definitions
 
+#define TRUTILS_FILE_BUFF_SIZE   65536UL  // default initial size of read buffer
+#define TRUTILS_FILE_BUFF_MIN    64UL     // smallest accepted read buffer
+
 
 //////////////////
 //              //
@@ -65,11 +68,11 @@
 struct _trutils_file_buffer
 {
    int         fd;         // file descriptor
-   int         padint;
-   char *      eol;        // end of current line
-   char *      bol;        // beginning of current line
-   size_t      len;        // length of current buffer
-   char        buff[256];  // raw buffer
+   int         eof;        // end of file has been read
+   char *      buff;       // raw buffer, grows to hold the longest line
+   size_t      size;       // allocated size of buffer
+   size_t      len;        // number of bytes read into buffer
+   size_t      pos;        // offset of next unread line within buffer
    char *      filename;
 };
 
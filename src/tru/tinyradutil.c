@@ -378,7 +378,7 @@ tru_load_tinyrad(
       // parse dictionary files
       for(pos = 0; ( ((cnf->dict_files)) && ((cnf->dict_files[pos])) ); pos++)
       {
-         if ((rc = tinyrad_dict_parse(dict, cnf->dict_files[pos], &errs, 0)) != TRAD_SUCCESS)
+         if ((rc = tinyrad_dict_parse(dict, cnf->dict_files[pos], &errs, cnf->dict_opts)) != TRAD_SUCCESS)
          {
             tru_errors(cnf, rc, errs);
             tinyrad_strsfree(errs);
@@ -476,6 +476,10 @@ tru_getopt(
       cnf->tr_opts |= TRAD_BUILTIN_DICT;
       return(TRU_GETOPT_MATCHED);
 
+      case 'c':
+      cnf->compile_file = optarg;
+      return(TRU_GETOPT_MATCHED);
+
       case 'D':
       if ((rc = tinyrad_strsadd(&cnf->dict_files, optarg)) != TRAD_SUCCESS)
       {
@@ -505,10 +509,18 @@ tru_getopt(
       };
       return(TRU_GETOPT_MATCHED);
 
+      case 'j':
+      cnf->dict_opts |= TRAD_DICT_PARSE_PARALLEL;
+      return(TRU_GETOPT_MATCHED);
+
       case 'n':
       cnf->opts |= TRU_OPT_DRY_RUN;
       return(TRU_GETOPT_MATCHED);
 
+      case 'p':
+      cnf->attr_prefix = optarg;
+      return(TRU_GETOPT_MATCHED);
+
       case 'q':
       cnf->opts |=  TRUTILS_OPT_QUIET;
       cnf->opts &= ~TRUTILS_OPT_VERBOSE;
@@ -518,6 +530,11 @@ tru_getopt(
       cnf->opts |= TRU_OPT_RESOLVE;
       return(TRU_GETOPT_MATCHED);
 
+      case 's':
+      cnf->opts    |= TRU_OPT_STATS;
+      cnf->tr_opts |= TRAD_DICT_STATS;
+      return(TRU_GETOPT_MATCHED);
+
       case 'V':
       trutils_version();
       return(TRU_GETOPT_EXIT);
@@ -572,15 +589,19 @@ tru_usage_options(
    if ((strchr(s, '4'))) printf("  -4, --ipv4                use IPv4 addresses\n");
    if ((strchr(s, '6'))) printf("  -6, --ipv6                use IPv6 addresses\n");
    if ((strchr(s, 'b'))) printf("  -b, --builtin-dict        load built-in dictionary\n");
+   if ((strchr(s, 'c'))) printf("  -c file, --compile=file   write dictionary as C definition tables\n");
    if ((strchr(s, 'D'))) printf("  -D dictionary             include dictionary\n");
    if ((strchr(s, 'd'))) printf("  -d level, --debug=level   print debug messages\n");
    if ((strchr(s, 'f'))) printf("  -f file, --file=file      attribute list\n");
    if ((strchr(s, 'H'))) printf("  -H uri                    RADIUS URI\n");
    if ((strchr(s, 'h'))) printf("  -h, --help                print this help and exit\n");
    if ((strchr(s, 'I'))) printf("  -I path                   add path to dictionary search paths\n");
+   if ((strchr(s, 'j'))) printf("  -j, --parallel            parse included dictionary files in parallel\n");
    if ((strchr(s, 'n'))) printf("  -n, --dry-run             generate request without transmitting request\n");
+   if ((strchr(s, 'p'))) printf("  -p str, --prefix=str      list attribute names beginning with str\n");
    if ((strchr(s, 'q'))) printf("  -q, --quiet, --silent     do not print messages\n");
    if ((strchr(s, 'r'))) printf("  -r, --resolve             resolve URLs\n");
+   if ((strchr(s, 's'))) printf("  -s, --stats               print dictionary statistics\n");
    if ((strchr(s, 'V'))) printf("  -V, --version             print version number and exit\n");
    if ((strchr(s, 'v'))) printf("  -v, --verbose             print verbose messages\n");
 
@@ -78,6 +78,7 @@
 
 #define TRU_OPT_RESOLVE       0x0001
 #define TRU_OPT_DRY_RUN       0x0002
+#define TRU_OPT_STATS         0x0004
 
 
 #define TRU_COMMON_SHORT "d:hqVv"
@@ -91,9 +92,10 @@
    { NULL, 0, NULL, 0 }
 
 
-#define TRU_DICT_SHORT "bD:I:"
+#define TRU_DICT_SHORT "bD:I:j"
 #define TRU_DICT_LONG \
    { "builtin-dict",     no_argument,       NULL, 'b' }, \
+   { "parallel",         no_argument,       NULL, 'j' }, \
 
 
 #define TRU_NET_SHORT "H:46"
@@ -142,7 +144,7 @@ struct tinyrad_util_config
 {
    unsigned                   opts;
    unsigned                   tr_opts;
-   int                        padint;
+   uint32_t                   dict_opts;
    int                        argc;
    char **                    argv;
    const char *               widget_name;
@@ -154,7 +156,8 @@ struct tinyrad_util_config
    char **                    dict_files;
    char **                    dict_paths;
    const char *               attr_file;
-   void *                     padptr;
+   const char *               compile_file;
+   const char *               attr_prefix;
 };
 
 
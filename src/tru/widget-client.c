@@ -40,12 +40,23 @@
 #include "tinyradutil.h"
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <fcntl.h>
 #include <unistd.h>
 #include <errno.h>
 #include <assert.h>
 
 
+///////////////////
+//               //
+//  Definitions  //
+//               //
+///////////////////
+#pragma mark - Definitions
+
+#define TRU_CLIENT_PAIRS_MIN     64    // initial attribute/value pairs on a line, grown as needed
+
+
 //////////////////
 //              //
 //  Data Types  //
@@ -55,11 +66,10 @@
 
 typedef struct tru_client_state
 {
-   int                     fd;
-   int                     padint;
-   char **                 pairs;
+   TRUtilsFile *           fb;
    TinyRadAttrList *       attrlist;
-   char                    line[TRAD_LINE_MAX_LEN];
+   TinyRadSpan *           pairs;        // attribute/value pairs of current line
+   size_t                  pairs_size;
 } TRUClientState;
 
 
@@ -70,6 +80,13 @@ typedef struct tru_client_state
 //////////////////
 #pragma mark - Prototypes
 
+static int
+tru_widget_client_attr(
+         TinyRadUtilConf *             cnf,
+         const char *                  name,
+         TinyRadDictAttr **            attrp );
+
+
 static const TinyRadPktType *
 tru_widget_client_pkttype(
          const char *                  pname );
@@ -161,7 +178,6 @@ tru_widget_client(
    static struct option long_opt[]  = { TRU_ALL_LONG };
 
    memset(&state, 0, sizeof(state));
-   state.fd = -1;
 
    // process widget cli options
    if ((rc = tru_cli_parse(cnf, cnf->argc, cnf->argv, short_opt, long_opt, &tru_widget_client_usage)) != 0)
@@ -205,6 +221,65 @@ tru_widget_client(
 }
 
 
+/// Resolves attribute name, accepting unambiguous abbreviations
+///
+/// @param[in]  cnf           utility configuration
+/// @param[in]  name          attribute name or leading part of name
+/// @param[out] attrp         pointer to retained attribute reference
+/// @return returns error code
+int
+tru_widget_client_attr(
+         TinyRadUtilConf *             cnf,
+         const char *                  name,
+         TinyRadDictAttr **            attrp )
+{
+   int                  rc;
+   size_t               pos;
+   char **              names;
+   TinyRadDict *        dict;
+
+   assert(cnf   != NULL);
+   assert(name  != NULL);
+   assert(attrp != NULL);
+
+   tinyrad_get_option(cnf->tr, TRAD_OPT_DICTIONARY, &dict);
+
+   // exact names are preferred over abbreviations
+   if ((*attrp = tinyrad_dict_attr_get(dict, name, 0, NULL, 0, 0)) != NULL)
+   {
+      tinyrad_free(dict);
+      return(TRAD_SUCCESS);
+   };
+
+   if ((rc = tinyrad_dict_attr_prefix(dict, name, &names)) != TRAD_SUCCESS)
+   {
+      tinyrad_free(dict);
+      return(rc);
+   };
+   if (!(names))
+   {
+      tinyrad_free(dict);
+      return(tru_error(cnf, TRAD_EATTRIBUTE, "%s: unknown attribute", name));
+   };
+
+   if ((names[1]))
+   {
+      tru_error(cnf, TRAD_EATTRIBUTE, "%s: ambiguous attribute name", name);
+      for(pos = 0; ( ((names[pos])) && (!(cnf->opts & TRUTILS_OPT_QUIET)) ); pos++)
+         fprintf(stderr, "   %s\n", names[pos]);
+      tinyrad_strsfree(names);
+      tinyrad_free(dict);
+      return(TRAD_EATTRIBUTE);
+   };
+
+   *attrp = tinyrad_dict_attr_get(dict, names[0], 0, NULL, 0, 0);
+   tinyrad_strsfree(names);
+   tinyrad_free(dict);
+
+   return( ((*attrp)) ? TRAD_SUCCESS : TRAD_EATTRIBUTE );
+}
+
+
 const TinyRadPktType *
 tru_widget_client_pkttype(
          const char *                  pname )
@@ -292,37 +367,38 @@ tru_widget_client_process_file(
          TRUClientState *              state )
 {
    int                  rc;
-   size_t               len;
+   int                  stdinput;
    size_t               lineno;
-   int                  x;
+   size_t               count;
+   size_t               x;
+   size_t               size;
+   char *               line;
+   char *               pair;
+   void *               ptr;
 
    assert(pkttype != NULL);
    assert(state   != NULL);
 
    // open file
-   state->fd = STDIN_FILENO;
-   if ( ((cnf->attr_file)) && ((strcmp("-", cnf->attr_file))) )
-      if ((state->fd = open(cnf->attr_file, O_RDONLY)) == -1)
-         return(tru_error(cnf, TRAD_EUNKNOWN, "open(): %s: %s", cnf->attr_file, strerror(errno)));
-   if (state->fd == STDIN_FILENO)
+   if (!(cnf->attr_file))
+      cnf->attr_file = "-";
+   if ((state->fb = trutils_open(cnf->opts, cnf->attr_file, 0)) == NULL)
+      return(TRAD_EUNKNOWN);
+   stdinput = (!(strcmp("-", cnf->attr_file))) ? 1 : 0;
+   if ((stdinput))
       cnf->attr_file = "stdin";
 
    // loop through file
-   for(lineno = len = 1; (len > 0); lineno++)
+   for(lineno = 1; ((rc = trutils_readline(cnf->opts, state->fb, &line, NULL)) == 1); lineno++)
    {
-      // read next line
-      if ((rc = tinyrad_readline(state->fd, state->line, (sizeof(state->line)-1), &len)) != TRAD_SUCCESS)
-         return(tru_error(cnf, rc, "tinyrad_readline(): %s", tinyrad_strerror(rc)));
-      state->line[len] = '\0';
-
       // exit if single '.' on line
-      if ( (state->fd == STDIN_FILENO) && (!(strcmp(".", state->line))) )
+      if ( ((stdinput)) && (!(strcmp(".", line))) )
       {
          return(TRAD_SUCCESS);
       };
 
       // submit request if empty line
-      if (!(state->line[0]))
+      if (!(line[0]))
       {
          if (!(state->attrlist))
             continue;
@@ -332,16 +408,33 @@ printf("sending request\n");
       };
 
       // split line into attribute/value pairs
-      tinyrad_strtrim(state->line);
-printf("%zu: %s\n", lineno, state->line);
-      if ((rc = tinyrad_strsplit(state->line, ',', &state->pairs, NULL)) != TRAD_SUCCESS)
-         return(tru_error(cnf, rc, NULL));
+      tinyrad_strtrim(line);
+printf("%zu: %s\n", lineno, line);
+      while((rc = tinyrad_strsplitspans(line, strlen(line), ',', state->pairs, state->pairs_size, &count)) == TRAD_ENOBUFS)
+      {
+         size = ((state->pairs_size)) ? (state->pairs_size * 2) : TRU_CLIENT_PAIRS_MIN;
+         if ((ptr = realloc(state->pairs, (sizeof(TinyRadSpan) * size))) == NULL)
+            return(tru_error(cnf, TRAD_ENOMEM, NULL));
+         state->pairs      = ptr;
+         state->pairs_size = size;
+      };
+      if (rc != TRAD_SUCCESS)
+         return(tru_error(cnf, rc, "%s:%zu: %s", cnf->attr_file, lineno, tinyrad_strerror(rc)));
+
+      // terminate pairs within line, each is followed by a delimiter or end of line
+      for(x = 0; (x < count); x++)
+         line[(size_t)(state->pairs[x].str - line) + state->pairs[x].len] = '\0';
 
       // loop through pairs and add to attribute list
-      for(x = 0; ((state->pairs[x])); x++)
-         if ((rc = tru_widget_client_req_add(cnf, state, state->pairs[x])) != TRAD_SUCCESS)
-            return(tru_error(cnf, rc, "%s:%i: %s", cnf->attr_file, lineno, tinyrad_strerror(rc)));
+      for(x = 0; (x < count); x++)
+      {
+         pair = &line[state->pairs[x].str - line];
+         if ((rc = tru_widget_client_req_add(cnf, state, pair)) != TRAD_SUCCESS)
+            return(tru_error(cnf, rc, "%s:%zu: %s", cnf->attr_file, lineno, tinyrad_strerror(rc)));
+      };
    };
+   if (rc == -1)
+      return(TRAD_EUNKNOWN);
 
    return(TRAD_SUCCESS);
 }
@@ -353,9 +446,12 @@ tru_widget_client_req_add(
          TRUClientState *              state,
          char *                        pair )
 {
-   int            rc;
-   int            argc;
-   char **        argv;
+   int                  rc;
+   size_t               count;
+   char *               name;
+   char *               value;
+   TinyRadSpan          spans[2];
+   TinyRadDictAttr *    attr;
 
    assert(cnf   != NULL);
    assert(state != NULL);
@@ -372,22 +468,25 @@ printf("   pair: %s\n", pair);
          return(tru_error(cnf, rc, "%s", tinyrad_strerror(rc)));
 
    // split attribute and value
-   if ((rc = tinyrad_strsplit(pair, '=', &argv, &argc)) != TRAD_SUCCESS)
-      return(rc);
-   if (argc != 2)
-   {
-      tinyrad_strsfree(argv);
+   if ((rc = tinyrad_strsplitspans(pair, strlen(pair), '=', spans, 2, &count)) != TRAD_SUCCESS)
+      return((rc == TRAD_ENOBUFS) ? TRAD_ESYNTAX : rc);
+   if (count != 2)
       return(TRAD_ESYNTAX);
-   };
+   name  = &pair[spans[0].str - pair];
+   value = &pair[spans[1].str - pair];
+   name[spans[0].len] = '\0';
 
    // clean up strings
-   tinyrad_strtrim(argv[0]);
-   tinyrad_strtrim(argv[1]);
-   if ( (!(argv[0][0])) || (!(argv[1][0])) )
-   {
-      tinyrad_strsfree(argv);
+   tinyrad_strtrim(name);
+   tinyrad_strtrim(value);
+   if ( (!(name[0])) || (!(value[0])) )
       return(TRAD_ESYNTAX);
-   };
+
+   // resolve attribute name
+   rc = tru_widget_client_attr(cnf, name, &attr);
+   if (rc != TRAD_SUCCESS)
+      return(rc);
+   tinyrad_free(attr);
 
    return(TRAD_SUCCESS);
 }
@@ -400,9 +499,12 @@ tru_widget_client_state_cleanup(
    if (!(state))
       return;
    tru_widget_client_state_reset(state);
-   if ( (state->fd != -1) && (state->fd != STDIN_FILENO) )
-      close(state->fd);
-   state->fd = -1;
+   trutils_close(state->fb);
+   state->fb = NULL;
+   if ((state->pairs))
+      free(state->pairs);
+   state->pairs      = NULL;
+   state->pairs_size = 0;
    return;
 }
 
@@ -418,12 +520,6 @@ tru_widget_client_state_reset(
       tinyrad_free(state->attrlist);
    state->attrlist = NULL;
 
-   if ((state->pairs))
-      tinyrad_strsfree(state->pairs);
-   state->pairs = NULL;
-
-   state->line[0] = '\0';
-
    return;
 }
 
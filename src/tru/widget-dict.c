@@ -40,9 +40,29 @@
 #include "tinyradutil.h"
 
 #include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
 #include <assert.h>
 
 
+//////////////////
+//              //
+//  Prototypes  //
+//              //
+//////////////////
+#pragma mark - Prototypes
+
+static int
+tru_widget_dict_prefix(
+         TinyRadUtilConf *                 cnf,
+         TinyRadDict *                     dict );
+
+
+static void
+tru_widget_dict_stats(
+         TinyRadDict *                     dict );
+
+
 /////////////////
 //             //
 //  Functions  //
@@ -58,8 +78,15 @@ tru_widget_dict(
    TinyRadDict *     dict;
 
    // getopt options
-   static char          short_opt[] = TRU_COMMON_SHORT TRU_DICT_SHORT;
-   static struct option long_opt[]  = { TRU_DICT_LONG TRU_COMMON_LONG };
+   static char          short_opt[] = "c:p:s" TRU_COMMON_SHORT TRU_DICT_SHORT;
+   static struct option long_opt[]  =
+   {
+      { "compile",          required_argument, NULL, 'c' },
+      { "prefix",           required_argument, NULL, 'p' },
+      { "stats",            no_argument,       NULL, 's' },
+      TRU_DICT_LONG
+      TRU_COMMON_LONG
+   };
 
    // process widget cli options
    if ((rc = tru_cli_parse(cnf, cnf->argc, cnf->argv, short_opt, long_opt, &tru_usage)) != 0)
@@ -74,6 +101,29 @@ tru_widget_dict(
    if ((rc = tru_load_tinyrad(cnf)) != TRAD_SUCCESS)
       return(rc);
    tinyrad_get_option(cnf->tr, TRAD_OPT_DICTIONARY, &dict);
+
+   if ((cnf->compile_file))
+   {
+      if ((rc = tinyrad_dict_compile(dict, ((strcmp(cnf->compile_file, "-")) ? cnf->compile_file : NULL), NULL)) != TRAD_SUCCESS)
+         tru_error(cnf, rc, "%s: %s", cnf->compile_file, tinyrad_strerror(rc));
+      tinyrad_free(dict);
+      return(rc);
+   };
+
+   if ((cnf->attr_prefix))
+   {
+      rc = tru_widget_dict_prefix(cnf, dict);
+      tinyrad_free(dict);
+      return(rc);
+   };
+
+   if ((cnf->opts & TRU_OPT_STATS))
+   {
+      tru_widget_dict_stats(dict);
+      tinyrad_free(dict);
+      return(TRAD_SUCCESS);
+   };
+
    tinyrad_dict_print(dict, 0xffff);
    tinyrad_free(dict);
 
@@ -81,4 +131,60 @@ tru_widget_dict(
 }
 
 
+static int
+tru_widget_dict_prefix(
+         TinyRadUtilConf *                 cnf,
+         TinyRadDict *                     dict )
+{
+   int               rc;
+   size_t            pos;
+   char **           names;
+
+   if ((rc = tinyrad_dict_attr_prefix(dict, cnf->attr_prefix, &names)) != TRAD_SUCCESS)
+      return(tru_error(cnf, rc, "%s", tinyrad_strerror(rc)));
+   if (!(names))
+      return(tru_error(cnf, TRAD_EATTRIBUTE, "%s: no matching attributes", cnf->attr_prefix));
+
+   for(pos = 0; ((names[pos])); pos++)
+      printf("%s\n", names[pos]);
+   tinyrad_strsfree(names);
+
+   return(TRAD_SUCCESS);
+}
+
+
+static void
+tru_widget_dict_stats(
+         TinyRadDict *                     dict )
+{
+   TinyRadDictStats     stats;
+   uint64_t             hits;
+
+   tinyrad_dict_get_option(dict, TRAD_DICT_OPT_STATS, &stats);
+   hits = stats.lookups - stats.lookup_misses;
+
+   printf("Objects:\n");
+   printf("   vendors:                %zu\n", stats.vendors);
+   printf("   attributes:             %zu\n", stats.attrs);
+   printf("   values:                 %zu\n", stats.values);
+   printf("   source files:           %zu\n", stats.sources);
+   printf("Memory (bytes):\n");
+   printf("   objects:                %zu\n", stats.objs_bytes);
+   printf("   sorted lists:           %zu\n", stats.lists_bytes);
+   printf("   hash tables:            %zu\n", stats.hashes_bytes);
+   printf("   vendor indexes:         %zu\n", stats.vendors_bytes);
+   printf("   value indexes:          %zu\n", stats.values_bytes);
+   printf("   attribute name trie:    %zu\n", stats.names_bytes);
+   printf("   string arena:           %zu (%zu used)\n", stats.strpool_bytes, stats.strpool_used);
+   printf("   interned strings:       %zu\n", stats.strpool_strings);
+   printf("Lookups:\n");
+   printf("   total:                  %" PRIu64 "\n", stats.lookups);
+   printf("   hits:                   %" PRIu64 "\n", hits);
+   printf("   misses:                 %" PRIu64 "\n", stats.lookup_misses);
+   printf("   average probes:         %.2f\n", ((stats.lookups)) ? ((double)stats.lookup_probes / (double)stats.lookups) : 0.0);
+
+   return;
+}
+
+
 /* end of source */
@@ -0,0 +1,619 @@
+/*
+ *  Tiny RADIUS Client Library
+ *  Copyright (C) 2022 David M. Syzdek <david@syzdek.net>.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of David M. Syzdek nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL DAVID M. SYZDEK BE LIABLE FOR
+ *  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ *  OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ *  SUCH DAMAGE.
+ */
+#define _TESTS_BENCH_DICT_C 1
+
+
+///////////////
+//           //
+//  Headers  //
+//           //
+///////////////
+#pragma mark - Headers
+
+#include <tinyrad_utils.h>
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <assert.h>
+#include <time.h>
+#include <sys/resource.h>
+
+#include <tinyrad.h>
+
+
+///////////////////
+//               //
+//  Definitions  //
+//               //
+///////////////////
+#pragma mark - Definitions
+
+#undef PROGRAM_NAME
+#define PROGRAM_NAME "tinyrad-bench-dict"
+
+#define MY_VENDOR_ID       70000    // first synthetic vendor ID
+#define MY_VENDOR_ATTRS    200      // attributes defined by each vendor
+#define MY_ENUM_EVERY      4        // every Nth attribute is enumerated
+#define MY_ENUM_VALUES     8        // values defined by each enumerated attribute
+#define MY_MIN_OPS         1000000  // minimum lookups timed per measurement
+#define MY_NAME_LEN        48
+
+
+//////////////////
+//              //
+//  Data Types  //
+//              //
+//////////////////
+#pragma mark - Data Types
+
+typedef struct my_bench
+{
+   size_t                  attrs_len;
+   size_t                  vendors_len;
+   size_t                  values_len;
+   char *                  names;            // attribute, vendor, and value names
+   TinyRadDictVendorDef *  vendor_defs;
+   TinyRadDictAttrDef *    attr_defs;
+   TinyRadDictValueDef *   value_defs;
+   TinyRadDictAttr **      attrs;            // attributes of frozen dictionary
+} MyBench;
+
+
+//////////////////
+//              //
+//  Prototypes  //
+//              //
+//////////////////
+#pragma mark - Prototypes
+
+int
+main(
+         int                           argc,
+         char *                        argv[] );
+
+
+int
+my_bench_generate(
+         MyBench *                     bench,
+         size_t                        attrs_len );
+
+
+void
+my_bench_free(
+         MyBench *                     bench );
+
+
+int
+my_bench_lookups(
+         unsigned                      opts,
+         MyBench *                     bench,
+         TinyRadDict *                 dict );
+
+
+int
+my_bench_parse(
+         unsigned                      opts,
+         MyBench *                     bench,
+         const char *                  file,
+         TinyRadDict **                dictp );
+
+
+int
+my_bench_import(
+         unsigned                      opts,
+         MyBench *                     bench );
+
+
+int
+my_bench_write(
+         MyBench *                     bench,
+         const char *                  file );
+
+
+uint64_t
+my_now( void );
+
+
+void
+my_report(
+         MyBench *                     bench,
+         const char *                  op,
+         size_t                        ops,
+         uint64_t                      nsec );
+
+
+/////////////////
+//             //
+//  Functions  //
+//             //
+/////////////////
+#pragma mark - Functions
+
+int
+main(
+         int                           argc,
+         char *                        argv[] )
+{
+   int                           opt;
+   int                           c;
+   int                           opt_index;
+   int                           rc;
+   int                           pos;
+   unsigned                      opts;
+   size_t                        attrs_len;
+   char                          file[128];
+   char *                        end;
+   TinyRadDict *                 dict;
+   MyBench                       bench;
+
+   static const char *  scales[] = { "1000", "10000", "100000", NULL };
+
+   // getopt options
+   static char          short_opt[] = "dhVvq";
+   static struct option long_opt[] =
+   {
+      {"debug",            no_argument,       NULL, 'd' },
+      {"help",             no_argument,       NULL, 'h' },
+      {"quiet",            no_argument,       NULL, 'q' },
+      {"silent",           no_argument,       NULL, 'q' },
+      {"version",          no_argument,       NULL, 'V' },
+      {"verbose",          no_argument,       NULL, 'v' },
+      { NULL, 0, NULL, 0 }
+   };
+
+   trutils_initialize(PROGRAM_NAME);
+
+   opts     = 0;
+
+   while((c = getopt_long(argc, argv, short_opt, long_opt, &opt_index)) != -1)
+   {
+      switch(c)
+      {
+         case -1:       /* no more arguments */
+         case 0:        /* long options toggles */
+         break;
+
+         case 'd':
+         opt = TRAD_DEBUG_ANY;
+         tinyrad_set_option(NULL, TRAD_OPT_DEBUG_LEVEL,  &opt);
+         break;
+
+         case 'h':
+         printf("Usage: %s [OPTIONS] [attributes ...]\n", PROGRAM_NAME);
+         printf("OPTIONS:\n");
+         printf("  -d, --debug               print debug messages\n");
+         printf("  -h, --help                print this help and exit\n");
+         printf("  -q, --quiet, --silent     do not print messages\n");
+         printf("  -V, --version             print version number and exit\n");
+         printf("  -v, --verbose             print verbose messages\n");
+         printf("\n");
+         printf("Synthetic dictionaries are generated with 1000, 10000, and 100000\n");
+         printf("attributes unless other sizes are specified.\n");
+         printf("\n");
+         return(0);
+
+         case 'q':
+         opts |=  TRUTILS_OPT_QUIET;
+         opts &= ~TRUTILS_OPT_VERBOSE;
+         break;
+
+         case 'V':
+         trutils_version();
+         return(0);
+
+         case 'v':
+         opts |=  TRUTILS_OPT_VERBOSE;
+         opts &= ~TRUTILS_OPT_QUIET;
+         break;
+
+         case '?':
+         fprintf(stderr, "Try `%s --help' for more information.\n", PROGRAM_NAME);
+         return(1);
+
+         default:
+         fprintf(stderr, "%s: unrecognized option `--%c'\n", PROGRAM_NAME, c);
+         fprintf(stderr, "Try `%s --help' for more information.\n", PROGRAM_NAME);
+         return(1);
+      };
+   };
+
+   if (optind < argc)
+   {
+      argv = &argv[optind];
+      argc = argc - optind;
+   } else {
+      argv = (char **)((uintptr_t)scales);
+      argc = 3;
+   };
+
+   snprintf(file, sizeof(file), "/tmp/tinyrad-bench-dict.%i", (int)getpid());
+
+   printf("%9s %8s %8s  %-18s %10s %12s %12s\n", "attrs", "vendors", "values", "operation", "ops", "ns/op", "peak RSS KiB");
+
+   for(pos = 0, rc = 0; ( (pos < argc) && (rc == 0) ); pos++)
+   {
+      attrs_len = (size_t)strtoul(argv[pos], &end, 0);
+      if ( ((end[0])) || (!(attrs_len)) )
+         return(trutils_error(opts, NULL, "invalid number of attributes: %s", argv[pos]));
+
+      if ((rc = my_bench_generate(&bench, attrs_len)) != 0)
+         return(trutils_error(opts, NULL, "out of virtual memory"));
+
+      trutils_verbose(opts, "writing %s ...", file);
+      if ((rc = my_bench_write(&bench, file)) != 0)
+         trutils_error(opts, NULL, "unable to write %s", file);
+
+      if (rc == 0)
+         rc = my_bench_parse(opts, &bench, file, &dict);
+      if (rc == 0)
+      {
+         rc = my_bench_lookups(opts, &bench, dict);
+         tinyrad_free(dict);
+      };
+      if (rc == 0)
+         rc = my_bench_import(opts, &bench);
+
+      unlink(file);
+      my_bench_free(&bench);
+   };
+
+   return(rc);
+}
+
+
+int
+my_bench_generate(
+         MyBench *                     bench,
+         size_t                        attrs_len )
+{
+   size_t      pos;
+   size_t      val;
+   size_t      vendor;
+   char *      name;
+
+   memset(bench, 0, sizeof(MyBench));
+
+   bench->attrs_len   = attrs_len;
+   bench->vendors_len = (attrs_len + MY_VENDOR_ATTRS - 1) / MY_VENDOR_ATTRS;
+   bench->values_len  = ((attrs_len + MY_ENUM_EVERY - 1) / MY_ENUM_EVERY) * MY_ENUM_VALUES;
+
+   bench->names       = malloc((bench->attrs_len + bench->vendors_len + bench->values_len) * MY_NAME_LEN);
+   bench->vendor_defs = calloc(bench->vendors_len + 1, sizeof(TinyRadDictVendorDef));
+   bench->attr_defs   = calloc(bench->attrs_len   + 1, sizeof(TinyRadDictAttrDef));
+   bench->value_defs  = calloc(bench->values_len  + 1, sizeof(TinyRadDictValueDef));
+   bench->attrs       = calloc(bench->attrs_len   + 1, sizeof(TinyRadDictAttr *));
+   if ( (!(bench->names)) || (!(bench->vendor_defs)) || (!(bench->attr_defs)) || (!(bench->value_defs)) || (!(bench->attrs)) )
+   {
+      my_bench_free(bench);
+      return(1);
+   };
+   name = bench->names;
+
+   for(pos = 0; (pos < bench->vendors_len); pos++)
+   {
+      snprintf(name, MY_NAME_LEN, "Bench-Vendor-%u", (unsigned)pos);
+      bench->vendor_defs[pos].name             = name;
+      bench->vendor_defs[pos].vendor_id        = MY_VENDOR_ID + pos;
+      bench->vendor_defs[pos].vendor_type_octs = 1;
+      bench->vendor_defs[pos].vendor_len_octs  = 1;
+      name += MY_NAME_LEN;
+   };
+
+   for(pos = 0, val = 0; (pos < bench->attrs_len); pos++)
+   {
+      vendor = pos / MY_VENDOR_ATTRS;
+      snprintf(name, MY_NAME_LEN, "Bench-%u-Attr-%u", (unsigned)vendor, (unsigned)pos);
+      bench->attr_defs[pos].name        = name;
+      bench->attr_defs[pos].type        = TRAD_ATTR_VENDOR_SPECIFIC;
+      bench->attr_defs[pos].vendor_id   = (uint32_t)(MY_VENDOR_ID + vendor);
+      bench->attr_defs[pos].vendor_type = (uint32_t)((pos % MY_VENDOR_ATTRS) + 1);
+      bench->attr_defs[pos].data_type   = ((pos % MY_ENUM_EVERY)) ? TRAD_DATATYPE_STRING : TRAD_DATATYPE_INTEGER;
+      name += MY_NAME_LEN;
+      if ((pos % MY_ENUM_EVERY))
+         continue;
+      for(; (val < (((pos / MY_ENUM_EVERY) + 1) * MY_ENUM_VALUES)); val++)
+      {
+         snprintf(name, MY_NAME_LEN, "Value-%u", (unsigned)(val % MY_ENUM_VALUES));
+         bench->value_defs[val].attr_name  = bench->attr_defs[pos].name;
+         bench->value_defs[val].value_name = name;
+         bench->value_defs[val].data       = val % MY_ENUM_VALUES;
+         name += MY_NAME_LEN;
+      };
+   };
+
+   return(0);
+}
+
+
+void
+my_bench_free(
+         MyBench *                     bench )
+{
+   free(bench->names);
+   free(bench->vendor_defs);
+   free(bench->attr_defs);
+   free(bench->value_defs);
+   free(bench->attrs);
+   memset(bench, 0, sizeof(MyBench));
+   return;
+}
+
+
+int
+my_bench_import(
+         unsigned                      opts,
+         MyBench *                     bench )
+{
+   int               rc;
+   uint64_t          start;
+   uint64_t          nsec;
+   char **           errs;
+   TinyRadDict *     dict;
+
+   trutils_verbose(opts, "importing %zu attributes ...", bench->attrs_len);
+
+   start = my_now();
+   if ((rc = tinyrad_dict_initialize(&dict, TRAD_NOINIT)) != TRAD_SUCCESS)
+      return(trutils_error(opts, NULL, "tinyrad_dict_initialize(): %s", tinyrad_strerror(rc)));
+   if ((rc = tinyrad_dict_import(dict, bench->vendor_defs, bench->attr_defs, bench->value_defs, &errs)) != TRAD_SUCCESS)
+   {
+      trutils_error(opts, errs, "tinyrad_dict_import(): %s", tinyrad_strerror(rc));
+      tinyrad_strsfree(errs);
+      tinyrad_free(dict);
+      return(1);
+   };
+   nsec = my_now() - start;
+   tinyrad_free(dict);
+
+   my_report(bench, "import", (bench->vendors_len + bench->attrs_len + bench->values_len), nsec);
+
+   return(0);
+}
+
+
+int
+my_bench_lookups(
+         unsigned                      opts,
+         MyBench *                     bench,
+         TinyRadDict *                 dict )
+{
+   size_t               pos;
+   size_t               ops;
+   size_t               passes;
+   size_t               pass;
+   uint64_t             start;
+   TinyRadDictAttr *    attr;
+   TinyRadDictValue *   value;
+   TinyRadDictVendor *  vendor;
+   const char *         name;
+
+   // resolve attributes once, missing objects invalidate the benchmark
+   for(pos = 0; (pos < bench->attrs_len); pos++)
+      if ((bench->attrs[pos] = tinyrad_dict_attr_get(dict, bench->attr_defs[pos].name, 0, NULL, 0, 0)) == NULL)
+         return(trutils_error(opts, NULL, "attribute %s not found", bench->attr_defs[pos].name));
+
+   trutils_verbose(opts, "looking up vendors by name ...");
+   passes = (MY_MIN_OPS + bench->vendors_len - 1) / bench->vendors_len;
+   start  = my_now();
+   for(pass = 0, ops = 0; (pass < passes); pass++)
+   {
+      for(pos = 0; (pos < bench->vendors_len); pos++, ops++)
+      {
+         vendor = tinyrad_dict_vendor_get(dict, bench->vendor_defs[pos].name, 0);
+         tinyrad_free(vendor);
+      };
+   };
+   my_report(bench, "vendor by name", ops, my_now() - start);
+
+   trutils_verbose(opts, "looking up attributes by name ...");
+   passes = (MY_MIN_OPS + bench->attrs_len - 1) / bench->attrs_len;
+   start  = my_now();
+   for(pass = 0, ops = 0; (pass < passes); pass++)
+   {
+      for(pos = 0; (pos < bench->attrs_len); pos++, ops++)
+      {
+         attr = tinyrad_dict_attr_get(dict, bench->attr_defs[pos].name, 0, NULL, 0, 0);
+         tinyrad_free(attr);
+      };
+   };
+   my_report(bench, "attr by name", ops, my_now() - start);
+
+   trutils_verbose(opts, "looking up attributes by OID ...");
+   passes = (MY_MIN_OPS + bench->attrs_len - 1) / bench->attrs_len;
+   start  = my_now();
+   for(pass = 0, ops = 0; (pass < passes); pass++)
+   {
+      for(pos = 0; (pos < bench->attrs_len); pos++, ops++)
+      {
+         attr = tinyrad_dict_attr_get(dict, NULL, TRAD_ATTR_VENDOR_SPECIFIC, NULL, bench->attr_defs[pos].vendor_id, bench->attr_defs[pos].vendor_type);
+         tinyrad_free(attr);
+      };
+   };
+   my_report(bench, "attr by OID", ops, my_now() - start);
+
+   trutils_verbose(opts, "looking up values by name ...");
+   passes = (MY_MIN_OPS + bench->values_len - 1) / bench->values_len;
+   start  = my_now();
+   for(pass = 0, ops = 0; (pass < passes); pass++)
+   {
+      for(pos = 0; (pos < bench->values_len); pos++, ops++)
+      {
+         name  = bench->value_defs[pos].value_name;
+         attr  = bench->attrs[(pos / MY_ENUM_VALUES) * MY_ENUM_EVERY];
+         value = tinyrad_dict_value_get(dict, name, attr, 0, 0, 0, 0);
+         tinyrad_free(value);
+      };
+   };
+   my_report(bench, "value by name", ops, my_now() - start);
+
+   trutils_verbose(opts, "looking up values by data ...");
+   passes = (MY_MIN_OPS + bench->values_len - 1) / bench->values_len;
+   start  = my_now();
+   for(pass = 0, ops = 0; (pass < passes); pass++)
+   {
+      for(pos = 0; (pos < bench->values_len); pos++, ops++)
+      {
+         attr  = bench->attrs[(pos / MY_ENUM_VALUES) * MY_ENUM_EVERY];
+         value = tinyrad_dict_value_get(dict, NULL, attr, 0, 0, 0, bench->value_defs[pos].data);
+         tinyrad_free(value);
+      };
+   };
+   my_report(bench, "value by data", ops, my_now() - start);
+
+   for(pos = 0; (pos < bench->attrs_len); pos++)
+      tinyrad_free(bench->attrs[pos]);
+
+   return(0);
+}
+
+
+int
+my_bench_parse(
+         unsigned                      opts,
+         MyBench *                     bench,
+         const char *                  file,
+         TinyRadDict **                dictp )
+{
+   int               rc;
+   int               readonly;
+   uint64_t          start;
+   char **           errs;
+   TinyRadDict *     dict;
+
+   trutils_verbose(opts, "parsing %s ...", file);
+
+   start = my_now();
+   if ((rc = tinyrad_dict_initialize(&dict, TRAD_NOINIT)) != TRAD_SUCCESS)
+      return(trutils_error(opts, NULL, "tinyrad_dict_initialize(): %s", tinyrad_strerror(rc)));
+   if ((rc = tinyrad_dict_parse(dict, file, &errs, 0)) != TRAD_SUCCESS)
+   {
+      trutils_error(opts, errs, "tinyrad_dict_parse(): %s", tinyrad_strerror(rc));
+      tinyrad_strsfree(errs);
+      tinyrad_free(dict);
+      return(1);
+   };
+   my_report(bench, "parse", (bench->vendors_len + bench->attrs_len + bench->values_len), (my_now() - start));
+
+   start    = my_now();
+   readonly = TRAD_YES;
+   if ((rc = tinyrad_dict_set_option(dict, TRAD_DICT_OPT_READONLY, &readonly)) != TRAD_SUCCESS)
+   {
+      tinyrad_free(dict);
+      return(trutils_error(opts, NULL, "tinyrad_dict_set_option(TRAD_DICT_OPT_READONLY): %s", tinyrad_strerror(rc)));
+   };
+   my_report(bench, "freeze", (bench->vendors_len + bench->attrs_len + bench->values_len), (my_now() - start));
+
+   *dictp = dict;
+
+   return(0);
+}
+
+
+int
+my_bench_write(
+         MyBench *                     bench,
+         const char *                  file )
+{
+   size_t               pos;
+   size_t               val;
+   size_t               vendor;
+   FILE *               fs;
+   TinyRadDictAttrDef * def;
+
+   if ((fs = fopen(file, "w")) == NULL)
+      return(1);
+
+   fprintf(fs, "# synthetic dictionary generated by %s\n", PROGRAM_NAME);
+   for(pos = 0; (pos < bench->vendors_len); pos++)
+      fprintf(fs, "VENDOR %s %u\n", bench->vendor_defs[pos].name, (unsigned)bench->vendor_defs[pos].vendor_id);
+
+   for(pos = 0, val = 0; (pos < bench->attrs_len); pos++)
+   {
+      def    = &bench->attr_defs[pos];
+      vendor = pos / MY_VENDOR_ATTRS;
+      if (!(pos % MY_VENDOR_ATTRS))
+         fprintf(fs, "\nBEGIN-VENDOR %s\n", bench->vendor_defs[vendor].name);
+      fprintf(fs, "ATTRIBUTE %s %u %s\n", def->name, (unsigned)def->vendor_type, ((def->data_type == TRAD_DATATYPE_INTEGER) ? "integer" : "octets"));
+      for(; ( (val < bench->values_len) && (bench->value_defs[val].attr_name == def->name) ); val++)
+         fprintf(fs, "VALUE %s %s %u\n", def->name, bench->value_defs[val].value_name, (unsigned)bench->value_defs[val].data);
+      if ( (!((pos + 1) % MY_VENDOR_ATTRS)) || ((pos + 1) == bench->attrs_len) )
+         fprintf(fs, "END-VENDOR %s\n", bench->vendor_defs[vendor].name);
+   };
+
+   fclose(fs);
+
+   return(0);
+}
+
+
+uint64_t
+my_now( void )
+{
+   struct timespec      ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return( ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec );
+}
+
+
+void
+my_report(
+         MyBench *                     bench,
+         const char *                  op,
+         size_t                        ops,
+         uint64_t                      nsec )
+{
+   struct rusage        ru;
+
+   // ru_maxrss is the high-water mark of the process, not of this operation
+   getrusage(RUSAGE_SELF, &ru);
+
+   printf(
+      "%9zu %8zu %8zu  %-18s %10zu %12.1f %12ld\n",
+      bench->attrs_len,
+      bench->vendors_len,
+      bench->values_len,
+      op,
+      ops,
+      ((ops)) ? ((double)nsec / (double)ops) : 0.0,
+      (long)ru.ru_maxrss
+   );
+   fflush(stdout);
+
+   return;
+}
+
+
+/* end of source */
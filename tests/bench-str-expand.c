@@ -0,0 +1,315 @@
+/*
+ *  Tiny RADIUS Client Library
+ *  Copyright (C) 2022 David M. Syzdek <david@syzdek.net>.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of David M. Syzdek nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL DAVID M. SYZDEK BE LIABLE FOR
+ *  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ *  OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ *  SUCH DAMAGE.
+ */
+#define _TESTS_BENCH_STR_EXPAND_C 1
+
+
+///////////////
+//           //
+//  Headers  //
+//           //
+///////////////
+#pragma mark - Headers
+
+#include <tinyrad_utils.h>
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <assert.h>
+#include <time.h>
+
+#include <tinyrad.h>
+
+
+///////////////////
+//               //
+//  Definitions  //
+//               //
+///////////////////
+#pragma mark - Definitions
+
+#undef PROGRAM_NAME
+#define PROGRAM_NAME "tinyrad-bench-str-expand"
+
+#define MY_MIN_OPS         1000        // initial expansions timed per measurement
+#define MY_MIN_NSEC        100000000   // minimum duration of each measurement
+
+
+/////////////////
+//             //
+//  Datatypes  //
+//             //
+/////////////////
+#pragma mark - Datatypes
+
+typedef struct my_bench_strings
+{
+   const char *   origin;
+   intptr_t       force;
+} MyBenchStr;
+
+
+/////////////////
+//             //
+//  Variables  //
+//             //
+/////////////////
+#pragma mark - Variables
+
+// strings of tests/test-str-expand.c
+static const MyBenchStr  bench_strings[] =
+{
+   { "asdfghj",                              TRAD_NO },
+   { "'asdfghj'",                            TRAD_NO },
+   { "\"asdfghj\"",                          TRAD_NO },
+   { "\\141\\163\\144\\146\\147\\150\\152",  TRAD_YES },
+   { "\\x61\\x73\\x64\\x66\\x67\\x68\\x6a",  TRAD_YES },
+   { "a\\163\\x64f\\147\\x68j",              TRAD_YES },
+   { "a%%sdfghj",                            TRAD_YES },
+   { "\"a\\tsdf%%ghj\"",                     TRAD_NO },
+   { "'a\\tsdf%%ghj'",                       TRAD_NO },
+   { "zaq%%-%p-%%qaz",                       TRAD_YES },
+   { "%u:x:%U:%G:test user:%d:/bin/false",   TRAD_YES },
+   { "%g:x:%G:%u,root",                      TRAD_YES },
+   { "Is %p running successfully?",          TRAD_YES },
+   { "Is your email address %u@%D\?",        TRAD_YES },
+   { "is your email address %u@%H\?",        TRAD_YES },
+   { "Is your email address %u@%h.%D\?",     TRAD_YES },
+   { NULL, 0 }
+};
+
+
+//////////////////
+//              //
+//  Prototypes  //
+//              //
+//////////////////
+#pragma mark - Prototypes
+
+int
+main(
+         int                           argc,
+         char *                        argv[] );
+
+
+int
+my_bench_string(
+         unsigned                      opts,
+         const char *                  origin,
+         int                           force );
+
+
+uint64_t
+my_now( void );
+
+
+/////////////////
+//             //
+//  Functions  //
+//             //
+/////////////////
+#pragma mark - Functions
+
+int
+main(
+         int                           argc,
+         char *                        argv[] )
+{
+   int                           opt;
+   int                           c;
+   int                           opt_index;
+   size_t                        pos;
+   unsigned                      opts;
+
+   // getopt options
+   static char          short_opt[] = "dhVvq";
+   static struct option long_opt[] =
+   {
+      {"debug",            no_argument,       NULL, 'd' },
+      {"help",             no_argument,       NULL, 'h' },
+      {"quiet",            no_argument,       NULL, 'q' },
+      {"silent",           no_argument,       NULL, 'q' },
+      {"version",          no_argument,       NULL, 'V' },
+      {"verbose",          no_argument,       NULL, 'v' },
+      { NULL, 0, NULL, 0 }
+   };
+
+   trutils_initialize(PROGRAM_NAME);
+
+   opts     = 0;
+
+   while((c = getopt_long(argc, argv, short_opt, long_opt, &opt_index)) != -1)
+   {
+      switch(c)
+      {
+         case -1:       /* no more arguments */
+         case 0:        /* long options toggles */
+         break;
+
+         case 'd':
+         opt = TRAD_DEBUG_ANY;
+         tinyrad_set_option(NULL, TRAD_OPT_DEBUG_LEVEL,  &opt);
+         break;
+
+         case 'h':
+         printf("Usage: %s [OPTIONS] [str1 [ str2 [ ... [ strN ] ] ]\n", PROGRAM_NAME);
+         printf("OPTIONS:\n");
+         printf("  -d, --debug               print debug messages\n");
+         printf("  -h, --help                print this help and exit\n");
+         printf("  -q, --quiet, --silent     do not print messages\n");
+         printf("  -V, --version             print version number and exit\n");
+         printf("  -v, --verbose             print verbose messages\n");
+         printf("\n");
+         printf("Strings of test-str-expand are used unless other strings are\n");
+         printf("specified.  Specified strings are expanded with forced expansion.\n");
+         printf("\n");
+         return(0);
+
+         case 'q':
+         opts |=  TRUTILS_OPT_QUIET;
+         opts &= ~TRUTILS_OPT_VERBOSE;
+         break;
+
+         case 'V':
+         trutils_version();
+         return(0);
+
+         case 'v':
+         opts |=  TRUTILS_OPT_VERBOSE;
+         opts &= ~TRUTILS_OPT_QUIET;
+         break;
+
+         case '?':
+         fprintf(stderr, "Try `%s --help' for more information.\n", PROGRAM_NAME);
+         return(1);
+
+         default:
+         fprintf(stderr, "%s: unrecognized option `--%c'\n", PROGRAM_NAME, c);
+         fprintf(stderr, "Try `%s --help' for more information.\n", PROGRAM_NAME);
+         return(1);
+      };
+   };
+
+   printf("%-40s %10s %12s %12s %8s\n", "string", "ops", "expand ns", "compiled ns", "speedup");
+
+   if (optind < argc)
+   {
+      for(; (optind < argc); optind++)
+         if ((my_bench_string(opts, argv[optind], TRAD_YES)))
+            return(1);
+      return(0);
+   };
+
+   for(pos = 0; ((bench_strings[pos].origin)); pos++)
+      if ((my_bench_string(opts, bench_strings[pos].origin, (int)bench_strings[pos].force)))
+         return(1);
+
+   return(0);
+}
+
+
+int
+my_bench_string(
+         unsigned                      opts,
+         const char *                  origin,
+         int                           force )
+{
+   int                  rc;
+   size_t               ops;
+   size_t               pos;
+   uint64_t             start;
+   uint64_t             expand_nsec;
+   uint64_t             tmpl_nsec;
+   double               expand_op;
+   double               tmpl_op;
+   char                 buff[TRAD_LINE_MAX_LEN];
+   char                 tbuff[TRAD_LINE_MAX_LEN];
+   TinyRadStrTmpl *     tmpl;
+
+   if ((rc = tinyrad_strexpand_compile(origin, force, &tmpl)) != TRAD_SUCCESS)
+      return(trutils_error(opts, NULL, "tinyrad_strexpand_compile(): %s: %s", origin, tinyrad_strerror(rc)));
+
+   // verify both methods produce the same string
+   if ( (!(tinyrad_strexpand(buff, origin, sizeof(buff), force))) || (!(tinyrad_strexpand_tmpl(tbuff, tmpl, sizeof(tbuff)))) )
+   {
+      tinyrad_free(tmpl);
+      return(trutils_error(opts, NULL, "%s: unable to expand string", origin));
+   };
+   if ((strcmp(buff, tbuff)))
+   {
+      tinyrad_free(tmpl);
+      return(trutils_error(opts, NULL, "%s: compiled expansion \"%s\" does not match \"%s\"", origin, tbuff, buff));
+   };
+   trutils_verbose(opts, "%s ==> %s", origin, buff);
+
+   // time expansion of source string
+   for(ops = MY_MIN_OPS, expand_nsec = 0; (expand_nsec < MY_MIN_NSEC); ops *= 2)
+   {
+      start = my_now();
+      for(pos = 0; (pos < ops); pos++)
+         tinyrad_strexpand(buff, origin, sizeof(buff), force);
+      expand_nsec = my_now() - start;
+   };
+   expand_op = (double)expand_nsec / (double)(ops / 2);
+
+   // time expansion of compiled template
+   for(ops = MY_MIN_OPS, tmpl_nsec = 0; (tmpl_nsec < MY_MIN_NSEC); ops *= 2)
+   {
+      start = my_now();
+      for(pos = 0; (pos < ops); pos++)
+         tinyrad_strexpand_tmpl(tbuff, tmpl, sizeof(tbuff));
+      tmpl_nsec = my_now() - start;
+   };
+   tmpl_op = (double)tmpl_nsec / (double)(ops / 2);
+
+   tinyrad_free(tmpl);
+
+   printf("%-40s %10zu %12.1f %12.1f %7.1fx\n", origin, (ops / 2), expand_op, tmpl_op, (expand_op / tmpl_op));
+   fflush(stdout);
+
+   return(0);
+}
+
+
+uint64_t
+my_now( void )
+{
+   struct timespec      ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return( ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec );
+}
+
+
+/* end of source */
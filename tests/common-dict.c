@@ -41,7 +41,9 @@
 
 #include <stddef.h>
 #include <stdio.h>
+#include <unistd.h>
 #include <assert.h>
+#include <sys/stat.h>
 
 
 ///////////////////
@@ -301,10 +303,124 @@ our_dict_diag_vendor(
 }
 
 
+/// Compares contents of two files
+///
+/// @param[in]  file1         path of first file
+/// @param[in]  file2         path of second file
+/// @return returns 0 if the files are identical
+int
+our_dict_file_cmp(
+         const char *                  file1,
+         const char *                  file2 )
+{
+   int      c1;
+   int      c2;
+   FILE *   fs1;
+   FILE *   fs2;
+
+   if ((fs1 = fopen(file1, "r")) == NULL)
+      return(1);
+   if ((fs2 = fopen(file2, "r")) == NULL)
+   {
+      fclose(fs1);
+      return(1);
+   };
+
+   do
+   {
+      c1 = fgetc(fs1);
+      c2 = fgetc(fs2);
+   } while ( (c1 == c2) && (c1 != EOF) );
+
+   fclose(fs1);
+   fclose(fs2);
+
+   return( (c1 == c2) ? 0 : 1);
+}
+
+
+/// Writes dictionary files into a new temporary directory
+///
+/// The directory is /tmp/tinyrad-dict-<name>.<pid> and is removed again if
+/// any file cannot be written.
+///
+/// @param[in]  opts          test options
+/// @param[in]  name          name of test
+/// @param[in]  files         file names and contents
+/// @param[in]  len           number of files
+/// @param[out] dir           buffer to store path of directory
+/// @param[in]  size          size of buffer
+/// @return returns 0 on success
+int
+our_dict_files_create(
+         unsigned                      opts,
+         const char *                  name,
+         const char *                  files[][2],
+         size_t                        len,
+         char *                        dir,
+         size_t                        size )
+{
+   size_t         pos;
+   FILE *         fs;
+   char           path[256];
+
+   assert(name  != NULL);
+   assert(files != NULL);
+   assert(dir   != NULL);
+
+   snprintf(dir, size, "/tmp/tinyrad-dict-%s.%i", name, (int)getpid());
+   if ((mkdir(dir, 0700)))
+      return(trutils_error(opts, NULL, "unable to create %s", dir));
+
+   for(pos = 0; (pos < len); pos++)
+   {
+      snprintf(path, sizeof(path), "%s/%s", dir, files[pos][0]);
+      if ((fs = fopen(path, "w")) == NULL)
+      {
+         our_dict_files_remove(dir, files, pos);
+         return(trutils_error(opts, NULL, "unable to write %s", path));
+      };
+      fputs(files[pos][1], fs);
+      fclose(fs);
+   };
+
+   return(0);
+}
+
+
+/// Removes dictionary files and their temporary directory
+///
+/// @param[in]  dir           path of directory
+/// @param[in]  files         file names and contents
+/// @param[in]  len           number of files
+void
+our_dict_files_remove(
+         const char *                  dir,
+         const char *                  files[][2],
+         size_t                        len )
+{
+   size_t         pos;
+   char           path[256];
+
+   assert(dir   != NULL);
+   assert(files != NULL);
+
+   for(pos = 0; (pos < len); pos++)
+   {
+      snprintf(path, sizeof(path), "%s/%s", dir, files[pos][0]);
+      unlink(path);
+   };
+   rmdir(dir);
+
+   return;
+}
+
+
 int
 our_dict_initialize(
          unsigned                      opts,
          unsigned                      tr_opts,
+         int                           readonly,
          TinyRadDict **                dictp )
 {
    int            rc;
@@ -352,6 +468,77 @@ our_dict_initialize(
       return(1);
    };
 
+   // freeze test dictionary
+   if (readonly != TRAD_YES)
+      return(0);
+   trutils_verbose(opts, "freezing test dictionary ...");
+   if ((rc = tinyrad_dict_set_option(*dictp, TRAD_DICT_OPT_READONLY, &readonly)) != TRAD_SUCCESS)
+   {
+      trutils_error(opts, NULL, "tinyrad_dict_set_option(TRAD_DICT_OPT_READONLY): %s", tinyrad_strerror(rc));
+      tinyrad_free(*dictp);
+      return(1);
+   };
+
+   return(0);
+}
+
+
+/// Parses dictionary file from directory
+///
+/// Errors of the parse are returned in errsp if it is not NULL, otherwise
+/// they are printed.
+///
+/// @param[in]  opts          test options
+/// @param[in]  dir           directory searched for dictionary files
+/// @param[in]  file          dictionary file to parse
+/// @param[in]  parse_opts    options passed to tinyrad_dict_parse()
+/// @param[in]  outfile       file to write compiled dictionary, or NULL
+/// @param[out] errsp         reference to store parse errors, or NULL
+/// @param[out] dictp         reference to store dictionary, or NULL
+/// @return returns 0 on success
+int
+our_dict_parse(
+         unsigned                      opts,
+         const char *                  dir,
+         const char *                  file,
+         uint32_t                      parse_opts,
+         const char *                  outfile,
+         char ***                      errsp,
+         TinyRadDict **                dictp )
+{
+   int               rc;
+   char *            paths[2];
+   char **           errs;
+   TinyRadDict *     dict;
+
+   paths[0] = (char *)((uintptr_t)dir);
+   paths[1] = NULL;
+   errs     = NULL;
+
+   if ((rc = tinyrad_dict_initialize(&dict, TRAD_NOINIT)) != TRAD_SUCCESS)
+      return(trutils_error(opts, NULL, "tinyrad_dict_initialize(): %s", tinyrad_strerror(rc)));
+   if ((rc = tinyrad_dict_set_option(dict, TRAD_DICT_OPT_PATHS, paths)) != TRAD_SUCCESS)
+   {
+      tinyrad_free(dict);
+      return(trutils_error(opts, NULL, "tinyrad_dict_set_option(TRAD_DICT_OPT_PATHS): %s", tinyrad_strerror(rc)));
+   };
+   if ((rc = tinyrad_dict_parse(dict, file, (((errsp)) ? errsp : &errs), parse_opts)) != TRAD_SUCCESS)
+   {
+      if (!(errsp))
+         trutils_error(opts, errs, "tinyrad_dict_parse(): %s", tinyrad_strerror(rc));
+      tinyrad_strsfree(errs);
+      tinyrad_free(dict);
+      return(1);
+   };
+   if ((outfile))
+      rc = tinyrad_dict_compile(dict, outfile, NULL);
+   if ((dictp))
+      *dictp = dict;
+   else
+      tinyrad_free(dict);
+   if (rc != TRAD_SUCCESS)
+      return(trutils_error(opts, NULL, "tinyrad_dict_compile(): %s", tinyrad_strerror(rc)));
+
    return(0);
 }
 
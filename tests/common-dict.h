@@ -89,10 +89,45 @@ our_dict_diag_vendor(
          TinyRadDictVendor *           vendor );
 
 
+int
+our_dict_file_cmp(
+         const char *                  file1,
+         const char *                  file2 );
+
+
+int
+our_dict_files_create(
+         unsigned                      opts,
+         const char *                  name,
+         const char *                  files[][2],
+         size_t                        len,
+         char *                        dir,
+         size_t                        size );
+
+
+void
+our_dict_files_remove(
+         const char *                  dir,
+         const char *                  files[][2],
+         size_t                        len );
+
+
 int
 our_dict_initialize(
          unsigned                      opts,
          unsigned                      tr_opts,
+         int                           readonly,
+         TinyRadDict **                dictp );
+
+
+int
+our_dict_parse(
+         unsigned                      opts,
+         const char *                  dir,
+         const char *                  file,
+         uint32_t                      parse_opts,
+         const char *                  outfile,
+         char ***                      errsp,
          TinyRadDict **                dictp );
 
 
@@ -0,0 +1,345 @@
+/*
+ *  Tiny RADIUS Client Library
+ *  Copyright (C) 2021 David M. Syzdek <david@syzdek.net>.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of David M. Syzdek nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL DAVID M. SYZDEK BE LIABLE FOR
+ *  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ *  OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ *  SUCH DAMAGE.
+ */
+#define _TESTS_TINYRAD_ARRAY_MPQUEUE_C 1
+
+
+///////////////
+//           //
+//  Headers  //
+//           //
+///////////////
+#pragma mark - Headers
+
+#include <tinyrad_utils.h>
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <assert.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+
+#include <tinyrad.h>
+
+
+///////////////////
+//               //
+//  Definitions  //
+//               //
+///////////////////
+#pragma mark - Definitions
+
+#undef PROGRAM_NAME
+#define PROGRAM_NAME "tinyrad-array-mpqueue"
+
+#define MY_QUEUE_SIZE   64       // capacity of queue, small so producers find it full
+#define MY_PRODUCERS    4
+#define MY_CONSUMERS    4
+#define MY_OBJS         100000   // objects enqueued by each producer
+
+
+//////////////////
+//              //
+//  Data Types  //
+//              //
+//////////////////
+#pragma mark - Data Types
+
+typedef struct _mythread MyThread;
+
+struct _mythread
+{
+   TinyRadMPQueue *        queue;
+   atomic_size_t *         consumed;
+   uint64_t                id;
+   uint64_t                sums[MY_PRODUCERS];
+   int                     err;
+};
+
+
+//////////////////
+//              //
+//  Prototypes  //
+//              //
+//////////////////
+#pragma mark - Prototypes
+
+int
+main(
+         int                           argc,
+         char *                        argv[] );
+
+
+void *
+my_consumer(
+         void *                        arg );
+
+
+void *
+my_producer(
+         void *                        arg );
+
+
+/////////////////
+//             //
+//  Functions  //
+//             //
+/////////////////
+#pragma mark - Functions
+
+int main( int argc, char * argv[] )
+{
+   int                  opt;
+   int                  c;
+   int                  opt_index;
+   unsigned             opts;
+   size_t               x;
+   size_t               y;
+   uint64_t             obj;
+   uint64_t             sum;
+   atomic_size_t        consumed;
+   pthread_t            producers[MY_PRODUCERS];
+   pthread_t            consumers[MY_CONSUMERS];
+   MyThread             producer_data[MY_PRODUCERS];
+   MyThread             consumer_data[MY_CONSUMERS];
+   TinyRadMPQueue       queue;
+
+   // getopt options
+   static char          short_opt[] = "dhVvq";
+   static struct option long_opt[] =
+   {
+      {"debug",            no_argument,       NULL, 'd' },
+      {"help",             no_argument,       NULL, 'h' },
+      {"quiet",            no_argument,       NULL, 'q' },
+      {"silent",           no_argument,       NULL, 'q' },
+      {"version",          no_argument,       NULL, 'V' },
+      {"verbose",          no_argument,       NULL, 'v' },
+      { NULL, 0, NULL, 0 }
+   };
+
+   trutils_initialize(PROGRAM_NAME);
+
+   opts = 0;
+
+   while((c = getopt_long(argc, argv, short_opt, long_opt, &opt_index)) != -1)
+   {
+      switch(c)
+      {
+         case -1:       /* no more arguments */
+         case 0:        /* long options toggles */
+         break;
+
+         case 'd':
+         opt = TRAD_DEBUG_ANY;
+         tinyrad_set_option(NULL, TRAD_OPT_DEBUG_LEVEL,  &opt);
+         break;
+
+         case 'h':
+         printf("Usage: %s [OPTIONS]\n", PROGRAM_NAME);
+         printf("OPTIONS:\n");
+         printf("  -d, --debug               print debug messages\n");
+         printf("  -h, --help                print this help and exit\n");
+         printf("  -q, --quiet, --silent     do not print messages\n");
+         printf("  -V, --version             print version number and exit\n");
+         printf("  -v, --verbose             print verbose messages\n");
+         printf("\n");
+         return(0);
+
+         case 'q':
+         opts |=  TRUTILS_OPT_QUIET;
+         opts &= ~TRUTILS_OPT_VERBOSE;
+         break;
+
+         case 'V':
+         trutils_version();
+         return(0);
+
+         case 'v':
+         opts |=  TRUTILS_OPT_VERBOSE;
+         opts &= ~TRUTILS_OPT_QUIET;
+         break;
+
+         case '?':
+         fprintf(stderr, "Try `%s --help' for more information.\n", PROGRAM_NAME);
+         return(1);
+
+         default:
+         fprintf(stderr, "%s: unrecognized option `--%c'\n", PROGRAM_NAME, c);
+         fprintf(stderr, "Try `%s --help' for more information.\n", PROGRAM_NAME);
+         return(1);
+      };
+   };
+
+   if (optind != argc)
+   {
+         fprintf(stderr, "%s: unknown argument `--%s'\n", PROGRAM_NAME, argv[optind]);
+         fprintf(stderr, "Try `%s --help' for more information.\n", PROGRAM_NAME);
+         return(1);
+   };
+
+
+   // fill and drain queue from a single thread
+   trutils_verbose(opts, "queueing from a single thread ...");
+   if (tinyrad_mpqueue_initialize(&queue, sizeof(uint64_t), (MY_QUEUE_SIZE - 1)) != 0)
+      return(trutils_error(opts, NULL, "out of virtual memory"));
+   if (tinyrad_mpqueue_dequeue(&queue, &obj) != -1)
+      return(trutils_error(opts, NULL, "empty queue returned object"));
+   for(x = 0; (x < MY_QUEUE_SIZE); x++)
+      if (tinyrad_mpqueue_enqueue(&queue, &(uint64_t){ x }) != 0)
+         return(trutils_error(opts, NULL, "failed to enqueue object"));
+   if (tinyrad_mpqueue_enqueue(&queue, &(uint64_t){ x }) != -1)
+      return(trutils_error(opts, NULL, "full queue accepted object"));
+   for(x = 0; (x < (MY_QUEUE_SIZE * 4)); x++)
+   {
+      if (tinyrad_mpqueue_dequeue(&queue, &obj) != 0)
+         return(trutils_error(opts, NULL, "unable to dequeue object"));
+      if (obj != x)
+         return(trutils_error(opts, NULL, "dequeued object out of order"));
+      if (tinyrad_mpqueue_enqueue(&queue, &(uint64_t){ x + MY_QUEUE_SIZE }) != 0)
+         return(trutils_error(opts, NULL, "failed to enqueue object after wrapping"));
+   };
+   tinyrad_mpqueue_clear(&queue, NULL);
+
+
+   // pass objects between threads
+   trutils_verbose(opts, "queueing between %i producers and %i consumers ...", MY_PRODUCERS, MY_CONSUMERS);
+   if (tinyrad_mpqueue_initialize(&queue, sizeof(uint64_t), MY_QUEUE_SIZE) != 0)
+      return(trutils_error(opts, NULL, "out of virtual memory"));
+   atomic_init(&consumed, 0);
+   memset(producer_data, 0, sizeof(producer_data));
+   memset(consumer_data, 0, sizeof(consumer_data));
+   for(x = 0; (x < MY_CONSUMERS); x++)
+   {
+      consumer_data[x].queue    = &queue;
+      consumer_data[x].consumed = &consumed;
+      consumer_data[x].id       = x;
+      if ((pthread_create(&consumers[x], NULL, &my_consumer, &consumer_data[x])))
+         return(trutils_error(opts, NULL, "unable to create consumer thread"));
+   };
+   for(x = 0; (x < MY_PRODUCERS); x++)
+   {
+      producer_data[x].queue    = &queue;
+      producer_data[x].id       = x;
+      if ((pthread_create(&producers[x], NULL, &my_producer, &producer_data[x])))
+         return(trutils_error(opts, NULL, "unable to create producer thread"));
+   };
+   for(x = 0; (x < MY_PRODUCERS); x++)
+      pthread_join(producers[x], NULL);
+   for(x = 0; (x < MY_CONSUMERS); x++)
+      pthread_join(consumers[x], NULL);
+
+
+   // verify every object was dequeued once and in order per producer
+   trutils_verbose(opts, "verifying dequeued objects ...");
+   for(x = 0; (x < MY_CONSUMERS); x++)
+      if ((consumer_data[x].err))
+         return(trutils_error(opts, NULL, "consumer %zu dequeued objects out of order", x));
+   for(y = 0; (y < MY_PRODUCERS); y++)
+   {
+      for(x = 0, sum = 0; (x < MY_CONSUMERS); x++)
+         sum += consumer_data[x].sums[y];
+      if (sum != (((uint64_t)MY_OBJS * (MY_OBJS - 1)) / 2))
+         return(trutils_error(opts, NULL, "objects from producer %zu were lost or duplicated", y));
+   };
+   if (tinyrad_mpqueue_dequeue(&queue, &obj) != -1)
+      return(trutils_error(opts, NULL, "drained queue returned object"));
+   tinyrad_mpqueue_clear(&queue, NULL);
+
+   return(0);
+}
+
+
+/// Dequeues objects until every producer's objects are consumed
+void *
+my_consumer(
+         void *                        arg )
+{
+   MyThread *     thread;
+   uint64_t       obj;
+   uint64_t       producer;
+   uint64_t       seq;
+   uint64_t       next[MY_PRODUCERS];
+
+   thread = arg;
+   memset(next, 0, sizeof(next));
+
+   while (atomic_load(thread->consumed) < ((size_t)MY_PRODUCERS * MY_OBJS))
+   {
+      if (tinyrad_mpqueue_dequeue(thread->queue, &obj) != 0)
+      {
+         sched_yield();
+         continue;
+      };
+      atomic_fetch_add(thread->consumed, 1);
+      producer = obj >> 32;
+      seq      = obj & 0xffffffffULL;
+      // objects of one producer are never dequeued out of order
+      if ( (producer >= MY_PRODUCERS) || (seq < next[producer]) )
+      {
+         thread->err = 1;
+         continue;
+      };
+      next[producer]            = seq + 1;
+      thread->sums[producer]   += seq;
+   };
+
+   return(NULL);
+}
+
+
+/// Enqueues objects tagged with the producer and a sequence number
+void *
+my_producer(
+         void *                        arg )
+{
+   MyThread *     thread;
+   uint64_t       obj;
+   uint64_t       seq;
+
+   thread = arg;
+
+   for(seq = 0; (seq < MY_OBJS); seq++)
+   {
+      obj = (thread->id << 32) | seq;
+      while (tinyrad_mpqueue_enqueue(thread->queue, &obj) != 0)
+         sched_yield();
+   };
+
+   return(NULL);
+}
+
+/* end of source */
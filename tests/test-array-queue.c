@@ -63,7 +63,8 @@
 #undef PROGRAM_NAME
 #define PROGRAM_NAME "tinyrad-array-queue"
 
-#define MY_LIST_LEN  256 // must be a multiple of 4
+#define MY_LIST_LEN     256 // must be a multiple of 4
+#define MY_RING_PASSES  16  // enqueue the test data this many times into the ring buffer
 
 
 //////////////////
@@ -134,6 +135,7 @@ int main( int argc, char * argv[] )
    MyData *             src[MY_LIST_LEN];
    MyData **            list;
    MyData **            objp;
+   TinyRadQueue         queue;
 
    // getopt options
    static char          short_opt[] = "dhVvq";
@@ -270,6 +272,41 @@ int main( int argc, char * argv[] )
    while (list_len > 0)
       if (tinyrad_array_dequeue(list, &list_len, sizeof(MyData *)) == NULL)
          return(trutils_error(opts, NULL, "unable to dequeue from queue"));
+   free(list);
+
+
+   // interleave enqueues and dequeues so the ring buffer wraps while growing
+   trutils_verbose(opts, "queueing to ring buffer ...");
+   tinyrad_queue_initialize(&queue, sizeof(MyData *));
+   if (tinyrad_queue_peek(&queue) != NULL)
+      return(trutils_error(opts, NULL, "empty ring buffer returned object"));
+   for(x = 0, pos = 0; (x < (MY_LIST_LEN * MY_RING_PASSES)); x++)
+   {
+      if ((x % 4) == 3)
+      {
+         if ((objp = tinyrad_queue_peek(&queue)) == NULL)
+            return(trutils_error(opts, NULL, "unable to peek ring buffer"));
+         if ((objp = tinyrad_queue_dequeue(&queue)) == NULL)
+            return(trutils_error(opts, NULL, "unable to dequeue from ring buffer"));
+         if (*objp != src[pos % MY_LIST_LEN])
+            return(trutils_error(opts, NULL, "ring buffer dequeued object out of order"));
+         pos++;
+      };
+      if (tinyrad_queue_enqueue(&queue, &src[x % MY_LIST_LEN]) != 0)
+         return(trutils_error(opts, NULL, "failed to enqueue object to ring buffer"));
+   };
+   if (queue.len != (x - pos))
+      return(trutils_error(opts, NULL, "ring buffer length is incorrect"));
+
+
+   // drain ring buffer and verify order
+   trutils_verbose(opts, "dequeueing from ring buffer ...");
+   for(; ((objp = tinyrad_queue_dequeue(&queue)) != NULL); pos++)
+      if (*objp != src[pos % MY_LIST_LEN])
+         return(trutils_error(opts, NULL, "ring buffer dequeued object out of order"));
+   if (pos != x)
+      return(trutils_error(opts, NULL, "ring buffer lost objects"));
+   tinyrad_queue_clear(&queue, NULL);
 
    return(0);
 }
@@ -68,6 +68,7 @@
 #define PROGRAM_NAME "tinyrad-array-sorted"
 
 #define MY_LIST_LEN  256
+#define MY_BATCH_LEN 96
 
 #define MY_OBJ_NAME     0x01000000UL
 #define MY_OBJ_VALUE    0x02000000UL
@@ -153,6 +154,17 @@ my_compar_opts(
          int (**comparp)(const void *, const void *) );
 
 
+void
+my_free_obj(
+         void *                        ptr );
+
+
+int
+my_test_add_many(
+         unsigned                      opts,
+         unsigned                      arrayopt );
+
+
 int
 my_test_insert(
          unsigned                      opts,
@@ -496,6 +508,20 @@ int main( int argc, char * argv[] )
       return(trutils_error(opts, NULL, "list still has elements"));
    free(list);
 
+
+   // insert batches of data into sorted list
+   opts = opts & ~MY_MASK;
+   if ((my_test_add_many(opts, TINYRAD_ARRAY_INSERT)))
+      return(1);
+   if ((my_test_add_many(opts, TINYRAD_ARRAY_REPLACE)))
+      return(1);
+   if ((my_test_add_many(opts, TINYRAD_ARRAY_MERGE | TINYRAD_ARRAY_FIRSTDUP)))
+      return(1);
+   if ((my_test_add_many(opts, TINYRAD_ARRAY_MERGE | TINYRAD_ARRAY_LASTDUP)))
+      return(1);
+   if ((my_test_add_many(opts, TINYRAD_ARRAY_MERGE | TINYRAD_ARRAY_ANYDUP)))
+      return(1);
+
    return(0);
 }
 
@@ -578,6 +604,101 @@ my_compar_opts(
 }
 
 
+void
+my_free_obj(
+         void *                        ptr )
+{
+   MyData ** objp = ptr;
+   (*objp)->opts = -1;
+   return;
+}
+
+
+int
+my_test_add_many(
+         unsigned                      opts,
+         unsigned                      arrayopt )
+{
+   size_t         x;
+   size_t         pos;
+   size_t         len;
+   size_t         stored;
+   size_t         a_len;
+   size_t         b_len;
+   ssize_t        rc;
+   MyData **      a_list;
+   MyData **      b_list;
+   MyData *       batch[MY_BATCH_LEN];
+   MyData         a_data[MY_BATCH_LEN*2];
+   MyData         b_data[MY_BATCH_LEN*2];
+   int            a_freed[MY_BATCH_LEN*2];
+
+   trutils_verbose(opts, "testing   tinyrad_array_add_many( 0x%04x ) ...", arrayopt);
+
+   // values repeat so the batch has duplicates of itself and of the list
+   for(x = 0; (x < (MY_BATCH_LEN*2)); x++)
+   {
+      a_data[x].name  = NULL;
+      a_data[x].value = (int)((x * 7) % (MY_BATCH_LEN / 2));
+      a_data[x].opts  = (int)x;
+      b_data[x]       = a_data[x];
+   };
+
+   // populate both lists with the same objects
+   a_list = NULL;
+   b_list = NULL;
+   a_len  = 0;
+   b_len  = 0;
+   for(x = 0; (x < MY_BATCH_LEN); x++)
+   {
+      tinyrad_array_add((void **)&a_list, &a_len, sizeof(MyData *), &(MyData *){ &a_data[x] }, arrayopt, &my_compare_obj_value, &my_free_obj, &realloc);
+      tinyrad_array_add((void **)&b_list, &b_len, sizeof(MyData *), &(MyData *){ &b_data[x] }, arrayopt, &my_compare_obj_value, &my_free_obj, &realloc);
+   };
+
+   // add remaining objects one at a time and as a batch
+   for(x = MY_BATCH_LEN; (x < (MY_BATCH_LEN*2)); x++)
+      if (tinyrad_array_add((void **)&a_list, &a_len, sizeof(MyData *), &(MyData *){ &a_data[x] }, arrayopt, &my_compare_obj_value, &my_free_obj, &realloc) == -2)
+         return(trutils_error(opts, NULL, "tinyrad_array_add(): out of virtual memory"));
+   for(x = 0; (x < MY_BATCH_LEN); x++)
+      batch[x] = &b_data[MY_BATCH_LEN + x];
+   if ((rc = tinyrad_array_add_many((void **)&b_list, &b_len, sizeof(MyData *), batch, MY_BATCH_LEN, arrayopt, &my_compare_obj_value, &my_free_obj, &realloc)) < 0)
+      return(trutils_error(opts, NULL, "tinyrad_array_add_many(): out of virtual memory"));
+
+   trutils_verbose(opts, "verifying tinyrad_array_add_many( 0x%04x ) ...", arrayopt);
+   if (a_len != b_len)
+      return(trutils_error(opts, NULL, "tinyrad_array_add_many(): list length %zu, expected %zu", b_len, a_len));
+   for(x = 0; (x < b_len); x++)
+   {
+      if (a_list[x]->value != b_list[x]->value)
+         return(trutils_error(opts, NULL, "tinyrad_array_add_many(): misordered the list"));
+      if ( ((arrayopt & TINYRAD_ARRAY_MASK_DUPS) != TINYRAD_ARRAY_ANYDUP) && (a_list[x]->opts != b_list[x]->opts) )
+         return(trutils_error(opts, NULL, "tinyrad_array_add_many(): duplicates out of order"));
+   };
+   for(x = 0; (x < (MY_BATCH_LEN*2)); x++)
+      a_freed[x] = (a_data[x].opts == -1);
+   for(x = 0; (x < (MY_BATCH_LEN*2)); x++)
+      if (a_freed[x] != (b_data[x].opts == -1))
+         return(trutils_error(opts, NULL, "tinyrad_array_add_many(): freed wrong objects"));
+
+   // verify stored objects are at the start of the batch
+   for(pos = 0, stored = 0; (pos < MY_BATCH_LEN); pos++)
+   {
+      for(x = 0; ( (x < b_len) && (b_list[x] != batch[pos]) ); x++);
+      len = ((x < b_len)) ? 1 : 0;
+      if ( ((len)) && (pos >= (size_t)rc) )
+         return(trutils_error(opts, NULL, "tinyrad_array_add_many(): stored object after returned count"));
+      stored += len;
+   };
+   if (stored != (size_t)rc)
+      return(trutils_error(opts, NULL, "tinyrad_array_add_many(): returned %zi, stored %zu", rc, stored));
+
+   free(a_list);
+   free(b_list);
+
+   return(0);
+}
+
+
 int
 my_test_insert(
          unsigned                      opts,
@@ -64,6 +64,7 @@
 #define PROGRAM_NAME "tinyrad-array-stack"
 
 #define MY_LIST_LEN  256
+#define MY_REALLOCS  16   // capacity grows geometrically, so pushes realloc rarely
 
 
 //////////////////
@@ -99,6 +100,9 @@ static const char * test_strs[] =
 };
 
 
+static size_t my_realloc_count = 0;
+
+
 //////////////////
 //              //
 //  Prototypes  //
@@ -112,6 +116,12 @@ main(
          char *                        argv[] );
 
 
+void *
+my_realloc(
+         void *                        ptr,
+         size_t                        size );
+
+
 /////////////////
 //             //
 //  Functions  //
@@ -128,6 +138,7 @@ int main( int argc, char * argv[] )
    size_t               pos;
    size_t               len;
    size_t               list_len;
+   size_t               list_size;
    size_t               x;
    size_t               y;
    MyData               data[MY_LIST_LEN];
@@ -234,8 +245,9 @@ int main( int argc, char * argv[] )
 
    // loop through test data and add to stack
    trutils_verbose(opts, "pushing to stack ...");
-   list     = NULL;
-   list_len = 0;
+   list      = NULL;
+   list_len  = 0;
+   list_size = 0;
    for(x = 0; (x < MY_LIST_LEN); x++)
    {
       // periodically pop data
@@ -248,9 +260,14 @@ int main( int argc, char * argv[] )
       };
 
       // adds objects to stack
-      if (tinyrad_array_push((void **)&list, &list_len, sizeof(MyData *), &src[x], &realloc) == -1)
+      if (tinyrad_array_grow((void **)&list, list_len, &list_size, sizeof(MyData *), &my_realloc) != 0)
+         return(trutils_error(opts, NULL, "out of virtual memory"));
+      if (tinyrad_array_push((void **)&list, &list_len, sizeof(MyData *), &src[x], NULL) == -1)
          return(trutils_error(opts, NULL, "failed to push object to stack"));
    };
+   trutils_verbose(opts, "   %zu reallocations", my_realloc_count);
+   if (my_realloc_count > MY_REALLOCS)
+      return(trutils_error(opts, NULL, "stack reallocated %zu times", my_realloc_count));
 
 
    // loop through stack and verify data
@@ -272,9 +289,45 @@ int main( int argc, char * argv[] )
    while (list_len > 0)
       if (tinyrad_array_pop(list, &list_len, sizeof(MyData *)) == NULL)
          return(trutils_error(opts, NULL, "unable to pop from stack"));
+   free(list);
+
+
+   // push to stack allocated with exactly one object
+   trutils_verbose(opts, "pushing to exactly sized stack ...");
+   if ((list = malloc(sizeof(MyData *))) == NULL)
+      return(trutils_error(opts, NULL, "out of virtual memory"));
+   list[0]  = src[0];
+   list_len = 1;
+   for(x = 1; (x < MY_LIST_LEN); x++)
+   {
+      if (tinyrad_array_push((void **)&list, &list_len, sizeof(MyData *), &src[x], &realloc) == -1)
+      {
+         free(list);
+         return(trutils_error(opts, NULL, "failed to push object to stack"));
+      };
+   };
+   for(x = 0; (x < MY_LIST_LEN); x++)
+   {
+      if (list[x] != src[x])
+      {
+         free(list);
+         return(trutils_error(opts, NULL, "stack data does not match test data"));
+      };
+   };
+   free(list);
 
    return(0);
 }
 
+
+void *
+my_realloc(
+         void *                        ptr,
+         size_t                        size )
+{
+   my_realloc_count++;
+   return(realloc(ptr, size));
+}
+
 /* end of source */
 
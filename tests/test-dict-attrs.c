@@ -47,6 +47,7 @@
 #include <strings.h>
 #include <unistd.h>
 #include <getopt.h>
+#include <ctype.h>
 #include <assert.h>
 
 #include <tinyrad.h>
@@ -77,12 +78,25 @@ main(
          int                           argc,
          char *                        argv[] );
 
+int
+my_test_lookups(
+         unsigned                      opts,
+         unsigned                      tr_opts,
+         int                           readonly );
+
 int
 my_verify_attr(
          unsigned                      opts,
          const TinyRadDictAttrDef *    attr_def,
          TinyRadDictAttr *             attr );
 
+int
+my_verify_prefix(
+         unsigned                      opts,
+         TinyRadDict *                 dict,
+         const char *                  name,
+         size_t                        len );
+
 
 /////////////////
 //             //
@@ -99,12 +113,13 @@ main(
    int                           opt;
    int                           c;
    int                           opt_index;
-   size_t                        pos;
    unsigned                      opts;
    unsigned                      tr_opts;
+   int                           rc;
+   size_t                        x;
+   char **                       names;
+   char **                       frozen;
    TinyRadDict *                 dict;
-   TinyRadDictAttr *             attr;
-   const TinyRadDictAttrDef *    attr_def;
 
    // getopt options
    static char          short_opt[] = "dhVvq";
@@ -173,9 +188,61 @@ main(
       };
    };
 
+   // verifies lookups of mutable and frozen dictionaries
+   if ((my_test_lookups(opts, tr_opts, TRAD_NO)))
+      return(1);
+   if ((my_test_lookups(opts, tr_opts, TRAD_YES)))
+      return(1);
+
+   // verifies frozen and mutable dictionaries return the same names
+   trutils_verbose(opts, "default attribute search by prefix in mutable dictionary ...");
+   if ((rc = tinyrad_dict_initialize(&dict, TRAD_NOINIT|TRAD_BUILTIN_DICT)) != TRAD_SUCCESS)
+      return(trutils_error(opts, NULL, "tinyrad_dict_initialize(): %s", tinyrad_strerror(rc)));
+   if ((rc = tinyrad_dict_attr_prefix(dict, "acct-", &names)) != TRAD_SUCCESS)
+   {
+      tinyrad_free(dict);
+      return(trutils_error(opts, NULL, "tinyrad_dict_attr_prefix(): %s", tinyrad_strerror(rc)));
+   };
+   opt = TRAD_YES;
+   tinyrad_dict_set_option(dict, TRAD_DICT_OPT_READONLY, &opt);
+   if ((rc = tinyrad_dict_attr_prefix(dict, "ACCT-", &frozen)) != TRAD_SUCCESS)
+   {
+      tinyrad_strsfree(names);
+      tinyrad_free(dict);
+      return(trutils_error(opts, NULL, "tinyrad_dict_attr_prefix(): %s", tinyrad_strerror(rc)));
+   };
+   tinyrad_free(dict);
+   for(x = 0; ( ((names)) && ((frozen)) && ((names[x])) && ((frozen[x])) ); x++)
+      if ((strcmp(names[x], frozen[x])))
+         break;
+   rc = ( (!(names)) || (!(frozen)) || ((names[x])) || ((frozen[x])) ) ? 1 : 0;
+   tinyrad_strsfree(names);
+   tinyrad_strsfree(frozen);
+   if ((rc))
+      return(trutils_error(opts, NULL, "prefix results of mutable and frozen dictionaries do not match"));
+
+   return(0);
+}
+
+
+int
+my_test_lookups(
+         unsigned                      opts,
+         unsigned                      tr_opts,
+         int                           readonly )
+{
+   size_t                        pos;
+   int                           rc;
+   size_t                        x;
+   char **                       names;
+   TinyRadDict *                 dict;
+   TinyRadDictAttr *             attr;
+   const TinyRadDictAttrDef *    attr_def;
+
    // initialize test dictionary
-   if ((our_dict_initialize(opts, tr_opts, &dict)))
+   if ((our_dict_initialize(opts, tr_opts, readonly, &dict)))
       return(1);
+   trutils_verbose(opts, "testing %s dictionary ...", ((readonly)) ? "frozen" : "mutable");
 
    trutils_verbose(opts, "                                 %4s %9s %7s  %s", "Type", "Vendor", "Vendor", "Name");
    trutils_verbose(opts, "                                 %4s %9s %7s  %s",     "",     "ID",   "Type",     "");
@@ -264,6 +331,35 @@ main(
       };
    };
 
+   // verifies prefix queries of test attribute names
+   for(pos = 0; ((test_dict_data_attrs[pos].name)); pos++)
+   {
+      attr_def = &test_dict_data_attrs[pos];
+      trutils_verbose(opts, "test    attribute search by prefix %s ...", attr_def->name);
+      for(x = 1; (x <= strlen(attr_def->name)); x++)
+      {
+         if ((my_verify_prefix(opts, dict, attr_def->name, x)))
+         {
+            tinyrad_free(dict);
+            return(1);
+         };
+      };
+   };
+
+   // verifies unknown prefix
+   trutils_verbose(opts, "test    attribute search by unknown prefix ...");
+   if ((rc = tinyrad_dict_attr_prefix(dict, "No-Such-Attribute-", &names)) != TRAD_SUCCESS)
+   {
+      tinyrad_free(dict);
+      return(trutils_error(opts, NULL, "tinyrad_dict_attr_prefix(): %s", tinyrad_strerror(rc)));
+   };
+   if ((names))
+   {
+      tinyrad_strsfree(names);
+      tinyrad_free(dict);
+      return(trutils_error(opts, NULL, "tinyrad_dict_attr_prefix(): returned names for unknown prefix"));
+   };
+
    // cleans up dictionary
    tinyrad_free(dict);
 
@@ -332,5 +428,49 @@ my_verify_attr(
 }
 
 
+int
+my_verify_prefix(
+         unsigned                      opts,
+         TinyRadDict *                 dict,
+         const char *                  name,
+         size_t                        len )
+{
+   int         rc;
+   int         found;
+   size_t      pos;
+   char        prefix[128];
+   char **     names;
+
+   assert(len < sizeof(prefix));
+
+   // alternate case of prefix, matches are case insensitive
+   for(pos = 0; (pos < len); pos++)
+      prefix[pos] = (pos & 1) ? (char)toupper((unsigned char)name[pos]) : (char)tolower((unsigned char)name[pos]);
+   prefix[len] = '\0';
+
+   if ((rc = tinyrad_dict_attr_prefix(dict, prefix, &names)) != TRAD_SUCCESS)
+      return(trutils_error(opts, NULL, "tinyrad_dict_attr_prefix(%s): %s", prefix, tinyrad_strerror(rc)));
+   if (!(names))
+      return(trutils_error(opts, NULL, "tinyrad_dict_attr_prefix(%s): no names returned", prefix));
+
+   found = 0;
+   for(pos = 0; ((names[pos])); pos++)
+   {
+      if ((strncasecmp(names[pos], prefix, len)))
+         break;
+      if ( (pos > 0) && (strcasecmp(names[pos-1], names[pos]) >= 0) )
+         break;
+      if (!(strcasecmp(names[pos], name)))
+         found = 1;
+   };
+   rc = ( ((names[pos])) || (!(found)) ) ? 1 : 0;
+   tinyrad_strsfree(names);
+   if ((rc))
+      return(trutils_error(opts, NULL, "tinyrad_dict_attr_prefix(%s): names do not match prefix of %s", prefix, name));
+
+   return(0);
+}
+
+
 /* end of source */
 
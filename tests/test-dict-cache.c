@@ -0,0 +1,422 @@
+/*
+ *  Tiny RADIUS Client Library
+ *  Copyright (C) 2022 David M. Syzdek <david@syzdek.net>.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of David M. Syzdek nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL DAVID M. SYZDEK BE LIABLE FOR
+ *  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ *  OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ *  SUCH DAMAGE.
+ */
+#define _TESTS_TINYRAD_DICT_CACHE_C 1
+
+
+///////////////
+//           //
+//  Headers  //
+//           //
+///////////////
+#pragma mark - Headers
+
+#include <tinyrad_utils.h>
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <assert.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include <tinyrad.h>
+
+#include "common-dict.h"
+
+
+///////////////////
+//               //
+//  Definitions  //
+//               //
+///////////////////
+#pragma mark - Definitions
+
+#undef PROGRAM_NAME
+#define PROGRAM_NAME "tinyrad-dict-cache"
+
+
+//////////////////
+//              //
+//  Prototypes  //
+//              //
+//////////////////
+#pragma mark - Prototypes
+
+int
+main(
+         int                           argc,
+         char *                        argv[] );
+
+
+int
+my_test_cache(
+         unsigned                      opts,
+         TinyRadDict *                 dict,
+         const char *                  cachefile );
+
+
+int
+my_test_stale(
+         unsigned                      opts,
+         const char *                  dictfile,
+         const char *                  cachefile );
+
+
+int
+my_write_file(
+         const char *                  filename,
+         const char *                  mode,
+         const char *                  str );
+
+
+/////////////////
+//             //
+//  Functions  //
+//             //
+/////////////////
+#pragma mark - Functions
+
+int
+main(
+         int                           argc,
+         char *                        argv[] )
+{
+   int                           opt;
+   int                           c;
+   int                           opt_index;
+   int                           rc;
+   unsigned                      opts;
+   unsigned                      tr_opts;
+   TinyRadDict *                 dict;
+   char                          cachefile[128];
+   char                          dictfile[128];
+
+   // getopt options
+   static char          short_opt[] = "dhVvq";
+   static struct option long_opt[] =
+   {
+      {"debug",            no_argument,       NULL, 'd' },
+      {"help",             no_argument,       NULL, 'h' },
+      {"quiet",            no_argument,       NULL, 'q' },
+      {"silent",           no_argument,       NULL, 'q' },
+      {"version",          no_argument,       NULL, 'V' },
+      {"verbose",          no_argument,       NULL, 'v' },
+      { NULL, 0, NULL, 0 }
+   };
+
+   trutils_initialize(PROGRAM_NAME);
+
+   opts     = 0;
+   tr_opts  = TRAD_NOINIT | TRAD_BUILTIN_DICT;
+
+   while((c = getopt_long(argc, argv, short_opt, long_opt, &opt_index)) != -1)
+   {
+      switch(c)
+      {
+         case -1:       /* no more arguments */
+         case 0:        /* long options toggles */
+         break;
+
+         case 'd':
+         opt = TRAD_DEBUG_ANY;
+         tinyrad_set_option(NULL, TRAD_OPT_DEBUG_LEVEL,  &opt);
+         break;
+
+         case 'h':
+         printf("Usage: %s [OPTIONS]\n", PROGRAM_NAME);
+         printf("OPTIONS:\n");
+         printf("  -d, --debug               print debug messages\n");
+         printf("  -h, --help                print this help and exit\n");
+         printf("  -q, --quiet, --silent     do not print messages\n");
+         printf("  -V, --version             print version number and exit\n");
+         printf("  -v, --verbose             print verbose messages\n");
+         printf("\n");
+         return(0);
+
+         case 'q':
+         opts |=  TRUTILS_OPT_QUIET;
+         opts &= ~TRUTILS_OPT_VERBOSE;
+         break;
+
+         case 'V':
+         trutils_version();
+         return(0);
+
+         case 'v':
+         opts |=  TRUTILS_OPT_VERBOSE;
+         opts &= ~TRUTILS_OPT_QUIET;
+         break;
+
+         case '?':
+         fprintf(stderr, "Try `%s --help' for more information.\n", PROGRAM_NAME);
+         return(1);
+
+         default:
+         fprintf(stderr, "%s: unrecognized option `--%c'\n", PROGRAM_NAME, c);
+         fprintf(stderr, "Try `%s --help' for more information.\n", PROGRAM_NAME);
+         return(1);
+      };
+   };
+
+   snprintf(cachefile, sizeof(cachefile), "/tmp/tinyrad-dict-cache.%i", (int)getpid());
+   snprintf(dictfile,  sizeof(dictfile),  "/tmp/tinyrad-dict-cache-src.%i", (int)getpid());
+
+   // initialize test dictionary
+   if ((our_dict_initialize(opts, tr_opts, TRAD_NO, &dict)))
+      return(1);
+
+   // verifies dictionary survives being cached
+   rc = my_test_cache(opts, dict, cachefile);
+   tinyrad_free(dict);
+   unlink(cachefile);
+   if ((rc))
+      return(1);
+
+   // verifies stale caches are rejected
+   rc = my_test_stale(opts, dictfile, cachefile);
+   unlink(cachefile);
+   unlink(dictfile);
+   if ((rc))
+      return(1);
+
+   return(0);
+}
+
+
+int
+my_test_cache(
+         unsigned                      opts,
+         TinyRadDict *                 dict,
+         const char *                  cachefile )
+{
+   int                           rc;
+   size_t                        pos;
+   uint32_t                      u32;
+   TinyRadDict *                 copy;
+   TinyRadDictAttr *             attr;
+   TinyRadDictValue *            value;
+   TinyRadDictVendor *           vendor;
+   const TinyRadDictAttrDef *    attr_def;
+   const TinyRadDictValueDef *   value_def;
+   const TinyRadDictVendorDef *  vendor_def;
+
+   trutils_verbose(opts, "saving dictionary cache ...");
+   if ((rc = tinyrad_dict_cache_save(dict, cachefile)) != TRAD_SUCCESS)
+      return(trutils_error(opts, NULL, "tinyrad_dict_cache_save(): %s", tinyrad_strerror(rc)));
+
+   trutils_verbose(opts, "loading dictionary cache ...");
+   if ((rc = tinyrad_dict_initialize(&copy, TRAD_NOINIT)) != TRAD_SUCCESS)
+      return(trutils_error(opts, NULL, "tinyrad_dict_initialize(): %s", tinyrad_strerror(rc)));
+   if ((rc = tinyrad_dict_cache_load(copy, cachefile, 0)) != TRAD_SUCCESS)
+   {
+      tinyrad_free(copy);
+      return(trutils_error(opts, NULL, "tinyrad_dict_cache_load(): %s", tinyrad_strerror(rc)));
+   };
+
+   // verifies built-in dictionary
+   trutils_verbose(opts, "test    built-in attribute User-Name ...");
+   if ((attr = tinyrad_dict_attr_get(copy, "User-Name", 0, NULL, 0, 0)) == NULL)
+   {
+      tinyrad_free(copy);
+      return(trutils_error(opts, NULL, "built-in attribute was not found"));
+   };
+   tinyrad_free(attr);
+
+   // verifies test vendors
+   for(pos = 0; ((test_dict_data_vendors[pos].name)); pos++)
+   {
+      vendor_def = &test_dict_data_vendors[pos];
+      trutils_verbose(opts, "test    vendor %s ...", vendor_def->name);
+      vendor = tinyrad_dict_vendor_get(copy, vendor_def->name, 0);
+      u32    = 0;
+      tinyrad_dict_vendor_info(vendor, TRAD_DICT_OPT_VEND_ID, &u32);
+      tinyrad_free(vendor);
+      if (u32 != vendor_def->vendor_id)
+      {
+         our_dict_diag_vendor(opts, vendor_def, vendor);
+         tinyrad_free(copy);
+         return(trutils_error(opts, NULL, "cached vendor does not match"));
+      };
+   };
+
+   // verifies test attributes
+   for(pos = 0; ((test_dict_data_attrs[pos].name)); pos++)
+   {
+      attr_def = &test_dict_data_attrs[pos];
+      trutils_verbose(opts, "test    attribute %s ...", attr_def->name);
+      attr = tinyrad_dict_attr_get(copy, NULL, attr_def->type, NULL, attr_def->vendor_id, attr_def->vendor_type);
+      u32  = 0;
+      tinyrad_dict_attr_info(attr, TRAD_DICT_OPT_DATA_TYPE, &u32);
+      if (u32 != attr_def->data_type)
+      {
+         our_dict_diag_attr(opts, attr_def, attr);
+         tinyrad_free(attr);
+         tinyrad_free(copy);
+         return(trutils_error(opts, NULL, "cached attribute does not match"));
+      };
+      tinyrad_free(attr);
+   };
+
+   // verifies test values
+   for(pos = 0; ((test_dict_data_values[pos].attr_name)); pos++)
+   {
+      value_def = &test_dict_data_values[pos];
+      trutils_verbose(opts, "test    value %s %s ...", value_def->attr_name, value_def->value_name);
+      attr  = tinyrad_dict_attr_get(copy, value_def->attr_name, 0, NULL, 0, 0);
+      value = tinyrad_dict_value_get(copy, value_def->value_name, attr, 0, 0, 0, 0);
+      tinyrad_free(attr);
+      if (!(value))
+      {
+         our_dict_diag_value(opts, value_def, value);
+         tinyrad_free(copy);
+         return(trutils_error(opts, NULL, "cached value was not found"));
+      };
+      tinyrad_free(value);
+   };
+
+   tinyrad_free(copy);
+
+   return(0);
+}
+
+
+int
+my_test_stale(
+         unsigned                      opts,
+         const char *                  dictfile,
+         const char *                  cachefile )
+{
+   int               rc;
+   char **           errs;
+   TinyRadDict *     dict;
+   TinyRadDictAttr * attr;
+   struct stat       sb;
+   struct timespec   times[2];
+
+   errs = NULL;
+
+   trutils_verbose(opts, "generating dictionary file ...");
+   if ((my_write_file(dictfile, "w", "ATTRIBUTE TinyRad-Cache-Test 227 integer\nVALUE TinyRad-Cache-Test Yes 1\n")))
+      return(trutils_error(opts, NULL, "unable to write %s", dictfile));
+
+   // parse and cache dictionary file
+   if ((rc = tinyrad_dict_initialize(&dict, TRAD_NOINIT)) != TRAD_SUCCESS)
+      return(trutils_error(opts, NULL, "tinyrad_dict_initialize(): %s", tinyrad_strerror(rc)));
+   if ((rc = tinyrad_dict_parse(dict, dictfile, &errs, 0)) != TRAD_SUCCESS)
+   {
+      trutils_error(opts, errs, "tinyrad_dict_parse(): %s", tinyrad_strerror(rc));
+      tinyrad_strsfree(errs);
+      tinyrad_free(dict);
+      return(1);
+   };
+   rc = tinyrad_dict_cache_save(dict, cachefile);
+   tinyrad_free(dict);
+   if (rc != TRAD_SUCCESS)
+      return(trutils_error(opts, NULL, "tinyrad_dict_cache_save(): %s", tinyrad_strerror(rc)));
+
+   // load current cache
+   trutils_verbose(opts, "test    loading current cache ...");
+   if ((rc = tinyrad_dict_initialize(&dict, TRAD_NOINIT)) != TRAD_SUCCESS)
+      return(trutils_error(opts, NULL, "tinyrad_dict_initialize(): %s", tinyrad_strerror(rc)));
+   rc = tinyrad_dict_cache_load(dict, cachefile, 0);
+   tinyrad_free(dict);
+   if (rc != TRAD_SUCCESS)
+      return(trutils_error(opts, NULL, "tinyrad_dict_cache_load(): %s", tinyrad_strerror(rc)));
+
+   // rewrite dictionary file within the same second without changing its size
+   if (stat(dictfile, &sb) == -1)
+      return(trutils_error(opts, NULL, "unable to stat %s", dictfile));
+   if ((my_write_file(dictfile, "w", "ATTRIBUTE TinyRad-Cache-Test 228 integer\nVALUE TinyRad-Cache-Test Yes 1\n")))
+      return(trutils_error(opts, NULL, "unable to write %s", dictfile));
+   times[0]          = sb.st_atim;
+   times[1]          = sb.st_mtim;
+   times[1].tv_nsec  = (sb.st_mtim.tv_nsec + 1) % 1000000000L;
+   if (utimensat(AT_FDCWD, dictfile, times, 0) == -1)
+      return(trutils_error(opts, NULL, "unable to set modification time of %s", dictfile));
+
+   // load cache of rewritten file
+   trutils_verbose(opts, "test    loading cache of file rewritten within same second ...");
+   if ((rc = tinyrad_dict_initialize(&dict, TRAD_NOINIT)) != TRAD_SUCCESS)
+      return(trutils_error(opts, NULL, "tinyrad_dict_initialize(): %s", tinyrad_strerror(rc)));
+   rc = tinyrad_dict_cache_load(dict, cachefile, 0);
+   tinyrad_free(dict);
+   if (rc != TRAD_ECACHE)
+      return(trutils_error(opts, NULL, "cache of rewritten file was not rejected"));
+
+   // modify dictionary file
+   if ((my_write_file(dictfile, "a", "VALUE TinyRad-Cache-Test No 0\n")))
+      return(trutils_error(opts, NULL, "unable to write %s", dictfile));
+
+   // load stale cache
+   trutils_verbose(opts, "test    loading stale cache ...");
+   if ((rc = tinyrad_dict_initialize(&dict, TRAD_NOINIT)) != TRAD_SUCCESS)
+      return(trutils_error(opts, NULL, "tinyrad_dict_initialize(): %s", tinyrad_strerror(rc)));
+   rc = tinyrad_dict_cache_load(dict, cachefile, 0);
+   if (rc != TRAD_ECACHE)
+   {
+      tinyrad_free(dict);
+      return(trutils_error(opts, NULL, "stale cache was not rejected"));
+   };
+
+   // rejected cache must not modify dictionary
+   trutils_verbose(opts, "test    dictionary unchanged by stale cache ...");
+   attr = tinyrad_dict_attr_get(dict, "TinyRad-Cache-Test", 0, NULL, 0, 0);
+   tinyrad_free(dict);
+   if ((attr))
+   {
+      tinyrad_free(attr);
+      return(trutils_error(opts, NULL, "stale cache modified dictionary"));
+   };
+
+   return(0);
+}
+
+
+int
+my_write_file(
+         const char *                  filename,
+         const char *                  mode,
+         const char *                  str )
+{
+   FILE *   fs;
+   if ((fs = fopen(filename, mode)) == NULL)
+      return(1);
+   fputs(str, fs);
+   fclose(fs);
+   return(0);
+}
+
+
+/* end of source */
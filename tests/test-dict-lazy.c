@@ -0,0 +1,540 @@
+/*
+ *  Tiny RADIUS Client Library
+ *  Copyright (C) 2022 David M. Syzdek <david@syzdek.net>.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of David M. Syzdek nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL DAVID M. SYZDEK BE LIABLE FOR
+ *  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ *  OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ *  SUCH DAMAGE.
+ */
+#define _TESTS_TINYRAD_DICT_LAZY_C 1
+
+
+///////////////
+//           //
+//  Headers  //
+//           //
+///////////////
+#pragma mark - Headers
+
+#include <tinyrad_utils.h>
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <assert.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+
+#include <tinyrad.h>
+
+#include "common-dict.h"
+
+
+///////////////////
+//               //
+//  Definitions  //
+//               //
+///////////////////
+#pragma mark - Definitions
+
+#undef PROGRAM_NAME
+#define PROGRAM_NAME "tinyrad-dict-lazy"
+
+#define MY_FILES     3
+#define MY_THREADS   4
+#define MY_LOOKUPS   256
+#define MY_ROUNDS    32
+
+
+//////////////////
+//              //
+//  Data Types  //
+//              //
+//////////////////
+#pragma mark - Data Types
+
+typedef struct my_race
+{
+   TinyRadDict *           dict;
+   atomic_int              started;    // number of readers performing lookups
+   atomic_int              loaded;     // remaining vendor blocks have been parsed
+} MyRace;
+
+
+/////////////////
+//             //
+//  Variables  //
+//             //
+/////////////////
+#pragma mark - Variables
+
+#pragma mark my_files[]
+static const char * my_files[MY_FILES][2] =
+{
+   { "dictionary",         "VENDOR Lazy-Example 64002\n"
+                           "VENDOR Lazy-Other 64003\n"
+                           "VENDOR Lazy-Include 64004\n"
+                           "ATTRIBUTE Lazy-Std 231 integer\n"
+                           "BEGIN-VENDOR Lazy-Example\n"
+                           "ATTRIBUTE Lazy-Level 1 integer\n"
+                           "ATTRIBUTE Lazy-Name 2 string\n"
+                           "VALUE Lazy-Level Low 1\n"
+                           "END-VENDOR Lazy-Example\n"
+                           "BEGIN-VENDOR Lazy-Other\n"
+                           "ATTRIBUTE Lazy-Other-Id 1 integer\n"
+                           "END-VENDOR Lazy-Other\n"
+                           "BEGIN-VENDOR Lazy-Include\n"
+                           "$INCLUDE dictionary.include\n"
+                           "END-VENDOR Lazy-Include\n"
+                           "BEGIN-VENDOR Lazy-Example\n"
+                           "ATTRIBUTE Lazy-Mode 3 integer\n"
+                           "END-VENDOR Lazy-Example\n" },
+   { "dictionary.include", "ATTRIBUTE Lazy-Included 1 integer\n" },
+   { "dictionary.deps",    "$INCLUDE dictionary\n"
+                           "VALUE Lazy-Level High 3\n"
+                           "VALUE Lazy-Mode Auto 1\n" },
+};
+
+
+//////////////////
+//              //
+//  Prototypes  //
+//              //
+//////////////////
+#pragma mark - Prototypes
+
+int
+main(
+         int                           argc,
+         char *                        argv[] );
+
+
+int
+my_deferred(
+         unsigned                      opts,
+         const char *                  dir );
+
+
+int
+my_race(
+         unsigned                      opts,
+         const char *                  dir );
+
+
+void *
+my_race_reader(
+         void *                        arg );
+
+
+int
+my_value_miss(
+         unsigned                      opts,
+         const char *                  dir );
+
+
+void *
+my_worker(
+         void *                        arg );
+
+
+/////////////////
+//             //
+//  Functions  //
+//             //
+/////////////////
+#pragma mark - Functions
+
+int
+main(
+         int                           argc,
+         char *                        argv[] )
+{
+   int                           opt;
+   int                           c;
+   int                           opt_index;
+   int                           rc;
+   unsigned                      opts;
+   char                          dir[128];
+   char                          out_eager[256];
+   char                          out_lazy[256];
+
+   // getopt options
+   static char          short_opt[] = "dhVvq";
+   static struct option long_opt[] =
+   {
+      {"debug",            no_argument,       NULL, 'd' },
+      {"help",             no_argument,       NULL, 'h' },
+      {"quiet",            no_argument,       NULL, 'q' },
+      {"silent",           no_argument,       NULL, 'q' },
+      {"version",          no_argument,       NULL, 'V' },
+      {"verbose",          no_argument,       NULL, 'v' },
+      { NULL, 0, NULL, 0 }
+   };
+
+   trutils_initialize(PROGRAM_NAME);
+
+   opts     = 0;
+
+   while((c = getopt_long(argc, argv, short_opt, long_opt, &opt_index)) != -1)
+   {
+      switch(c)
+      {
+         case -1:       /* no more arguments */
+         case 0:        /* long options toggles */
+         break;
+
+         case 'd':
+         opt = TRAD_DEBUG_ANY;
+         tinyrad_set_option(NULL, TRAD_OPT_DEBUG_LEVEL,  &opt);
+         break;
+
+         case 'h':
+         printf("Usage: %s [OPTIONS]\n", PROGRAM_NAME);
+         printf("OPTIONS:\n");
+         printf("  -d, --debug               print debug messages\n");
+         printf("  -h, --help                print this help and exit\n");
+         printf("  -q, --quiet, --silent     do not print messages\n");
+         printf("  -V, --version             print version number and exit\n");
+         printf("  -v, --verbose             print verbose messages\n");
+         printf("\n");
+         return(0);
+
+         case 'q':
+         opts |=  TRUTILS_OPT_QUIET;
+         opts &= ~TRUTILS_OPT_VERBOSE;
+         break;
+
+         case 'V':
+         trutils_version();
+         return(0);
+
+         case 'v':
+         opts |=  TRUTILS_OPT_VERBOSE;
+         opts &= ~TRUTILS_OPT_QUIET;
+         break;
+
+         case '?':
+         fprintf(stderr, "Try `%s --help' for more information.\n", PROGRAM_NAME);
+         return(1);
+
+         default:
+         fprintf(stderr, "%s: unrecognized option `--%c'\n", PROGRAM_NAME, c);
+         fprintf(stderr, "Try `%s --help' for more information.\n", PROGRAM_NAME);
+         return(1);
+      };
+   };
+
+   // create dictionary files
+   if ((our_dict_files_create(opts, "lazy", my_files, MY_FILES, dir, sizeof(dir))))
+      return(1);
+   snprintf(out_eager, sizeof(out_eager), "%s.eager", dir);
+   snprintf(out_lazy,  sizeof(out_lazy),  "%s.lazy", dir);
+
+   // verifies lazy parse defines the same objects as eager parse
+   trutils_verbose(opts, "test    parsing vendor blocks on demand ...");
+   rc = our_dict_parse(opts, dir, "dictionary.deps", 0, out_eager, NULL, NULL);
+   if (rc == 0)
+      rc = our_dict_parse(opts, dir, "dictionary.deps", TRAD_DICT_PARSE_LAZY, out_lazy, NULL, NULL);
+   if (rc == 0)
+      if ((rc = our_dict_file_cmp(out_eager, out_lazy)) != 0)
+         trutils_error(opts, NULL, "lazy parse does not match eager parse");
+
+   // verifies vendor blocks are parsed when vendor is used
+   if (rc == 0)
+      rc = my_deferred(opts, dir);
+
+   // verifies missing values only parse the blocks which may define them
+   if (rc == 0)
+      rc = my_value_miss(opts, dir);
+
+   // verifies lookups are safe while the last vendor blocks are parsed
+   if (rc == 0)
+      rc = my_race(opts, dir);
+
+   // remove dictionary files
+   our_dict_files_remove(dir, my_files, MY_FILES);
+   unlink(out_eager);
+   unlink(out_lazy);
+
+   return(rc);
+}
+
+
+int
+my_deferred(
+         unsigned                      opts,
+         const char *                  dir )
+{
+   int                  rc;
+   int                  readonly;
+   size_t               pos;
+   FILE *               fs;
+   char                 path[256];
+   void *               res;
+   pthread_t            threads[MY_THREADS];
+   TinyRadDict *        dict;
+   TinyRadDictAttr *    attr;
+
+   trutils_verbose(opts, "test    parsing vendor blocks from multiple threads ...");
+   if ((our_dict_parse(opts, dir, "dictionary", TRAD_DICT_PARSE_LAZY, NULL, NULL, &dict)))
+      return(1);
+   readonly = TRAD_YES;
+   if ((rc = tinyrad_dict_set_option(dict, TRAD_DICT_OPT_READONLY, &readonly)) != TRAD_SUCCESS)
+   {
+      tinyrad_free(dict);
+      return(trutils_error(opts, NULL, "tinyrad_dict_set_option(TRAD_DICT_OPT_READONLY): %s", tinyrad_strerror(rc)));
+   };
+   for(pos = 0; (pos < MY_THREADS); pos++)
+      if ((pthread_create(&threads[pos], NULL, &my_worker, dict)))
+         break;
+   rc = (pos < MY_THREADS) ? trutils_error(opts, NULL, "unable to create thread") : 0;
+   while(pos > 0)
+   {
+      pthread_join(threads[--pos], &res);
+      if (!(res))
+         rc = trutils_error(opts, NULL, "vendor attribute not found by thread");
+   };
+
+   // blocks of files modified after parsing are discarded
+   if (rc == 0)
+   {
+      trutils_verbose(opts, "test    discarding vendor blocks of modified files ...");
+      snprintf(path, sizeof(path), "%s/%s", dir, my_files[0][0]);
+      if ((fs = fopen(path, "a")) != NULL)
+      {
+         fputs("# modified\n", fs);
+         fclose(fs);
+      };
+      if ((attr = tinyrad_dict_attr_get(dict, NULL, TRAD_ATTR_VENDOR_SPECIFIC, NULL, 64002, 1)) != NULL)
+      {
+         tinyrad_free(attr);
+         rc = trutils_error(opts, NULL, "vendor block of modified file was parsed");
+      };
+      if ((attr = tinyrad_dict_attr_get(dict, "Lazy-Std", 0, NULL, 0, 0)) == NULL)
+         rc = trutils_error(opts, NULL, "attribute outside of vendor block not found");
+      tinyrad_free(attr);
+   };
+
+   tinyrad_free(dict);
+
+   return(rc);
+}
+
+
+int
+my_race(
+         unsigned                      opts,
+         const char *                  dir )
+{
+   int                  rc;
+   int                  readonly;
+   size_t               pos;
+   size_t               round;
+   void *               res;
+   pthread_t            threads[MY_THREADS];
+   TinyRadDictAttr *    attr;
+   MyRace               race;
+
+   trutils_verbose(opts, "test    looking up attributes while last vendor blocks are parsed ...");
+
+   for(round = 0, rc = 0; ( (round < MY_ROUNDS) && (rc == 0) ); round++)
+   {
+      memset(&race, 0, sizeof(race));
+      if ((our_dict_parse(opts, dir, "dictionary", TRAD_DICT_PARSE_LAZY, NULL, NULL, &race.dict)))
+         return(1);
+      readonly = TRAD_YES;
+      if ((rc = tinyrad_dict_set_option(race.dict, TRAD_DICT_OPT_READONLY, &readonly)) != TRAD_SUCCESS)
+      {
+         tinyrad_free(race.dict);
+         return(trutils_error(opts, NULL, "tinyrad_dict_set_option(TRAD_DICT_OPT_READONLY): %s", tinyrad_strerror(rc)));
+      };
+      atomic_init(&race.started, 0);
+      atomic_init(&race.loaded,  0);
+
+      for(pos = 0; (pos < MY_THREADS); pos++)
+         if ((pthread_create(&threads[pos], NULL, &my_race_reader, &race)))
+            break;
+      rc = (pos < MY_THREADS) ? trutils_error(opts, NULL, "unable to create thread") : 0;
+      while ( (rc == 0) && (atomic_load(&race.started) < MY_THREADS) )
+         sched_yield();
+
+      // unknown name causes all remaining blocks to be parsed
+      if ((attr = tinyrad_dict_attr_get(race.dict, "Lazy-Missing", 0, NULL, 0, 0)) != NULL)
+         rc = trutils_error(opts, NULL, "undefined attribute was found");
+      tinyrad_free(attr);
+      atomic_store_explicit(&race.loaded, 1, memory_order_relaxed);
+      if ((attr = tinyrad_dict_attr_get(race.dict, "Lazy-Included", 0, NULL, 0, 0)) == NULL)
+         rc = trutils_error(opts, NULL, "attribute of last vendor block not found");
+      tinyrad_free(attr);
+
+      while(pos > 0)
+      {
+         pthread_join(threads[--pos], &res);
+         if (!(res))
+            rc = trutils_error(opts, NULL, "attribute not found while vendor blocks were parsed");
+      };
+
+      tinyrad_free(race.dict);
+   };
+
+   return(rc);
+}
+
+
+void *
+my_race_reader(
+         void *                        arg )
+{
+   size_t               pos;
+   MyRace *             race;
+   TinyRadDictAttr *    attr;
+
+   race = arg;
+
+   // half of the readers start once the blocks have been parsed, without
+   // otherwise synchronizing with the thread which parsed them
+   if ((atomic_fetch_add(&race->started, 1) & 1))
+      while (!(atomic_load_explicit(&race->loaded, memory_order_relaxed)))
+         sched_yield();
+
+   // look up attributes until shortly after the blocks have been parsed
+   for(pos = 0; (pos < MY_LOOKUPS); pos += (size_t)atomic_load_explicit(&race->loaded, memory_order_relaxed))
+   {
+      if ((attr = tinyrad_dict_attr_get(race->dict, "Lazy-Std", 0, NULL, 0, 0)) == NULL)
+         return(NULL);
+      tinyrad_free(attr);
+      if ((attr = tinyrad_dict_attr_get(race->dict, NULL, 231, NULL, 0, 0)) == NULL)
+         return(NULL);
+      tinyrad_free(attr);
+   };
+
+   return(race);
+}
+
+
+int
+my_value_miss(
+         unsigned                      opts,
+         const char *                  dir )
+{
+   int                  rc;
+   int                  readonly;
+   size_t               attrs;
+   TinyRadDict *        dict;
+   TinyRadDictAttr *    attr;
+   TinyRadDictValue *   value;
+   TinyRadDictStats     stats;
+
+   trutils_verbose(opts, "test    looking up missing values of vendor attributes ...");
+   if ((our_dict_parse(opts, dir, "dictionary", TRAD_DICT_PARSE_LAZY, NULL, NULL, &dict)))
+      return(1);
+   readonly = TRAD_YES;
+   if ((rc = tinyrad_dict_set_option(dict, TRAD_DICT_OPT_READONLY, &readonly)) != TRAD_SUCCESS)
+   {
+      tinyrad_free(dict);
+      return(trutils_error(opts, NULL, "tinyrad_dict_set_option(TRAD_DICT_OPT_READONLY): %s", tinyrad_strerror(rc)));
+   };
+
+   // parses blocks of vendor
+   if ((attr = tinyrad_dict_attr_get(dict, NULL, TRAD_ATTR_VENDOR_SPECIFIC, NULL, 64002, 1)) == NULL)
+   {
+      tinyrad_free(dict);
+      return(trutils_error(opts, NULL, "vendor attribute not found"));
+   };
+   tinyrad_dict_get_option(dict, TRAD_DICT_OPT_STATS, &stats);
+   attrs = stats.attrs;
+
+   // missing value of vendor attribute must not parse blocks of other vendors
+   if ((value = tinyrad_dict_value_get(dict, "Lazy-Missing", attr, 0, 0, 0, 0)) != NULL)
+   {
+      tinyrad_free(value);
+      rc = trutils_error(opts, NULL, "undefined value was found");
+   };
+   tinyrad_free(attr);
+   tinyrad_dict_get_option(dict, TRAD_DICT_OPT_STATS, &stats);
+   if ( (rc == 0) && (stats.attrs != attrs) )
+      rc = trutils_error(opts, NULL, "missing vendor value parsed blocks of other vendors");
+
+   // missing value of other attributes parses remaining blocks
+   if (rc == 0)
+   {
+      trutils_verbose(opts, "test    looking up missing values of standard attributes ...");
+      if ((attr = tinyrad_dict_attr_get(dict, "Lazy-Std", 0, NULL, 0, 0)) == NULL)
+         rc = trutils_error(opts, NULL, "attribute outside of vendor block not found");
+      else if ((value = tinyrad_dict_value_get(dict, "Lazy-Missing", attr, 0, 0, 0, 0)) != NULL)
+      {
+         tinyrad_free(value);
+         rc = trutils_error(opts, NULL, "undefined value was found");
+      };
+      tinyrad_free(attr);
+      tinyrad_dict_get_option(dict, TRAD_DICT_OPT_STATS, &stats);
+      if ( (rc == 0) && (stats.attrs == attrs) )
+         rc = trutils_error(opts, NULL, "missing value did not parse remaining vendor blocks");
+   };
+
+   tinyrad_free(dict);
+
+   return(rc);
+}
+
+
+void *
+my_worker(
+         void *                        arg )
+{
+   size_t               pos;
+   uint32_t             vendor_id;
+   TinyRadDict *        dict;
+   TinyRadDictAttr *    attr;
+   TinyRadDictVendor *  vendor;
+
+   dict = arg;
+
+   // look up attributes of deferred and immediately parsed vendor blocks
+   for(pos = 0; (pos < MY_LOOKUPS); pos++)
+   {
+      vendor_id = ((pos & 1)) ? 64003 : 64004;
+      if ((vendor = tinyrad_dict_vendor_get(dict, NULL, vendor_id)) == NULL)
+         return(NULL);
+      attr = tinyrad_dict_attr_get(dict, NULL, TRAD_ATTR_VENDOR_SPECIFIC, vendor, 0, 1);
+      tinyrad_free(vendor);
+      if (!(attr))
+         return(NULL);
+      tinyrad_free(attr);
+      if ((attr = tinyrad_dict_attr_get(dict, NULL, TRAD_ATTR_VENDOR_SPECIFIC, NULL, 64003, 1)) == NULL)
+         return(NULL);
+      tinyrad_free(attr);
+   };
+
+   return(dict);
+}
+
+
+/* end of source */
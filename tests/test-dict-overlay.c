@@ -0,0 +1,375 @@
+/*
+ *  Tiny RADIUS Client Library
+ *  Copyright (C) 2022 David M. Syzdek <david@syzdek.net>.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of David M. Syzdek nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL DAVID M. SYZDEK BE LIABLE FOR
+ *  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ *  OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ *  SUCH DAMAGE.
+ */
+#define _TESTS_TINYRAD_DICT_OVERLAY_C 1
+
+
+///////////////
+//           //
+//  Headers  //
+//           //
+///////////////
+#pragma mark - Headers
+
+#include <tinyrad_utils.h>
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <assert.h>
+
+#include <tinyrad.h>
+
+#include "common-dict.h"
+
+
+///////////////////
+//               //
+//  Definitions  //
+//               //
+///////////////////
+#pragma mark - Definitions
+
+#undef PROGRAM_NAME
+#define PROGRAM_NAME "tinyrad-dict-overlay"
+
+
+/////////////////
+//             //
+//  Variables  //
+//             //
+/////////////////
+#pragma mark - Variables
+
+#pragma mark overlay_dict_vendors[]
+static const TinyRadDictVendorDef overlay_dict_vendors[] =
+{
+   { "Overlay-Example", 64000,   1, 1 },  // vendor only defined by overlay
+   { NULL, 0, 0, 0 }
+};
+
+
+#pragma mark overlay_dict_attrs[]
+static const TinyRadDictAttrDef overlay_dict_attrs[] =
+{
+   { "Overlay-Color",             26,      64000,            1,   TRAD_DATATYPE_INTEGER,     0 },  // attribute of overlay vendor
+   { "Syzdek-Overlay",            26,      27893,          200,   TRAD_DATATYPE_INTEGER,     0 },  // attribute of base vendor
+   { "TinyRad-Overlay",          227,          0,            0,   TRAD_DATATYPE_INTEGER,     0 },  // standard attribute
+   { NULL, 0, 0, 0, 0, 0 }
+};
+
+
+#pragma mark overlay_dict_conflicts[]
+static const TinyRadDictAttrDef overlay_dict_conflicts[] =
+{
+   { "Syzdek-Faith",              26,      27893,            1,   TRAD_DATATYPE_TEXT,        0 },  // conflicts with base attribute
+   { NULL, 0, 0, 0, 0, 0 }
+};
+
+
+#pragma mark overlay_dict_values[]
+static const TinyRadDictValueDef overlay_dict_values[] =
+{
+   { "Syzdek-Animal-Group",       "Overlay-Animals",          99 },  // value of base attribute
+   { "TinyRad-Overlay",           "Yes",                       1 },  // value of overlay attribute
+   { NULL, NULL, 0 }
+};
+
+
+//////////////////
+//              //
+//  Prototypes  //
+//              //
+//////////////////
+#pragma mark - Prototypes
+
+int
+main(
+         int                           argc,
+         char *                        argv[] );
+
+
+int
+my_test_lookups(
+         unsigned                      opts,
+         TinyRadDict *                 base,
+         TinyRadDict *                 overlay );
+
+
+/////////////////
+//             //
+//  Functions  //
+//             //
+/////////////////
+#pragma mark - Functions
+
+int
+main(
+         int                           argc,
+         char *                        argv[] )
+{
+   int                           opt;
+   int                           c;
+   int                           opt_index;
+   int                           rc;
+   int                           readonly;
+   unsigned                      opts;
+   unsigned                      tr_opts;
+   char **                       errs;
+   TinyRadDict *                 base;
+   TinyRadDict *                 overlay;
+
+   // getopt options
+   static char          short_opt[] = "dhVvq";
+   static struct option long_opt[] =
+   {
+      {"debug",            no_argument,       NULL, 'd' },
+      {"help",             no_argument,       NULL, 'h' },
+      {"quiet",            no_argument,       NULL, 'q' },
+      {"silent",           no_argument,       NULL, 'q' },
+      {"version",          no_argument,       NULL, 'V' },
+      {"verbose",          no_argument,       NULL, 'v' },
+      { NULL, 0, NULL, 0 }
+   };
+
+   trutils_initialize(PROGRAM_NAME);
+
+   opts     = 0;
+   tr_opts  = TRAD_NOINIT | TRAD_BUILTIN_DICT;
+
+   while((c = getopt_long(argc, argv, short_opt, long_opt, &opt_index)) != -1)
+   {
+      switch(c)
+      {
+         case -1:       /* no more arguments */
+         case 0:        /* long options toggles */
+         break;
+
+         case 'd':
+         opt = TRAD_DEBUG_ANY;
+         tinyrad_set_option(NULL, TRAD_OPT_DEBUG_LEVEL,  &opt);
+         break;
+
+         case 'h':
+         printf("Usage: %s [OPTIONS]\n", PROGRAM_NAME);
+         printf("OPTIONS:\n");
+         printf("  -d, --debug               print debug messages\n");
+         printf("  -h, --help                print this help and exit\n");
+         printf("  -q, --quiet, --silent     do not print messages\n");
+         printf("  -V, --version             print version number and exit\n");
+         printf("  -v, --verbose             print verbose messages\n");
+         printf("\n");
+         return(0);
+
+         case 'q':
+         opts |=  TRUTILS_OPT_QUIET;
+         opts &= ~TRUTILS_OPT_VERBOSE;
+         break;
+
+         case 'V':
+         trutils_version();
+         return(0);
+
+         case 'v':
+         opts |=  TRUTILS_OPT_VERBOSE;
+         opts &= ~TRUTILS_OPT_QUIET;
+         break;
+
+         case '?':
+         fprintf(stderr, "Try `%s --help' for more information.\n", PROGRAM_NAME);
+         return(1);
+
+         default:
+         fprintf(stderr, "%s: unrecognized option `--%c'\n", PROGRAM_NAME, c);
+         fprintf(stderr, "Try `%s --help' for more information.\n", PROGRAM_NAME);
+         return(1);
+      };
+   };
+
+   errs     = NULL;
+   readonly = TRAD_YES;
+
+   // initialize mutable dictionary
+   if ((rc = tinyrad_dict_initialize(&base, TRAD_NOINIT)) != TRAD_SUCCESS)
+      return(trutils_error(opts, NULL, "tinyrad_dict_initialize(): %s", tinyrad_strerror(rc)));
+
+   // verifies overlay requires read-only base
+   trutils_verbose(opts, "test    overlay of mutable dictionary ...");
+   rc = tinyrad_dict_initialize_overlay(base, &overlay);
+   tinyrad_free(base);
+   if (rc != TRAD_EINVAL)
+      return(trutils_error(opts, NULL, "overlay of mutable dictionary was not rejected"));
+
+   // initialize test dictionary
+   if ((our_dict_initialize(opts, tr_opts, TRAD_YES, &base)))
+      return(1);
+
+   trutils_verbose(opts, "initializing overlay dictionary ...");
+   if ((rc = tinyrad_dict_initialize_overlay(base, &overlay)) != TRAD_SUCCESS)
+   {
+      tinyrad_free(base);
+      return(trutils_error(opts, NULL, "tinyrad_dict_initialize_overlay(): %s", tinyrad_strerror(rc)));
+   };
+
+   // verifies overlay rejects definitions of base dictionary
+   trutils_verbose(opts, "test    redefining base attribute ...");
+   if ((rc = tinyrad_dict_import(overlay, NULL, overlay_dict_conflicts, NULL, &errs)) == TRAD_SUCCESS)
+   {
+      tinyrad_free(overlay);
+      tinyrad_free(base);
+      return(trutils_error(opts, NULL, "redefined base attribute was not rejected"));
+   };
+   tinyrad_strsfree(errs);
+
+   trutils_verbose(opts, "adding overlay definitions ...");
+   if ((rc = tinyrad_dict_import(overlay, overlay_dict_vendors, overlay_dict_attrs, overlay_dict_values, &errs)) != TRAD_SUCCESS)
+   {
+      trutils_error(opts, errs, "tinyrad_dict_import(): %s", tinyrad_strerror(rc));
+      tinyrad_strsfree(errs);
+      tinyrad_free(overlay);
+      tinyrad_free(base);
+      return(1);
+   };
+
+   // verifies lookups of mutable overlay
+   if ((my_test_lookups(opts, base, overlay)))
+   {
+      tinyrad_free(overlay);
+      tinyrad_free(base);
+      return(1);
+   };
+
+   trutils_verbose(opts, "freezing overlay dictionary ...");
+   if ((rc = tinyrad_dict_set_option(overlay, TRAD_DICT_OPT_READONLY, &readonly)) != TRAD_SUCCESS)
+   {
+      tinyrad_free(overlay);
+      tinyrad_free(base);
+      return(trutils_error(opts, NULL, "tinyrad_dict_set_option(TRAD_DICT_OPT_READONLY): %s", tinyrad_strerror(rc)));
+   };
+
+   // verifies lookups of read-only overlay
+   rc = my_test_lookups(opts, base, overlay);
+   tinyrad_free(overlay);
+   tinyrad_free(base);
+
+   return(rc);
+}
+
+
+int
+my_test_lookups(
+         unsigned                      opts,
+         TinyRadDict *                 base,
+         TinyRadDict *                 overlay )
+{
+   size_t                        pos;
+   uint32_t                      u32;
+   TinyRadDictAttr *             attr;
+   TinyRadDictValue *            value;
+   TinyRadDictVendor *           vendor;
+   const TinyRadDictAttrDef *    attr_def;
+   const TinyRadDictValueDef *   value_def;
+
+   // verifies base definitions are visible through overlay
+   trutils_verbose(opts, "test    built-in attribute User-Name ...");
+   if ((attr = tinyrad_dict_attr_get(overlay, NULL, 1, NULL, 0, 0)) == NULL)
+      return(trutils_error(opts, NULL, "built-in attribute was not found"));
+   tinyrad_free(attr);
+   for(pos = 0; ((test_dict_data_attrs[pos].name)); pos++)
+   {
+      attr_def = &test_dict_data_attrs[pos];
+      trutils_verbose(opts, "test    base attribute %s ...", attr_def->name);
+      attr = tinyrad_dict_attr_get(overlay, NULL, attr_def->type, NULL, attr_def->vendor_id, attr_def->vendor_type);
+      u32  = 0;
+      tinyrad_dict_attr_info(attr, TRAD_DICT_OPT_DATA_TYPE, &u32);
+      if (u32 != attr_def->data_type)
+      {
+         our_dict_diag_attr(opts, attr_def, attr);
+         tinyrad_free(attr);
+         return(trutils_error(opts, NULL, "base attribute was not found"));
+      };
+      tinyrad_free(attr);
+   };
+
+   // verifies overlay definitions are visible through overlay only
+   trutils_verbose(opts, "test    overlay vendor %s ...", overlay_dict_vendors[0].name);
+   if ((vendor = tinyrad_dict_vendor_get(overlay, NULL, overlay_dict_vendors[0].vendor_id)) == NULL)
+      return(trutils_error(opts, NULL, "overlay vendor was not found"));
+   tinyrad_free(vendor);
+   if ((vendor = tinyrad_dict_vendor_get(base, overlay_dict_vendors[0].name, 0)) != NULL)
+   {
+      tinyrad_free(vendor);
+      return(trutils_error(opts, NULL, "overlay vendor is visible in base dictionary"));
+   };
+   for(pos = 0; ((overlay_dict_attrs[pos].name)); pos++)
+   {
+      attr_def = &overlay_dict_attrs[pos];
+      trutils_verbose(opts, "test    overlay attribute %s ...", attr_def->name);
+      if ((attr = tinyrad_dict_attr_get(overlay, attr_def->name, 0, NULL, 0, 0)) == NULL)
+         return(trutils_error(opts, NULL, "overlay attribute was not found by name"));
+      tinyrad_free(attr);
+      if ((attr = tinyrad_dict_attr_get(overlay, NULL, attr_def->type, NULL, attr_def->vendor_id, attr_def->vendor_type)) == NULL)
+         return(trutils_error(opts, NULL, "overlay attribute was not found by type"));
+      tinyrad_free(attr);
+      if ((attr = tinyrad_dict_attr_get(base, attr_def->name, 0, NULL, 0, 0)) != NULL)
+      {
+         tinyrad_free(attr);
+         return(trutils_error(opts, NULL, "overlay attribute is visible in base dictionary"));
+      };
+   };
+   for(pos = 0; ((overlay_dict_values[pos].attr_name)); pos++)
+   {
+      value_def = &overlay_dict_values[pos];
+      trutils_verbose(opts, "test    overlay value %s %s ...", value_def->attr_name, value_def->value_name);
+      attr  = tinyrad_dict_attr_get(overlay, value_def->attr_name, 0, NULL, 0, 0);
+      value = tinyrad_dict_value_get(overlay, value_def->value_name, attr, 0, 0, 0, 0);
+      tinyrad_free(attr);
+      if (!(value))
+         return(trutils_error(opts, NULL, "overlay value was not found"));
+      tinyrad_free(value);
+   };
+   attr  = tinyrad_dict_attr_get(base, overlay_dict_values[0].attr_name, 0, NULL, 0, 0);
+   value = tinyrad_dict_value_get(base, overlay_dict_values[0].value_name, attr, 0, 0, 0, 0);
+   tinyrad_free(attr);
+   if ((value))
+   {
+      tinyrad_free(value);
+      return(trutils_error(opts, NULL, "overlay value is visible in base dictionary"));
+   };
+
+   return(0);
+}
+
+
+/* end of source */
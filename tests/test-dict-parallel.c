@@ -0,0 +1,276 @@
+/*
+ *  Tiny RADIUS Client Library
+ *  Copyright (C) 2022 David M. Syzdek <david@syzdek.net>.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of David M. Syzdek nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL DAVID M. SYZDEK BE LIABLE FOR
+ *  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ *  OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ *  SUCH DAMAGE.
+ */
+#define _TESTS_TINYRAD_DICT_PARALLEL_C 1
+
+
+///////////////
+//           //
+//  Headers  //
+//           //
+///////////////
+#pragma mark - Headers
+
+#include <tinyrad_utils.h>
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <assert.h>
+
+#include <tinyrad.h>
+
+#include "common-dict.h"
+
+
+///////////////////
+//               //
+//  Definitions  //
+//               //
+///////////////////
+#pragma mark - Definitions
+
+#undef PROGRAM_NAME
+#define PROGRAM_NAME "tinyrad-dict-parallel"
+
+#define MY_FILES     7
+
+
+/////////////////
+//             //
+//  Variables  //
+//             //
+/////////////////
+#pragma mark - Variables
+
+#pragma mark my_files[]
+static const char * my_files[MY_FILES][2] =
+{
+   { "dictionary",         "VENDOR Parallel-Example 64001\n"
+                           "$INCLUDE dictionary.rfc\n"
+                           "BEGIN-VENDOR Parallel-Example\n"
+                           "$INCLUDE dictionary.vendor\n"
+                           "END-VENDOR Parallel-Example\n"
+                           "VALUE Parallel-Level High 3\n" },
+   { "dictionary.rfc",     "ATTRIBUTE Parallel-Std 230 integer\n"
+                           "$INCLUDE dictionary.values\n" },
+   { "dictionary.values",  "VALUE Parallel-Std Yes 1\n"
+                           "VALUE Parallel-Std No 0\n" },
+   { "dictionary.vendor",  "ATTRIBUTE Parallel-Level 1 integer\n"
+                           "ATTRIBUTE Parallel-Name 2 string\n"
+                           "VALUE Parallel-Level Low 1\n" },
+   { "dictionary.broken",  "ATTRIBUTE Parallel-Std 230 integer\n"
+                           "$INCLUDE dictionary.bad\n"
+                           "$INCLUDE dictionary.missing\n" },
+   { "dictionary.bad",     "VALUE Parallel-Std Yes 1\n"
+                           "ATTRIBUTE Parallel-Bad\n" },
+   { "dictionary.loop",    "ATTRIBUTE Parallel-Loop 231 string\n"
+                           "$INCLUDE dictionary.loop\n"
+                           "$INCLUDE dictionary.loop\n" },
+};
+
+
+//////////////////
+//              //
+//  Prototypes  //
+//              //
+//////////////////
+#pragma mark - Prototypes
+
+int
+main(
+         int                           argc,
+         char *                        argv[] );
+
+
+/////////////////
+//             //
+//  Functions  //
+//             //
+/////////////////
+#pragma mark - Functions
+
+int
+main(
+         int                           argc,
+         char *                        argv[] )
+{
+   int                           opt;
+   int                           c;
+   int                           opt_index;
+   int                           rc;
+   size_t                        pos;
+   unsigned                      opts;
+   char **                       errs_serial;
+   char **                       errs_parallel;
+   char                          dir[128];
+   char                          out_serial[256];
+   char                          out_parallel[256];
+
+   // getopt options
+   static char          short_opt[] = "dhVvq";
+   static struct option long_opt[] =
+   {
+      {"debug",            no_argument,       NULL, 'd' },
+      {"help",             no_argument,       NULL, 'h' },
+      {"quiet",            no_argument,       NULL, 'q' },
+      {"silent",           no_argument,       NULL, 'q' },
+      {"version",          no_argument,       NULL, 'V' },
+      {"verbose",          no_argument,       NULL, 'v' },
+      { NULL, 0, NULL, 0 }
+   };
+
+   trutils_initialize(PROGRAM_NAME);
+
+   opts     = 0;
+
+   while((c = getopt_long(argc, argv, short_opt, long_opt, &opt_index)) != -1)
+   {
+      switch(c)
+      {
+         case -1:       /* no more arguments */
+         case 0:        /* long options toggles */
+         break;
+
+         case 'd':
+         opt = TRAD_DEBUG_ANY;
+         tinyrad_set_option(NULL, TRAD_OPT_DEBUG_LEVEL,  &opt);
+         break;
+
+         case 'h':
+         printf("Usage: %s [OPTIONS]\n", PROGRAM_NAME);
+         printf("OPTIONS:\n");
+         printf("  -d, --debug               print debug messages\n");
+         printf("  -h, --help                print this help and exit\n");
+         printf("  -q, --quiet, --silent     do not print messages\n");
+         printf("  -V, --version             print version number and exit\n");
+         printf("  -v, --verbose             print verbose messages\n");
+         printf("\n");
+         return(0);
+
+         case 'q':
+         opts |=  TRUTILS_OPT_QUIET;
+         opts &= ~TRUTILS_OPT_VERBOSE;
+         break;
+
+         case 'V':
+         trutils_version();
+         return(0);
+
+         case 'v':
+         opts |=  TRUTILS_OPT_VERBOSE;
+         opts &= ~TRUTILS_OPT_QUIET;
+         break;
+
+         case '?':
+         fprintf(stderr, "Try `%s --help' for more information.\n", PROGRAM_NAME);
+         return(1);
+
+         default:
+         fprintf(stderr, "%s: unrecognized option `--%c'\n", PROGRAM_NAME, c);
+         fprintf(stderr, "Try `%s --help' for more information.\n", PROGRAM_NAME);
+         return(1);
+      };
+   };
+
+   errs_serial    = NULL;
+   errs_parallel  = NULL;
+
+   // create dictionary files
+   if ((our_dict_files_create(opts, "parallel", my_files, MY_FILES, dir, sizeof(dir))))
+      return(1);
+   snprintf(out_serial,   sizeof(out_serial),   "%s.serial", dir);
+   snprintf(out_parallel, sizeof(out_parallel), "%s.parallel", dir);
+
+   // verifies parallel parse matches serial parse
+   trutils_verbose(opts, "test    parsing include tree ...");
+   rc = our_dict_parse(opts, dir, "dictionary", 0, out_serial, &errs_serial, NULL);
+   if (rc == 0)
+      rc = our_dict_parse(opts, dir, "dictionary", TRAD_DICT_PARSE_PARALLEL, out_parallel, &errs_parallel, NULL);
+   if (rc == 0)
+      if ((rc = our_dict_file_cmp(out_serial, out_parallel)) != 0)
+         trutils_error(opts, NULL, "parallel parse does not match serial parse");
+   tinyrad_strsfree(errs_serial);
+   tinyrad_strsfree(errs_parallel);
+   errs_serial    = NULL;
+   errs_parallel  = NULL;
+
+   // verifies parallel parse reports the same errors as serial parse
+   if (rc == 0)
+   {
+      trutils_verbose(opts, "test    parsing broken include tree ...");
+      if ((our_dict_parse(opts, dir, "dictionary.broken", 0, NULL, &errs_serial, NULL)) == 0)
+         rc = trutils_error(opts, NULL, "serial parse of broken dictionary succeeded");
+      else if ((our_dict_parse(opts, dir, "dictionary.broken", TRAD_DICT_PARSE_PARALLEL, NULL, &errs_parallel, NULL)) == 0)
+         rc = trutils_error(opts, NULL, "parallel parse of broken dictionary succeeded");
+      for(pos = 0; ( (rc == 0) && ( ((errs_serial[pos])) || ((errs_parallel[pos])) ) ); pos++)
+      {
+         trutils_verbose(opts, "        %s", ((errs_serial[pos])) ? errs_serial[pos] : "(null)");
+         if ( (!(errs_serial[pos])) || (!(errs_parallel[pos])) || ((strcmp(errs_serial[pos], errs_parallel[pos]))) )
+            rc = trutils_error(opts, NULL, "parallel parse errors do not match serial parse errors");
+      };
+      tinyrad_strsfree(errs_serial);
+      tinyrad_strsfree(errs_parallel);
+      errs_serial    = NULL;
+      errs_parallel  = NULL;
+   };
+
+   // verifies files including themselves are rejected instead of recursing
+   if (rc == 0)
+   {
+      trutils_verbose(opts, "test    parsing recursive include tree ...");
+      if ((our_dict_parse(opts, dir, "dictionary.loop", 0, NULL, &errs_serial, NULL)) == 0)
+         rc = trutils_error(opts, NULL, "serial parse of recursive dictionary succeeded");
+      else if ((our_dict_parse(opts, dir, "dictionary.loop", TRAD_DICT_PARSE_PARALLEL, NULL, &errs_parallel, NULL)) == 0)
+         rc = trutils_error(opts, NULL, "parallel parse of recursive dictionary succeeded");
+      for(pos = 0; ( (rc == 0) && ( ((errs_serial[pos])) || ((errs_parallel[pos])) ) ); pos++)
+      {
+         trutils_verbose(opts, "        %s", ((errs_serial[pos])) ? errs_serial[pos] : "(null)");
+         if ( (!(errs_serial[pos])) || (!(errs_parallel[pos])) || ((strcmp(errs_serial[pos], errs_parallel[pos]))) )
+            rc = trutils_error(opts, NULL, "parallel parse errors do not match serial parse errors");
+      };
+      tinyrad_strsfree(errs_serial);
+      tinyrad_strsfree(errs_parallel);
+   };
+
+   // remove dictionary files
+   our_dict_files_remove(dir, my_files, MY_FILES);
+   unlink(out_serial);
+   unlink(out_parallel);
+
+   return(rc);
+}
+
+
+/* end of source */
@@ -77,6 +77,12 @@ main(
          int                           argc,
          char *                        argv[] );
 
+int
+my_test_lookups(
+         unsigned                      opts,
+         unsigned                      tr_opts,
+         int                           readonly );
+
 int
 my_verify_value(
          unsigned                      opts,
@@ -100,13 +106,8 @@ main(
    int                           opt;
    int                           c;
    int                           opt_index;
-   size_t                        pos;
    unsigned                      opts;
    unsigned                      tr_opts;
-   TinyRadDict *                 dict;
-   TinyRadDictAttr *             attr;
-   TinyRadDictValue *            value;
-   const TinyRadDictValueDef *   value_def;
 
    // getopt options
    static char          short_opt[] = "dhVvq";
@@ -175,9 +176,33 @@ main(
       };
    };
 
+   // verifies lookups of mutable and frozen dictionaries
+   if ((my_test_lookups(opts, tr_opts, TRAD_NO)))
+      return(1);
+   if ((my_test_lookups(opts, tr_opts, TRAD_YES)))
+      return(1);
+
+   return(0);
+}
+
+
+int
+my_test_lookups(
+         unsigned                      opts,
+         unsigned                      tr_opts,
+         int                           readonly )
+{
+   size_t                        pos;
+   TinyRadDict *                 dict;
+   TinyRadDictAttr *             attr;
+   TinyRadDictValue *            value;
+   const TinyRadDictValueDef *   value_def;
+   static const uint64_t         undefined_data[] = { 0, 7, 255, 256, 1000000 };
+
    // initialize test dictionary
-   if ((our_dict_initialize(opts, tr_opts, &dict)))
+   if ((our_dict_initialize(opts, tr_opts, readonly, &dict)))
       return(1);
+   trutils_verbose(opts, "testing %s dictionary ...", ((readonly)) ? "frozen" : "mutable");
 
    trutils_verbose(opts, "                                 %4s %9s %7s  %s", "Type", "Vendor", "Vendor", "Name");
    trutils_verbose(opts, "                                 %4s %9s %7s  %s",     "",     "ID",   "Type",     "");
@@ -302,6 +327,27 @@ main(
       tinyrad_free(attr);
    };
 
+   // verifies undefined data is not found
+   for(pos = 0; (pos < (sizeof(undefined_data)/sizeof(undefined_data[0]))); pos++)
+   {
+      trutils_verbose(opts, "test    value search by data     %25s %25s %3" PRIu64 "  ...", "Syzdek-Animal-Group", "(undefined)", undefined_data[pos]);
+      if ((attr = tinyrad_dict_attr_get(dict, "Syzdek-Animal-Group", 0, NULL, 0, 0)) == NULL)
+      {
+         trutils_error(opts, NULL, "%s: unable to retrieve attribute", "Syzdek-Animal-Group");
+         tinyrad_free(dict);
+         return(1);
+      };
+      value = tinyrad_dict_value_get(dict, NULL, attr, 0, 0, 0, undefined_data[pos]);
+      tinyrad_free(attr);
+      if ((value))
+      {
+         trutils_error(opts, NULL, "%s: %" PRIu64 ": undefined value found", "Syzdek-Animal-Group", undefined_data[pos]);
+         tinyrad_free(value);
+         tinyrad_free(dict);
+         return(1);
+      };
+   };
+
    // cleans up dictionary
    tinyrad_free(dict);
 
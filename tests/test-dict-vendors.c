@@ -77,6 +77,12 @@ main(
          int                           argc,
          char *                        argv[] );
 
+int
+my_test_lookups(
+         unsigned                      opts,
+         unsigned                      tr_opts,
+         int                           readonly );
+
 int
 my_verify_vendor(
          unsigned                      opts,
@@ -99,12 +105,8 @@ main(
    int                           opt;
    int                           c;
    int                           opt_index;
-   size_t                        pos;
    unsigned                      opts;
    unsigned                      tr_opts;
-   TinyRadDict *                 dict;
-   TinyRadDictVendor *           vendor;
-   const TinyRadDictVendorDef *  vendor_def;
 
    // getopt options
    static char          short_opt[] = "dhVvq";
@@ -173,9 +175,31 @@ main(
       };
    };
 
+   // verifies lookups of mutable and frozen dictionaries
+   if ((my_test_lookups(opts, tr_opts, TRAD_NO)))
+      return(1);
+   if ((my_test_lookups(opts, tr_opts, TRAD_YES)))
+      return(1);
+
+   return(0);
+}
+
+
+int
+my_test_lookups(
+         unsigned                      opts,
+         unsigned                      tr_opts,
+         int                           readonly )
+{
+   size_t                        pos;
+   TinyRadDict *                 dict;
+   TinyRadDictVendor *           vendor;
+   const TinyRadDictVendorDef *  vendor_def;
+
    // initialize test dictionary
-   if ((our_dict_initialize(opts, tr_opts, &dict)))
+   if ((our_dict_initialize(opts, tr_opts, readonly, &dict)))
       return(1);
+   trutils_verbose(opts, "testing %s dictionary ...", ((readonly)) ? "frozen" : "mutable");
 
    trutils_verbose(opts, "Vendor format: vendor id/name");
 
@@ -0,0 +1,306 @@
+/*
+ *  Tiny RADIUS Client Library
+ *  Copyright (C) 2022 David M. Syzdek <david@syzdek.net>.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of David M. Syzdek nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL DAVID M. SYZDEK BE LIABLE FOR
+ *  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ *  OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ *  SUCH DAMAGE.
+ */
+#define _TESTS_TINYRAD_FILE_READLINE_C 1
+
+
+///////////////
+//           //
+//  Headers  //
+//           //
+///////////////
+#pragma mark - Headers
+
+#include <tinyrad_utils.h>
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <errno.h>
+#include <assert.h>
+
+#include <tinyrad.h>
+
+
+///////////////////
+//               //
+//  Definitions  //
+//               //
+///////////////////
+#pragma mark - Definitions
+
+#undef PROGRAM_NAME
+#define PROGRAM_NAME "tinyrad-file-readline"
+
+#define MY_LINE_COUNT      512
+#define MY_LINE_MAX        4096
+
+
+/////////////////
+//             //
+//  Variables  //
+//             //
+/////////////////
+#pragma mark - Variables
+
+static const size_t test_sizes[] = { 64, 100, 1024, 0 };
+
+
+//////////////////
+//              //
+//  Prototypes  //
+//              //
+//////////////////
+#pragma mark - Prototypes
+
+int
+main(
+         int                           argc,
+         char *                        argv[] );
+
+
+size_t
+my_line_len(
+         size_t                        lineno );
+
+
+int
+my_test_file(
+         unsigned                      opts,
+         const char *                  filename,
+         size_t                        size );
+
+
+/////////////////
+//             //
+//  Functions  //
+//             //
+/////////////////
+#pragma mark - Functions
+
+int
+main(
+         int                           argc,
+         char *                        argv[] )
+{
+   int            opt;
+   int            c;
+   int            opt_index;
+   int            fd;
+   int            rc;
+   size_t         x;
+   size_t         len;
+   unsigned       opts;
+   FILE *         fs;
+   char           filename[64];
+   char           line[MY_LINE_MAX];
+
+   // getopt options
+   static char          short_opt[] = "dhVvq";
+   static struct option long_opt[] =
+   {
+      {"debug",            no_argument,       NULL, 'd' },
+      {"help",             no_argument,       NULL, 'h' },
+      {"quiet",            no_argument,       NULL, 'q' },
+      {"silent",           no_argument,       NULL, 'q' },
+      {"version",          no_argument,       NULL, 'V' },
+      {"verbose",          no_argument,       NULL, 'v' },
+      { NULL, 0, NULL, 0 }
+   };
+
+   trutils_initialize(PROGRAM_NAME);
+
+   opts   = 0;
+
+   while((c = getopt_long(argc, argv, short_opt, long_opt, &opt_index)) != -1)
+   {
+      switch(c)
+      {
+         case -1:       /* no more arguments */
+         case 0:        /* long options toggles */
+         break;
+
+         case 'd':
+         opt = TRAD_DEBUG_ANY;
+         tinyrad_set_option(NULL, TRAD_OPT_DEBUG_LEVEL,  &opt);
+         break;
+
+         case 'h':
+         printf("Usage: %s [OPTIONS]\n", PROGRAM_NAME);
+         printf("OPTIONS:\n");
+         printf("  -d, --debug               print debug messages\n");
+         printf("  -h, --help                print this help and exit\n");
+         printf("  -q, --quiet, --silent     do not print messages\n");
+         printf("  -V, --version             print version number and exit\n");
+         printf("  -v, --verbose             print verbose messages\n");
+         printf("\n");
+         return(0);
+
+         case 'q':
+         opts |=  TRUTILS_OPT_QUIET;
+         opts &= ~TRUTILS_OPT_VERBOSE;
+         break;
+
+         case 'V':
+         trutils_version();
+         return(0);
+
+         case 'v':
+         opts |=  TRUTILS_OPT_VERBOSE;
+         opts &= ~TRUTILS_OPT_QUIET;
+         break;
+
+         case '?':
+         fprintf(stderr, "Try `%s --help' for more information.\n", PROGRAM_NAME);
+         return(1);
+
+         default:
+         fprintf(stderr, "%s: unrecognized option `--%c'\n", PROGRAM_NAME, c);
+         fprintf(stderr, "Try `%s --help' for more information.\n", PROGRAM_NAME);
+         return(1);
+      };
+   };
+
+   // create test file, alternating line endings and ending without a line feed
+   tinyrad_strlcpy(filename, "/tmp/tinyrad-readline-XXXXXX", sizeof(filename));
+   if ((fd = mkstemp(filename)) == -1)
+   {
+      trutils_error(opts, NULL, "mkstemp(): %s", strerror(errno));
+      return(1);
+   };
+   if ((fs = fdopen(fd, "w")) == NULL)
+   {
+      trutils_error(opts, NULL, "fdopen(): %s", strerror(errno));
+      close(fd);
+      unlink(filename);
+      return(1);
+   };
+   for(x = 0; (x < MY_LINE_COUNT); x++)
+   {
+      len = my_line_len(x);
+      memset(line, (int)('a' + (x % 26)), len);
+      fwrite(line, 1, len, fs);
+      if (x < (MY_LINE_COUNT - 1))
+         fputs((((x % 3)) ? "\n" : "\r\n"), fs);
+   };
+   fclose(fs);
+
+   // read test file with initial buffers smaller and larger than lines
+   rc = 0;
+   for(x = 0; ( (!(rc)) && (x < (sizeof(test_sizes)/sizeof(test_sizes[0]))) ); x++)
+      rc = my_test_file(opts, filename, test_sizes[x]);
+
+   unlink(filename);
+
+   return(rc);
+}
+
+
+size_t
+my_line_len(
+         size_t                        lineno )
+{
+   switch(lineno % 8)
+   {
+      case 0:  return(0);
+      case 1:  return(lineno % 61);
+      case 2:  return(255);
+      case 3:  return(256);
+      case 4:  return(257);
+      case 5:  return((lineno * 37) % MY_LINE_MAX);
+      case 6:  return(MY_LINE_MAX - 1);
+      default: break;
+   };
+   return(1);
+}
+
+
+int
+my_test_file(
+         unsigned                      opts,
+         const char *                  filename,
+         size_t                        size )
+{
+   int               rc;
+   size_t            lineno;
+   size_t            len;
+   size_t            pos;
+   char *            line;
+   TRUtilsFile *     fb;
+
+   trutils_verbose(opts, "reading %s with %zu byte buffer", filename, size);
+
+   if ((fb = trutils_open(opts, filename, size)) == NULL)
+      return(1);
+
+   for(lineno = 0; ((rc = trutils_readline(opts, fb, &line, &len)) == 1); lineno++)
+   {
+      if (lineno >= MY_LINE_COUNT)
+      {
+         trutils_error(opts, NULL, "trutils_readline(): returned more than %i lines", MY_LINE_COUNT);
+         trutils_close(fb);
+         return(1);
+      };
+      if ( (len != my_line_len(lineno)) || (strlen(line) != len) )
+      {
+         trutils_error(opts, NULL, "trutils_readline(): line %zu: returned %zu bytes, expected %zu", lineno, len, my_line_len(lineno));
+         trutils_close(fb);
+         return(1);
+      };
+      for(pos = 0; (pos < len); pos++)
+      {
+         if (line[pos] != (char)('a' + (lineno % 26)))
+         {
+            trutils_error(opts, NULL, "trutils_readline(): line %zu: contents do not match", lineno);
+            trutils_close(fb);
+            return(1);
+         };
+      };
+   };
+
+   trutils_close(fb);
+
+   if (rc != 0)
+      return(1);
+   if (lineno != MY_LINE_COUNT)
+   {
+      trutils_error(opts, NULL, "trutils_readline(): returned %zu lines, expected %i", lineno, MY_LINE_COUNT);
+      return(1);
+   };
+
+   return(0);
+}
+
+
+/* end of source */
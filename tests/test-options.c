@@ -87,8 +87,16 @@ int main( int argc, char * argv[] )
    int                  rc;
    int                  debug;
    unsigned             opts;
+   unsigned             uval;
    char *               str;
    TinyRad *            tr;
+   TinyRadDict *        dict;
+   TinyRadDict *        dict_old;
+   TinyRadDict *        dict_cur;
+   TinyRadDictAttr *    attr;
+   TinyRadDictStats     stats;
+   uint64_t             lookups;
+   uint64_t             misses;
    struct timeval       tv;
 
    // getopt options
@@ -221,6 +229,67 @@ int main( int argc, char * argv[] )
    if ((rc = tinyrad_get_option(tr, TRAD_OPT_DESC, &opt)) != TRAD_SUCCESS)
       return(trutils_error(opts, NULL, "tinyrad_get_option(tr, TRAD_OPT_DESC, &opt): %s", tinyrad_strerror(rc)));
 
+   // TRAD_OPT_DICTIONARY
+   dict_old = NULL;
+   if ((rc = tinyrad_get_option(tr, TRAD_OPT_DICTIONARY, &dict_old)) != TRAD_SUCCESS)
+      return(trutils_error(opts, NULL, "tinyrad_get_option(tr, TRAD_OPT_DICTIONARY, &dict): %s", tinyrad_strerror(rc)));
+   if ((rc = tinyrad_dict_initialize(&dict, TRAD_NOINIT|TRAD_BUILTIN_DICT|TRAD_DICT_STATS)) != TRAD_SUCCESS)
+      return(trutils_error(opts, NULL, "tinyrad_dict_initialize(): %s", tinyrad_strerror(rc)));
+   if ((rc = tinyrad_set_option(tr, TRAD_OPT_DICTIONARY, dict)) == TRAD_SUCCESS)
+      return(trutils_error(opts, NULL, "tinyrad_set_option(tr, TRAD_OPT_DICTIONARY, dict): was able to set mutable dictionary"));
+   opt = TRAD_YES;
+   if ((rc = tinyrad_dict_set_option(dict, TRAD_DICT_OPT_READONLY, &opt)) != TRAD_SUCCESS)
+      return(trutils_error(opts, NULL, "tinyrad_dict_set_option(dict, TRAD_DICT_OPT_READONLY, TRAD_YES): %s", tinyrad_strerror(rc)));
+   if ((rc = tinyrad_set_option(tr, TRAD_OPT_DICTIONARY, dict)) != TRAD_SUCCESS)
+      return(trutils_error(opts, NULL, "tinyrad_set_option(tr, TRAD_OPT_DICTIONARY, dict): %s", tinyrad_strerror(rc)));
+
+   // TRAD_DICT_OPT_STATS
+   memset(&stats, 0, sizeof(stats));
+   if ((rc = tinyrad_dict_get_option(dict, TRAD_DICT_OPT_STATS, &stats)) != TRAD_SUCCESS)
+      return(trutils_error(opts, NULL, "tinyrad_dict_get_option(dict, TRAD_DICT_OPT_STATS, &stats): %s", tinyrad_strerror(rc)));
+   if ( (!(stats.attrs)) || (!(stats.values)) )
+      return(trutils_error(opts, NULL, "TRAD_DICT_OPT_STATS did not count builtin objects"));
+   if ( (!(stats.hashes_bytes)) || (!(stats.strpool_bytes)) || (stats.strpool_used > stats.strpool_bytes) )
+      return(trutils_error(opts, NULL, "TRAD_DICT_OPT_STATS did not measure frozen indexes"));
+   lookups = stats.lookups;
+   misses  = stats.lookup_misses;
+   attr = tinyrad_dict_attr_get(dict, "User-Name", 0, NULL, 0, 0);
+   tinyrad_free(attr);
+   attr = tinyrad_dict_attr_get(dict, NULL, TRAD_ATTR_USER_NAME, NULL, 0, 0);
+   tinyrad_free(attr);
+   attr = tinyrad_dict_attr_get(dict, "No-Such-Attribute", 0, NULL, 0, 0);
+   if ((rc = tinyrad_dict_get_option(dict, TRAD_DICT_OPT_STATS, &stats)) != TRAD_SUCCESS)
+      return(trutils_error(opts, NULL, "tinyrad_dict_get_option(dict, TRAD_DICT_OPT_STATS, &stats): %s", tinyrad_strerror(rc)));
+   if ( (stats.lookups != (lookups + 3)) || (stats.lookup_misses != (misses + 1)) || (!(stats.lookup_probes)) )
+      return(trutils_error(opts, NULL, "TRAD_DICT_OPT_STATS lookup counters do not match"));
+
+   // TRAD_DICT_OPT_STATS lookup counters are disabled by default
+   if ((rc = tinyrad_dict_initialize(&dict_cur, TRAD_NOINIT|TRAD_BUILTIN_DICT)) != TRAD_SUCCESS)
+      return(trutils_error(opts, NULL, "tinyrad_dict_initialize(): %s", tinyrad_strerror(rc)));
+   attr = tinyrad_dict_attr_get(dict_cur, "User-Name", 0, NULL, 0, 0);
+   tinyrad_free(attr);
+   memset(&stats, 0, sizeof(stats));
+   rc = tinyrad_dict_get_option(dict_cur, TRAD_DICT_OPT_STATS, &stats);
+   tinyrad_free(dict_cur);
+   if (rc != TRAD_SUCCESS)
+      return(trutils_error(opts, NULL, "tinyrad_dict_get_option(dict, TRAD_DICT_OPT_STATS, &stats): %s", tinyrad_strerror(rc)));
+   if ( ((stats.lookups)) || ((stats.lookup_misses)) || ((stats.lookup_probes)) )
+      return(trutils_error(opts, NULL, "TRAD_DICT_OPT_STATS counted lookups without TRAD_DICT_STATS"));
+
+   tinyrad_free(dict);
+   dict_cur = NULL;
+   if ((rc = tinyrad_get_option(tr, TRAD_OPT_DICTIONARY, &dict_cur)) != TRAD_SUCCESS)
+      return(trutils_error(opts, NULL, "tinyrad_get_option(tr, TRAD_OPT_DICTIONARY, &dict): %s", tinyrad_strerror(rc)));
+   if (dict_cur != dict)
+      return(trutils_error(opts, NULL, "value for TRAD_OPT_DICTIONARY does not match"));
+   uval = 0;
+   if ((rc = tinyrad_dict_get_option(dict_old, TRAD_DICT_OPT_REF_COUNT, &uval)) != TRAD_SUCCESS)
+      return(trutils_error(opts, NULL, "tinyrad_dict_get_option(dict, TRAD_DICT_OPT_REF_COUNT, &uval): %s", tinyrad_strerror(rc)));
+   if (uval != 1)
+      return(trutils_error(opts, NULL, "replaced dictionary is still referenced by handle"));
+   tinyrad_free(dict_cur);
+   tinyrad_free(dict_old);
+
    // TRAD_OPT_IPV4
    //opt = TRAD_ON;
    //if ((rc = tinyrad_set_option(tr, TRAD_OPT_IPV4, &opt)) != TRAD_SUCCESS)
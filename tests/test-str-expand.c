@@ -96,6 +96,8 @@ static const MyTestStr  test_strings[] =
    { "\\x61\\x73\\x64\\x66\\x67\\x68\\x6a",  "asdfghj",                       TRAD_YES },
    { "a\\163\\x64f\\147\\x68j",              "asdfghj",                       TRAD_YES },
    { "a%%sdfghj",                            "a%sdfghj",                      TRAD_YES },
+   { "\"a\\tsdf%%ghj\"",                     "a\tsdf%ghj",                    TRAD_NO },
+   { "'a\\tsdf%%ghj'",                       "a\\tsdf%%ghj",                  TRAD_NO },
    { "zaq%%-%p-%%qaz",                       "zaq%-tinyrad-str-expand-%qaz",  TRAD_YES },
    { "%u:x:%U:%G:test user:%d:/bin/false",   NULL,                            TRAD_YES },
    { "%g:x:%G:%u,root",                      NULL,                            TRAD_YES },
@@ -135,10 +137,13 @@ main(
    int                           opt;
    int                           c;
    int                           opt_index;
+   int                           rc;
    size_t                        pos;
    unsigned                      opts;
    char                          buff[TRAD_LINE_MAX_LEN];
+   char                          tbuff[TRAD_LINE_MAX_LEN];
    const MyTestStr *             test_str;
+   TinyRadStrTmpl *              tmpl;
 
    // getopt options
    static char          short_opt[] = "dhVvq";
@@ -255,6 +260,25 @@ main(
             return(1);
          };
       };
+
+      // compiled template expands to same string
+      if ((rc = tinyrad_strexpand_compile(test_str->origin, (int)test_str->force, &tmpl)) != TRAD_SUCCESS)
+      {
+         trutils_error(opts, NULL, "tinyrad_strexpand_compile(): %s", tinyrad_strerror(rc));
+         return(1);
+      };
+      if (!(tinyrad_strexpand_tmpl(tbuff, tmpl, sizeof(tbuff))))
+      {
+         trutils_error(opts, NULL, "tinyrad_strexpand_tmpl(): error occurred");
+         tinyrad_free(tmpl);
+         return(1);
+      };
+      tinyrad_free(tmpl);
+      if ((strcmp(buff, tbuff)))
+      {
+         trutils_error(opts, NULL, "tinyrad_strexpand_tmpl(): expected: %s", buff);
+         return(1);
+      };
       trutils_verbose(opts, "");
    };
 
@@ -91,6 +91,23 @@ static const char * const * test_strings[] =
 };
 
 
+static const char * test_lines[] =
+{
+   "ATTRIBUTE User-Name 1 string",
+   "  VALUE\tService-Type  Login-User 1 # comment",
+   "\"quoted arg\" 'single quoted' plain#comment",
+   "\"escaped \\\"quote\\\"\" x",
+   "# comment only",
+   "",
+   "   ",
+   "bad\"quote",
+   "\"unterminated",
+   "\"quoted\"trailing",
+   "1 2 3 4 5 6 7 8 9 10 11 12 13 14 15",
+   NULL
+};
+
+
 //////////////////
 //              //
 //  Prototypes  //
@@ -111,6 +128,12 @@ my_test_array(
          const char *                  delim );
 
 
+int
+my_test_line(
+         unsigned                      opts,
+         const char *                  line );
+
+
 /////////////////
 //             //
 //  Functions  //
@@ -215,6 +238,9 @@ main(
    for(x = 0; ((test_strings[x])); x++)
       if ((rc = my_test_array(opts, &test_strings[x][1], test_strings[x][0])) != 0)
          return(1);
+   for(x = 0; ((test_lines[x])); x++)
+      if ((rc = my_test_line(opts, test_lines[x])) != 0)
+         return(1);
 
    return(0);
 }
@@ -226,11 +252,13 @@ my_test_array(
          const char * const *          argv,
          const char *                  delim )
 {
-   int         rc;
-   int         len;
-   int         pos;
-   char        buff[1024];
-   char **     strs;
+   int            rc;
+   int            len;
+   int            pos;
+   size_t         count;
+   char           buff[1024];
+   char **        strs;
+   TinyRadSpan    spans[32];
 
    strs    = NULL;
    buff[0] = '\0';
@@ -282,10 +310,107 @@ my_test_array(
       };
    };
 
+   // check spans against strings
+   if ((rc = tinyrad_strsplitspans(buff, sizeof(buff), delim[0], spans, 32, &count)) != TRAD_SUCCESS)
+   {
+      trutils_error(opts, NULL, "tinyrad_strsplitspans(): %s", tinyrad_strerror(rc));
+      return(1);
+   };
+   if (count != (size_t)len)
+   {
+      trutils_error(opts, NULL, "tinyrad_strsplitspans(): returned %zu spans, expected %i spans", count, len);
+      return(1);
+   };
+   for(pos = 0; (pos < len); pos++)
+   {
+      if ( (spans[pos].len != strlen(strs[pos])) || ((memcmp(spans[pos].str, strs[pos], spans[pos].len))) )
+      {
+         trutils_error(opts, NULL, "tinyrad_strsplitspans(): spans do not match strings");
+         return(1);
+      };
+   };
+
    tinyrad_free(strs);
 
    return(TRAD_SUCCESS);
 }
 
+
+int
+my_test_line(
+         unsigned                      opts,
+         const char *                  line )
+{
+   int            rc;
+   int            argc;
+   int            pos;
+   size_t         len;
+   size_t         count;
+   char           buff[1024];
+   char           copy[1024];
+   char **        strs;
+   char *         argv[TRAD_ARGV_MAX];
+   TinyRadSpan    spans[TRAD_ARGV_MAX];
+
+   trutils_verbose(opts, "line: \"%s\"", line);
+
+   // spans of a line which is not NUL terminated match the allocated arguments
+   tinyrad_strlcpy(buff, line, sizeof(buff));
+   rc  = tinyrad_strtoargs(buff, &strs, &argc);
+   len = strlen(line);
+   memcpy(copy, line, len);
+   memset(&copy[len], '"', (sizeof(copy) - len));
+   if (tinyrad_strtospans(copy, len, spans, TRAD_ARGV_MAX, &count) != rc)
+   {
+      trutils_error(opts, NULL, "tinyrad_strtospans(): returned %s, expected %s", tinyrad_strerror(tinyrad_strtospans(copy, len, spans, TRAD_ARGV_MAX, &count)), tinyrad_strerror(rc));
+      return(1);
+   };
+   if (rc == TRAD_SUCCESS)
+   {
+      if (count != (size_t)argc)
+      {
+         trutils_error(opts, NULL, "tinyrad_strtospans(): returned %zu spans, expected %i", count, argc);
+         return(1);
+      };
+      for(pos = 0; (pos < argc); pos++)
+      {
+         trutils_verbose(opts, "    arg %i: \"%s\"", pos, strs[pos]);
+         if ( (spans[pos].len != strlen(strs[pos])) || ((memcmp(spans[pos].str, strs[pos], spans[pos].len))) )
+         {
+            trutils_error(opts, NULL, "tinyrad_strtospans(): spans do not match arguments");
+            return(1);
+         };
+      };
+   };
+
+   // in place arguments match the allocated arguments
+   tinyrad_strlcpy(buff, line, sizeof(buff));
+   if ((rc = tinyrad_strtoargv(buff, argv, TRAD_ARGV_MAX, &argc)) == TRAD_SUCCESS)
+   {
+      for(pos = 0; ( ((strs)) && ((strs[pos])) ); pos++)
+      {
+         if ( (pos >= argc) || ((strcmp(argv[pos], strs[pos]))) )
+         {
+            trutils_error(opts, NULL, "tinyrad_strtoargv(): arguments do not match");
+            return(1);
+         };
+      };
+      if ( (pos != argc) || ((argv[argc])) )
+      {
+         trutils_error(opts, NULL, "tinyrad_strtoargv(): returned %i arguments, expected %i", argc, pos);
+         return(1);
+      };
+   };
+   if ( (rc != TRAD_SUCCESS) && ((strs)) && (tinyrad_strscount(strs) < TRAD_ARGV_MAX) )
+   {
+      trutils_error(opts, NULL, "tinyrad_strtoargv(): %s", tinyrad_strerror(rc));
+      return(1);
+   };
+
+   tinyrad_strsfree(strs);
+
+   return(0);
+}
+
 /* end of source */
 